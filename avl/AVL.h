@@ -1,80 +1,290 @@
 /*
-	Implementation of balanced binary search tree of strings using the AVL algorithm.
+	Implementation of balanced binary search tree using the AVL algorithm.
 	This is the header file that provides class/method definitions.
 
+	The tree is a class template over the key type, the comparator and the allocator. How keys
+	are stored and compared is chosen at compile time by KeyTraits (see KeyTraits.h), so integer
+	trees compare integers directly and AVL<string> keeps its keys packed in a KeyArena.
+
+	An optional augmentation policy (see Augment.h) keeps a monoid aggregate of every subtree
+	next to its height and size, so rangeAggregate() answers sum/min/max-style queries over a key
+	range in O(log n).
+
+	Comparisons, rotations, lookup depths and allocations are counted by the hooks of
+	../common/Stats.h when the tree is compiled with DS_STATS, and cost nothing otherwise.
+
+	Bulk set operations are built on split and join in the style of Blelloch, Ferizovic and Sun
+	("Just Join for Parallel Ordered Sets"), so merging m keys into a tree of n costs
+	O(m log(n/m + 1)) work, and the two recursive halves of each step run in parallel.
+
 	Author  :  Nishanth Jayram (https://github.com/njayram44)
-	Date    :  December 24, 2020 
+	Date    :  December 24, 2020
 */
 
 #ifndef AVL_H
 #define AVL_H
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ostream>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "../common/Stats.h"
+#include "Arena.h"
+#include "Augment.h"
+#include "FrozenAVL.h"
+#include "MappedAVL.h"
+#include "KeyTraits.h"
 using namespace std;
 
-class Node
+template <class Key, class Compare = less<Key>, class Allocator = allocator<Key>, class Augment = NoAugment>
+class AVL
 {
 	public:
-		string key; // Contains the data
-		Node* left, *right, *parent; // Pointers to the children and parent
-		int height; // Tracks the height of the node (distance from the root of its subtree)
-		int subsize; // Tracks the subtree size (number of nodes below)
-		
-		Node()
+		typedef KeyTraits<Key, Compare> Traits;
+		typedef typename Traits::stored_type StoredKey; // Representation of a key inside a node
+		typedef typename Traits::arg_type KeyArg; // Type through which keys are passed in
+		typedef typename Augment::value_type Value; // Per-key value and subtree aggregate of the augmentation
+		static_assert(is_trivially_copyable_v<Value>, "AVL: augmentation values live in raw arena slots and must be trivially copyable");
+
+		// Result of splitting a subtree around a key: the keys below it, the node holding the key
+		// itself (NIL if absent) and the keys above it.
+		struct SplitResult
 		{
-			left = right = parent = NULL; // By default, these are NULL
-			height = 0; // These are both zero by default
-			subsize = 1;
-		}
-		
-		Node(string k)
+			NodeId left, match, right;
+		};
+
+		// Order in which traverse() and dump() visit the nodes
+		enum class Order { Pre, In, Post, Level };
+
+		// End of the key order that a tree with a capacity evicts from
+		enum class Evict { Low, High };
+
+		class Node
 		{
-			key = k;
-			left = right = parent = NULL;
-			height = 0;
-			subsize = 1;
-		}
-};
+			public:
+				StoredKey key; // Contains the data
+				NodeId left, right, parent; // Indices of the children and parent (NIL if absent)
+				int height; // Tracks the height of the node (distance from the root of its subtree)
+				int subsize; // Tracks the subtree size (number of nodes below)
+				[[no_unique_address]] Value own; // Augmentation value of this node's key
+				[[no_unique_address]] Value agg; // Augmentation values of the whole subtree, combined in key order
+		};
+
+		// Bidirectional in-order iterator. It only holds a node index and walks the parent links,
+		// so it stays valid across insertions and is invalidated only when its node is removed.
+		class Iterator
+		{
+			private:
+				AVL* tree; // Tree being traversed
+				NodeId n; // Current node (NIL at the end)
+
+			public:
+				typedef bidirectional_iterator_tag iterator_category;
+				typedef remove_cv_t<remove_reference_t<KeyArg>> value_type;
+				typedef KeyArg reference;
+				typedef ptrdiff_t difference_type;
+
+				Iterator() : tree(NULL), n(NIL) {}
+				Iterator(AVL* t, NodeId id) : tree(t), n(id) {}
+
+				reference operator*() const { return Traits::view(tree->at(n).key); }
+				NodeId node() const { return n; } // Index of the current node
+				Iterator& operator++() { n = tree->successor(n); return *this; }
+				Iterator& operator--() { n = (n == NIL) ? tree->maxNode(tree->root) : tree->predecessor(n); return *this; }
+				Iterator operator++(int) { Iterator old = *this; ++*this; return old; }
+				Iterator operator--(int) { Iterator old = *this; --*this; return old; }
+				bool operator==(const Iterator& o) const { return n == o.n; }
+				bool operator!=(const Iterator& o) const { return n != o.n; }
+		};
+
+		// Lazily evaluated run of keys between two iterators, as returned by scan(). Nothing is
+		// read from the tree until it is iterated.
+		class KeyRange
+		{
+			private:
+				Iterator first, last;
+
+			public:
+				KeyRange(Iterator f, Iterator l) : first(f), last(l) {}
+				Iterator begin() const { return first; }
+				Iterator end() const { return last; }
+				bool empty() const { return first == last; }
+		};
 
-class AVL
-{
 	private:
-		Node* root;
-	
+		NodeId root;
+		NodeArena<Node, Allocator> nodes; // Slab storage for every node in the tree
+		[[no_unique_address]] typename Traits::template store_type<Allocator> keys; // Storage for key bytes, if the key policy needs it
+		[[no_unique_address]] Compare comp; // Ordering of the keys
+		int capacity; // Most keys the tree may hold (0 if unbounded)
+		Evict evictFrom; // End of the key order that is evicted once the tree is over capacity
+
+		static constexpr size_t KEY_SLACK = 4096; // Dead keys tolerated in the key arena, beyond one per live key, before it is compacted
+
+		NodeId newNode(KeyArg, const Value&); // Allocates a leaf node holding a copy of the given key and its value
+		NodeId insertAt(NodeId, KeyArg, const Value&); // Recursive helper for insertValue, returning the node holding the key
+		void update(NodeId); // Recomputes the height, subtree size and aggregate of a node from its children
+		NodeId eraseAt(NodeId, KeyArg, bool&); // Recursive helper for erase
+		NodeId removeFirst(NodeId, NodeId&); // Detaches the node with the smallest key of a subtree, rebalancing on the way up
+		NodeId removeLast(NodeId, NodeId&); // Detaches the node with the largest key of a subtree, rebalancing on the way up
+		void dropNode(NodeId); // Destroys the key of a detached node and returns the node to the arena
+		void dropTree(NodeId); // Destroys the keys of a detached subtree and returns all of its nodes to the arena
+		void evict(); // Removes keys from the evicted end until the tree is back within its capacity
+		void reclaim(); // Compacts the key arena once most of the keys in it are dead
+		Value aggregateGeq(NodeId, KeyArg); // Combines the values of the keys of a subtree not less than a key
+		Value aggregateLeq(NodeId, KeyArg); // Combines the values of the keys of a subtree not greater than a key
+		void destroyKeys(NodeId); // Destroys the keys in a subtree, for key types that need it
+		template <class RandomIt>
+		NodeId build(RandomIt, size_t, size_t, NodeId); // Recursive helper that builds a balanced subtree from sorted keys
+
+		static constexpr int SET_OP_GRAIN = 4096; // Set operations never hand subproblems smaller than this to another thread
+
+		// State shared by the tasks of one parallel set operation
+		struct SetOpContext
+		{
+			mutex lock; // Guards discarded
+			vector<NodeId> discarded; // Nodes dropped by the operation, released once it finishes
+		};
+		NodeId import(const AVL&, NodeId, NodeId); // Copies a subtree of another tree into this tree's arenas
+		void discard(SetOpContext&, NodeId); // Queues a single node for release
+		void discardTree(SetOpContext&, NodeId); // Queues every node of a subtree for release
+		template <class LeftTask, class RightTask>
+		static pair<NodeId, NodeId> forkJoin(bool, LeftTask, RightTask); // Runs two tasks, in parallel if asked to
+		template <class Op>
+		void runSetOp(const AVL&, unsigned, Op); // Imports the other tree, runs a set operation and frees dropped nodes
+		NodeId unionOf(SetOpContext&, NodeId, NodeId, int); // Recursive helper for unionWith
+		NodeId intersectionOf(SetOpContext&, NodeId, NodeId, int); // Recursive helper for intersectWith
+		NodeId differenceOf(SetOpContext&, NodeId, NodeId, int); // Recursive helper for differenceWith
+		NodeId joinRight(NodeId, NodeId, NodeId); // Joins a shorter right tree into the right spine of a taller left one
+		NodeId joinLeft(NodeId, NodeId, NodeId); // Joins a shorter left tree into the left spine of a taller right one
+
+		static constexpr size_t BATCH_GRAIN = 4096; // Batched queries never hand fewer probes than this to another thread
+
+		// Outcome of one probe of a batched lookup
+		struct Probe
+		{
+			NodeId node; // Node holding the key (NIL if absent)
+			int less; // Number of keys smaller than the key
+		};
+		template <class KeyAt>
+		void lookupBatch(size_t, KeyAt, Probe*, unsigned); // Splits probes across threads, sorting and resolving each slice
+		template <class KeyAt>
+		void lookupSorted(const uint32_t*, uint32_t, KeyAt, Probe*); // Resolves one sorted slice of probes, a tree level at a time
+
+		template <class Visit>
+		void walk(NodeId, int, Visit); // Walks a subtree along the parent links, reporting each node on entry, between its children and on exit
+		template <class Sink>
+		void dumpSubtree(NodeId, Order, Sink&); // Writes every node of a subtree to a sink in a given order
+		int verify(NodeId, NodeId, NodeId, NodeId, bool&); // Recursive helper for checkInvariants
+
 	public:
-		// Constructor
+		// Constructors
 		AVL();
-		
+		explicit AVL(const Compare&, const Allocator& = Allocator());
+		template <class InputIt>
+		AVL(InputIt, InputIt, const Compare& = Compare(), const Allocator& = Allocator()); // Bulk-loads the keys in a range
+		~AVL();
+		AVL(AVL&&) noexcept;
+		AVL& operator=(AVL&&) noexcept;
+
 		// Insert methods
-		void insert(string); // Main method for inserting a new node containing given key, if feasible
-		void insert(Node*, Node*); // Recursive helper function for inserting new node in given subtree
-		
+		void insert(KeyArg); // Main method for inserting a new node containing given key, if feasible
+		void insert(NodeId, KeyArg); // Recursive helper function for inserting a key in given subtree
+		NodeId insertValue(KeyArg, const Value&); // Inserts a key with a given value, or folds the value into the key's own if present
+		template <class InputIt>
+		void assign(InputIt, InputIt); // Replaces the contents with the keys in a range, building the tree in one pass
+
+		// Erase methods
+		bool erase(KeyArg); // Removes a key, returning whether it was present
+		int eraseRange(KeyArg, KeyArg); // Removes every key in [k1, k2], returning how many were removed
+		void setCapacity(int, Evict = Evict::Low); // Bounds the number of keys (0 for no bound), evicting from one end of the key order
+		int getCapacity() { return capacity; } // Returns the capacity (0 if unbounded)
+
 		// Find methods
-		Node* find(string); // Main method for finding a node containing given key, if feasible
-		Node* find(Node*, string); // Recursive helper function for finding node containing key in a given subtree
-		
+		Node* find(KeyArg); // Main method for finding a node containing given key, if feasible
+		NodeId find(NodeId, KeyArg); // Recursive helper function for finding node containing key in a given subtree
+
+		// Ordered traversal
+		Iterator begin() { return Iterator(this, minNode(root)); } // Iterator to the smallest key
+		Iterator end() { return Iterator(this, NIL); } // Iterator past the largest key
+		Iterator lowerBound(KeyArg); // Iterator to the first key not less than the given key
+		Iterator upperBound(KeyArg); // Iterator to the first key greater than the given key
+		KeyRange scan(KeyArg, KeyArg); // Lazy range over the keys in [k1, k2]
+		KeyRange scan(KeyArg, KeyArg, int, int); // Lazy page of at most limit keys in [k1, k2], skipping the first offset
+		int rank(KeyArg); // Returns the number of keys smaller than the given key
+		Iterator select(int); // Iterator to the key with the given 0-based rank (end() if out of range)
+		NodeId minNode(NodeId); // Returns the node with the smallest key in a subtree (NIL if empty)
+		NodeId maxNode(NodeId); // Returns the node with the largest key in a subtree (NIL if empty)
+		NodeId successor(NodeId); // Returns the next node in key order (NIL after the last)
+		NodeId predecessor(NodeId); // Returns the previous node in key order (NIL before the first)
+
 		// Range queries
-		int range(string, string); // Main method for processing the range query between two input strings, if feasible
-		int range(Node*, string, string); // Recursive helper function for calculating a range query
-		int leq(Node*, string); // Recursive helper function for determining number of nodes "less than or equal" to given input
-		int geq(Node*, string); // Recursive helper function for determining number of nodes "greater than or equal" to given input
-		
+		int range(KeyArg, KeyArg); // Main method for processing the range query between two input keys, if feasible
+		int range(NodeId, KeyArg, KeyArg); // Recursive helper function for calculating a range query
+		int leq(NodeId, KeyArg); // Recursive helper function for determining number of nodes "less than or equal" to given input
+		int geq(NodeId, KeyArg); // Recursive helper function for determining number of nodes "greater than or equal" to given input
+		Value rangeAggregate(KeyArg, KeyArg); // Combines the values of the keys in [k1, k2], in key order
+
+		// Batched queries
+		template <class RandomIt>
+		vector<NodeId> findBatch(RandomIt, RandomIt, unsigned = thread::hardware_concurrency()); // Finds every key of a range (NIL where absent)
+		template <class RandomIt>
+		vector<int> rangeBatch(RandomIt, RandomIt, unsigned = thread::hardware_concurrency()); // Counts the keys in every [k1, k2] pair of a range
+
+		// Split/join and set operations
+		SplitResult split(NodeId, KeyArg); // Splits a subtree into the keys below, at and above a given key
+		NodeId join(NodeId, NodeId, NodeId); // Joins two subtrees around a middle node whose key lies between them
+		NodeId join2(NodeId, NodeId); // Joins two subtrees, all of whose keys are in order, without a middle node
+		NodeId splitLast(NodeId, NodeId&); // Detaches the largest node of a subtree, returning what remains
+		void unionWith(const AVL&, unsigned = thread::hardware_concurrency()); // Adds every key of another tree
+		void intersectWith(const AVL&, unsigned = thread::hardware_concurrency()); // Keeps only keys also in another tree
+		void differenceWith(const AVL&, unsigned = thread::hardware_concurrency()); // Removes every key of another tree
+
+		// Snapshots
+		FrozenAVL<Key, Compare> freeze(); // Compiles the current keys into a read-only, pointer-free lookup index (NoAugment trees only)
+		void save(const string&); // Writes the tree to a file that MappedAVL can map and query in place (NoAugment trees only)
+
 		// Balance/rotations
-		Node* leftRotate(Node*);
-		Node* rightRotate(Node*);
-		Node* fixBalance(Node*);
-		
+		NodeId leftRotate(NodeId);
+		NodeId rightRotate(NodeId);
+		NodeId fixBalance(NodeId);
+
 		// Accessors
-		int getHeight(Node*); // Returns the height of a given node (-1 if NULL)
-		int getBalance(Node*); // Returns the balance of a given node (0 if NULL)
-		int getSubsize(Node*); // Returns the subtree size of a given node (0 if NULL)
-		
+		Node& at(NodeId n) { return nodes[n]; } // Returns the node stored at a given index (must not be NIL)
+		int compare(KeyArg k, NodeId n) { Stats::comparison(); return Traits::compare(comp, k, at(n).key); } // Three-way compare of a key against a node
+		NodeId getRoot() { return root; } // Returns the index of the root (NIL if empty)
+		int getHeight(NodeId); // Returns the height of a given node (-1 if NIL)
+		int getBalance(NodeId); // Returns the balance of a given node (0 if NIL)
+		int getSubsize(NodeId); // Returns the subtree size of a given node (0 if NIL)
+		Value getValue(NodeId n) { return n == NIL ? Augment::identity() : at(n).own; } // Returns the value of a node's key (identity if NIL)
+		Value getAggregate(NodeId n) { return n == NIL ? Augment::identity() : at(n).agg; } // Returns the aggregate of a subtree (identity if NIL)
+		int size() { return getSubsize(root); } // Returns the number of keys in the tree
+		size_t bytesReserved(); // Returns the number of bytes held by the node and key arenas
+		bool checkInvariants(); // Checks ordering, parent links, heights, subtree sizes and balance
+
 		// Mutators
-		void setHeight(Node*, int); // Modifies the height of a given node, if feasible
-		void setSubsize(Node*, int); // Modifies the subtree size counter of a given node, if feasible
-		void setParent(Node*, Node*); // Modifies the parent pointer of a given node, if feasible
-		
-		// Print methods
+		void setHeight(NodeId, int); // Modifies the height of a given node, if feasible
+		void setSubsize(NodeId, int); // Modifies the subtree size counter of a given node, if feasible
+		void setParent(NodeId, NodeId); // Modifies the parent index of a given node, if feasible
+		void link(NodeId, NodeId, NodeId); // Makes two subtrees the children of a node and recomputes its fields
+		void clear(); // Removes every key, releasing all memory a slab at a time
+
+		// Traversal and print methods
+		template <class Visit>
+		void traverse(NodeId, Order, Visit); // Calls a function on every node of a subtree in a given order, without recursion
+		template <class Sink> requires invocable<Sink&, string_view>
+		void dump(Sink&&, Order = Order::Pre); // Writes every node, as <KEY>(h = <HEIGHT>, s = <SUBSIZE>), to a sink taking string_view
+		void dump(ostream&, Order = Order::Pre); // Writes every node to a stream
 		string printPreOrder();
-		string printPreOrder(Node* start);	
+		string printPreOrder(NodeId start);
 };
+
+#include "AVL.tpp"
 #endif
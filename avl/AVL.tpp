@@ -0,0 +1,1725 @@
+/*
+	Implementation of balanced binary search tree using the AVL algorithm.
+	This implements the methods described in the header file.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  December 24, 2020
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <string>
+#include <stack>
+#include <future>
+#include <mutex>
+#include <charconv>
+#include <ostream>
+
+// Default constructor
+template <class Key, class Compare, class Allocator, class Augment>
+AVL<Key, Compare, Allocator, Augment> :: AVL() : AVL(Compare())
+{
+}
+
+// Constructor taking a comparator and an allocator
+template <class Key, class Compare, class Allocator, class Augment>
+AVL<Key, Compare, Allocator, Augment> :: AVL(const Compare& c, const Allocator& a) : nodes(a), keys(a), comp(c)
+{
+	root = NIL;
+	capacity = 0;
+	evictFrom = Evict::Low;
+}
+
+// Constructor that bulk-loads the keys in [first, last). See assign().
+template <class Key, class Compare, class Allocator, class Augment>
+template <class InputIt>
+AVL<Key, Compare, Allocator, Augment> :: AVL(InputIt first, InputIt last, const Compare& c, const Allocator& a) : AVL(c, a)
+{
+	assign(first, last);
+}
+
+// Destructor. Key types that own resources are destroyed first; the slabs themselves are
+// released by the arenas without visiting any node.
+template <class Key, class Compare, class Allocator, class Augment>
+AVL<Key, Compare, Allocator, Augment> :: ~AVL()
+{
+	destroyKeys(root);
+}
+
+// Move constructor takes over the arenas of another tree, leaving it empty.
+template <class Key, class Compare, class Allocator, class Augment>
+AVL<Key, Compare, Allocator, Augment> :: AVL(AVL&& other) noexcept
+	: nodes(std::move(other.nodes)), keys(std::move(other.keys)), comp(std::move(other.comp))
+{
+	root = other.root;
+	capacity = other.capacity;
+	evictFrom = other.evictFrom;
+	other.root = NIL;
+}
+
+// Move assignment releases our own keys before taking over the arenas of another tree.
+template <class Key, class Compare, class Allocator, class Augment>
+AVL<Key, Compare, Allocator, Augment>& AVL<Key, Compare, Allocator, Augment> :: operator=(AVL&& other) noexcept
+{
+	if (this != &other)
+	{
+		clear();
+		nodes = std::move(other.nodes);
+		keys = std::move(other.keys);
+		comp = std::move(other.comp);
+		root = other.root;
+		capacity = other.capacity;
+		evictFrom = other.evictFrom;
+		other.root = NIL;
+	}
+	return *this;
+}
+
+// Allocates a new leaf node from the arena and stores a copy of the given key in it.
+// Input: Key - Key for the new node, Value - Augmentation value of the key
+// Output: NodeId - Index of the new node
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: newNode(KeyArg k, const Value& v)
+{
+	NodeId id = nodes.allocate();
+	Node& n = at(id);
+	Traits::construct(n.key, k, keys);
+	n.left = n.right = n.parent = NIL; // By default, these are NIL
+	n.height = 0; // A new node is always a leaf
+	n.subsize = 1;
+	n.own = n.agg = v;
+	return id;
+}
+
+// Destroys the keys held by a subtree. Does nothing for key types whose nodes can be
+// dropped without being visited.
+// Input: NodeId - Root of the subtree
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: destroyKeys(NodeId start)
+{
+	if constexpr (!Traits::trivial_teardown)
+	{
+		if (start == NIL)
+			return;
+		destroyKeys(at(start).left);
+		destroyKeys(at(start).right);
+		Traits::destroy(at(start).key);
+	}
+}
+
+/* INSERT METHODS */
+// Inserts a node containing the given input key into the tree, if feasible. The key carries
+// the value its augmentation lifts it to; inserting a key that is already present only folds
+// that value into the node's own (see Augment.h), which for an unaugmented tree does nothing.
+// Input: Key - Key to insert into the tree
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: insert(KeyArg k)
+{
+	insertValue(k, Augment::lift(k));
+}
+
+// Inserts a key with a given augmentation value, such as a weight, into the tree. If the key
+// is already present, the value is folded into the one it already has.
+// Input: Key - Key to insert into the tree, Value - Augmentation value of the key
+// Output: NodeId - Node holding the key (NIL if a bounded tree evicted it straight away)
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: insertValue(KeyArg k, const Value& v)
+{
+	NodeId placed;
+	if (root == NIL) // If the tree is empty, update the root to a new node
+		root = placed = newNode(k, v);
+	else
+	{
+		placed = insertAt(root, k, v); // Call the recursive insert method
+		root = fixBalance(root); // Fix the balance from the root
+	}
+	if (capacity > 0 && size() > capacity) // A bounded tree makes room by evicting from one end
+	{
+		evict();
+		placed = find(root, k); // The new key may have been the one evicted
+	}
+	return placed;
+}
+
+// Inserts a key into the subtree starting from a given root.
+// Input: NodeId - Root of the subtree; Key - Key to insert
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: insert(NodeId start, KeyArg k)
+{
+	insertAt(start, k, Augment::lift(k));
+}
+
+// Recursive helper function for inserting a key into the subtree starting
+// from a given root. The node itself is only allocated once its position is known,
+// so duplicates never touch the arenas.
+// Input: NodeId - Root of the subtree; Key - Key to insert; Value - Augmentation value of the key
+// Output: NodeId - Node holding the key, whether new or already present
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: insertAt(NodeId start, KeyArg k, const Value& v)
+{
+	if (start == NIL) // Should not technically happen, but return safely if subtree is empty
+		return NIL;
+	Node& s = at(start); // Slabs never move, so this reference survives allocations below
+	int cmp = compare(k, start); // A single three-way comparison decides the direction
+	if (cmp < 0) // Key we wish to insert is smaller than current, so go left
+	{
+		if (s.left == NIL) // Base case: The current node has no left child, so we insert
+		{
+			NodeId to_insert = newNode(k, v);
+			s.left = to_insert; // Insert the node as the left child
+			setParent(to_insert, start); // Update parent index
+			update(start); // Node added is a leaf, so the current node's height becomes 1 and its size grows by one
+			return to_insert;
+		}
+		else // Recursive case
+		{
+			NodeId placed = insertAt(s.left, k, v); // Recurse down the left subtree
+			s.left = fixBalance(s.left); // Fix the balance as we recurse up
+			update(start); // Update the height, subtree size and aggregate as we recurse up
+			return placed;
+		}
+	}
+	else if (cmp > 0) // Key we wish to insert is larger than current, so go right
+	{
+		if (s.right == NIL) // Base case: The current node has no right child, so we insert
+		{
+			NodeId to_insert = newNode(k, v);
+			s.right = to_insert; // Insert the node as the right child
+			setParent(to_insert, start); // Update parent index
+			update(start); // Node added is a leaf, so the current node's height becomes 1 and its size grows by one
+			return to_insert;
+		}
+		else // Recursive case
+		{
+			NodeId placed = insertAt(s.right, k, v); // Recurse down the right subtree
+			s.right = fixBalance(s.right); // Fix the balance as we recurse up
+			update(start); // Update the height, subtree size and aggregate as we recurse up
+			return placed;
+		}
+	}
+	// Otherwise the key is a duplicate. No node is added, but its value absorbs the new one
+	// (counting the duplicate, for instance), and the aggregates above it change to match.
+	if constexpr (!is_same_v<Augment, NoAugment>)
+	{
+		Augment::absorb(s.own, v);
+		update(start);
+	}
+	return start;
+}
+
+// Replaces the contents of the tree with the keys in [first, last). A strictly increasing
+// random-access range is built directly in O(n); anything else is first copied, sorted and
+// deduplicated, keeping the first of any equal keys just like repeated insert() calls would.
+// An augmented tree inserts such a range key by key instead, so duplicates are absorbed.
+// Input: Iterators - Range of keys
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+template <class InputIt>
+void AVL<Key, Compare, Allocator, Augment> :: assign(InputIt first, InputIt last)
+{
+	clear();
+	auto notBefore = [this](const Key& a, const Key& b) { return !comp(a, b); };
+	if constexpr (is_base_of_v<random_access_iterator_tag, typename iterator_traits<InputIt>::iterator_category>)
+	{
+		if (adjacent_find(first, last, notBefore) == last) // Already strictly increasing, so build in place
+		{
+			root = build(first, 0, last - first, NIL);
+			evict();
+			return;
+		}
+	}
+	if constexpr (!is_same_v<Augment, NoAugment>)
+	{
+		for (; first != last; ++first)
+			insert(*first);
+		return;
+	}
+	vector<Key> sorted(first, last);
+	stable_sort(sorted.begin(), sorted.end(), comp);
+	auto equal = [this](const Key& a, const Key& b) { return !comp(a, b) && !comp(b, a); };
+	sorted.erase(unique(sorted.begin(), sorted.end(), equal), sorted.end());
+	root = build(sorted.begin(), 0, sorted.size(), NIL);
+	evict();
+}
+
+// Recursive helper function for building a perfectly balanced subtree out of the sorted keys
+// at positions [lo, hi). Nodes are allocated in preorder, so a parent sits next to its left
+// child in the slab.
+// Input: Iterator - Start of the sorted keys, size_t - lower position, size_t - upper position,
+//        NodeId - Parent of the subtree
+// Output: NodeId - Root of the subtree (NIL if the range is empty)
+template <class Key, class Compare, class Allocator, class Augment>
+template <class RandomIt>
+NodeId AVL<Key, Compare, Allocator, Augment> :: build(RandomIt keys_begin, size_t lo, size_t hi, NodeId parent)
+{
+	if (lo >= hi) // Base case: No keys left, so the subtree is empty
+		return NIL;
+	size_t mid = lo + (hi - lo) / 2; // The middle key becomes the root, splitting the rest evenly
+	KeyArg k = keys_begin[mid];
+	NodeId n = newNode(k, Augment::lift(k));
+	setParent(n, parent);
+	at(n).left = build(keys_begin, lo, mid, n);
+	at(n).right = build(keys_begin, mid + 1, hi, n);
+	update(n);
+	return n;
+}
+
+/* ERASE METHODS */
+// Removes a key from the tree, if present.
+// Input: Key - Key to remove
+// Output: Bool - True if the key was present
+template <class Key, class Compare, class Allocator, class Augment>
+bool AVL<Key, Compare, Allocator, Augment> :: erase(KeyArg k)
+{
+	bool erased = false;
+	root = eraseAt(root, k, erased);
+	setParent(root, NIL);
+	if (erased)
+		reclaim();
+	return erased;
+}
+
+// Recursive helper function for erasing a key from the subtree rooted at a given node. A node
+// with two children is replaced by its successor, which is detached from the right subtree.
+// Input: NodeId - Root of the subtree, Key - Key to remove, Bool reference - Set to true if the key was found
+// Output: NodeId - New root of the subtree
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: eraseAt(NodeId start, KeyArg k, bool& erased)
+{
+	if (start == NIL) // Base case: The key is not in the tree
+		return NIL;
+	Node& s = at(start);
+	int cmp = compare(k, start);
+	if (cmp < 0) // Key we wish to erase is smaller than current, so go left
+	{
+		s.left = eraseAt(s.left, k, erased);
+		setParent(s.left, start);
+	}
+	else if (cmp > 0) // Key we wish to erase is larger than current, so go right
+	{
+		s.right = eraseAt(s.right, k, erased);
+		setParent(s.right, start);
+	}
+	else // This node holds the key, so splice it out
+	{
+		erased = true;
+		NodeId l = s.left, r = s.right;
+		dropNode(start);
+		if (r == NIL) // At most one child, which simply takes the node's place
+			return l;
+		NodeId next;
+		r = removeFirst(r, next); // Otherwise the successor does
+		link(next, l, r);
+		return fixBalance(next);
+	}
+	if (!erased) // Nothing changed below, so nothing needs fixing here either
+		return start;
+	update(start); // Update the height, subtree size and aggregate as we recurse up
+	return fixBalance(start);
+}
+
+// Detaches the node holding the smallest key of a subtree.
+// Input: NodeId - Root of the subtree (must not be NIL), NodeId reference - Receives the detached node
+// Output: NodeId - New root of the remaining subtree
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: removeFirst(NodeId t, NodeId& first)
+{
+	Node& s = at(t);
+	if (s.left == NIL) // Base case: The root is the smallest node, so its right subtree is what remains
+	{
+		first = t;
+		return s.right;
+	}
+	s.left = removeFirst(s.left, first);
+	setParent(s.left, t);
+	update(t);
+	return fixBalance(t);
+}
+
+// Detaches the node holding the largest key of a subtree. Mirror image of removeFirst().
+// Input: NodeId - Root of the subtree (must not be NIL), NodeId reference - Receives the detached node
+// Output: NodeId - New root of the remaining subtree
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: removeLast(NodeId t, NodeId& last)
+{
+	Node& s = at(t);
+	if (s.right == NIL) // Base case: The root is the largest node, so its left subtree is what remains
+	{
+		last = t;
+		return s.left;
+	}
+	s.right = removeLast(s.right, last);
+	setParent(s.right, t);
+	update(t);
+	return fixBalance(t);
+}
+
+// Removes every key in [k1, k2]. Two splits cut the interval out as one subtree, a join
+// closes the gap, and the subtree goes back to the arena whole, so this takes O(log n) plus
+// whatever the keys themselves need to be destroyed.
+// Input: Key - lower bound, Key - upper bound
+// Output: Int - Number of keys removed
+template <class Key, class Compare, class Allocator, class Augment>
+int AVL<Key, Compare, Allocator, Augment> :: eraseRange(KeyArg k1, KeyArg k2)
+{
+	if (root == NIL || Traits::compareKeys(comp, k1, k2) > 0)
+		return 0;
+	SplitResult below = split(root, k1); // Keys below k1, k1 itself, and everything above
+	SplitResult above = split(below.right, k2); // Keys in (k1, k2), k2 itself, and the keys above k2
+	int removed = getSubsize(above.left) + (below.match != NIL) + (above.match != NIL);
+	dropTree(above.left);
+	if (below.match != NIL)
+		dropNode(below.match);
+	if (above.match != NIL)
+		dropNode(above.match);
+	root = join2(below.left, above.right);
+	setParent(root, NIL);
+	reclaim();
+	return removed;
+}
+
+// Bounds the number of keys the tree may hold. Once an insert takes it over capacity, keys
+// are evicted from the chosen end of the key order, which makes the tree a sliding window
+// over the most recent keys when those are the largest (Evict::Low) or the smallest (Evict::High).
+// Input: Int - Most keys to hold (0 for no bound), Evict - End of the key order to evict from
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: setCapacity(int c, Evict from)
+{
+	capacity = max(c, 0);
+	evictFrom = from;
+	evict();
+}
+
+// Evicts keys from one end of the key order until the tree is back within its capacity. A
+// single excess key is detached directly; a larger excess is cut off with one split at the
+// boundary rank.
+// Input: None
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: evict()
+{
+	int excess = (capacity > 0) ? size() - capacity : 0;
+	if (excess <= 0)
+		return;
+	if (excess == 1)
+	{
+		NodeId gone;
+		root = (evictFrom == Evict::Low) ? removeFirst(root, gone) : removeLast(root, gone);
+		setParent(root, NIL);
+		dropNode(gone);
+	}
+	else
+	{
+		int boundary = (evictFrom == Evict::Low) ? excess - 1 : size() - excess; // Rank of the evicted key nearest the kept ones
+		SplitResult s = split(root, Traits::view(at(select(boundary).node()).key));
+		dropNode(s.match);
+		if (evictFrom == Evict::Low)
+		{
+			dropTree(s.left);
+			root = s.right;
+		}
+		else
+		{
+			dropTree(s.right);
+			root = s.left;
+		}
+		setParent(root, NIL);
+	}
+	reclaim();
+}
+
+// Destroys the key held by a detached node and returns the node to the arena.
+// Input: NodeId - Node that is no longer linked into the tree
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: dropNode(NodeId n)
+{
+	Traits::destroy(at(n).key);
+	nodes.release(n);
+}
+
+// Destroys the keys of a detached subtree and returns the subtree to the arena in one piece.
+// Keys that need no destruction are not visited at all.
+// Input: NodeId - Root of a subtree that is no longer linked into the tree
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: dropTree(NodeId t)
+{
+	if (t == NIL)
+		return;
+	destroyKeys(t);
+	nodes.releaseTree(t, getSubsize(t));
+}
+
+// String keys live in a KeyArena that only grows, so erasing them leaves dead bytes behind.
+// Once the arena holds more dead keys than live ones (plus some slack), the live keys are
+// copied into a fresh arena and the old one is freed. This costs O(n) at most once per n
+// erasures. Views of string keys obtained before an erase may be invalidated by it.
+// Input: None
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: reclaim()
+{
+	if constexpr (is_same_v<StoredKey, PackedString>)
+	{
+		if (keys.count() <= 2 * (size_t) size() + KEY_SLACK)
+			return;
+		typename Traits::template store_type<Allocator> fresh(keys.allocator());
+		traverse(root, Order::Pre, [&](NodeId n) { at(n).key.data = fresh.store(at(n).key.view()); });
+		keys = std::move(fresh);
+	}
+}
+
+/* FIND METHODS */
+// Finds a node containing a given input key, if feasible.
+// Input: Key - key of interest
+// Output: Node pointer - Node containing key, if it exists (NULL otherwise)
+template <class Key, class Compare, class Allocator, class Augment>
+typename AVL<Key, Compare, Allocator, Augment>::Node* AVL<Key, Compare, Allocator, Augment> :: find(KeyArg k)
+{
+	Stats::beginLookup();
+	NodeId n = find(root, k); // Call the recursive find function
+	Stats::endLookup();
+	if (n == NIL)
+		return NULL;
+	return &at(n);
+}
+
+// Recursive helper function for finding a node in a subtree rooted at a given node,
+// if feasible.
+// Input: NodeId - Root of the subtree, Key - key of interest
+// Output: NodeId - Node containing key, if it exists (NIL otherwise)
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: find(NodeId start, KeyArg k)
+{
+	if (start == NIL)
+		return NIL;
+	Stats::visit();
+	int cmp = compare(k, start);
+	if (cmp == 0)
+		return start;
+	if (cmp < 0)
+		return find(at(start).left, k);
+	else
+		return find(at(start).right, k);
+}
+
+/* ORDERED TRAVERSAL */
+// Returns an iterator to the first key that is not less than the given key.
+// Input: Key - key of interest
+// Output: Iterator - Position of the first key >= k (end() if there is none)
+template <class Key, class Compare, class Allocator, class Augment>
+typename AVL<Key, Compare, Allocator, Augment>::Iterator AVL<Key, Compare, Allocator, Augment> :: lowerBound(KeyArg k)
+{
+	NodeId best = NIL;
+	NodeId curr = root;
+	while (curr != NIL)
+	{
+		if (compare(k, curr) <= 0) // Current key is >= k, so it is a candidate; look for a smaller one
+		{
+			best = curr;
+			curr = at(curr).left;
+		}
+		else
+			curr = at(curr).right;
+	}
+	return Iterator(this, best);
+}
+
+// Returns an iterator to the first key that is greater than the given key.
+// Input: Key - key of interest
+// Output: Iterator - Position of the first key > k (end() if there is none)
+template <class Key, class Compare, class Allocator, class Augment>
+typename AVL<Key, Compare, Allocator, Augment>::Iterator AVL<Key, Compare, Allocator, Augment> :: upperBound(KeyArg k)
+{
+	NodeId best = NIL;
+	NodeId curr = root;
+	while (curr != NIL)
+	{
+		if (compare(k, curr) < 0) // Current key is > k, so it is a candidate; look for a smaller one
+		{
+			best = curr;
+			curr = at(curr).left;
+		}
+		else
+			curr = at(curr).right;
+	}
+	return Iterator(this, best);
+}
+
+// Returns a lazy range over the keys in [k1, k2]. Only the two endpoints are located up front;
+// each key is read when the range is iterated.
+// Input: Key - lower bound, Key - upper bound
+// Output: KeyRange - Keys in the interval, in order (empty if k1 > k2)
+template <class Key, class Compare, class Allocator, class Augment>
+typename AVL<Key, Compare, Allocator, Augment>::KeyRange AVL<Key, Compare, Allocator, Augment> :: scan(KeyArg k1, KeyArg k2)
+{
+	if (Traits::compareKeys(comp, k1, k2) > 0)
+		return KeyRange(end(), end());
+	return KeyRange(lowerBound(k1), upperBound(k2));
+}
+
+// Returns one page of the keys in [k1, k2]: at most limit keys, starting offset keys into the
+// interval. Both ends of the page are found with select(), so deep pages cost O(log n + limit)
+// rather than walking past the skipped keys.
+// Input: Key - lower bound, Key - upper bound, Int - keys to skip, Int - maximum keys to return
+// Output: KeyRange - Keys on the page, in order
+template <class Key, class Compare, class Allocator, class Augment>
+typename AVL<Key, Compare, Allocator, Augment>::KeyRange AVL<Key, Compare, Allocator, Augment> :: scan(KeyArg k1, KeyArg k2, int offset, int limit)
+{
+	int lo = rank(k1); // Rank of the first key in the interval
+	int hi = lo + range(k1, k2); // One past the rank of the last key in the interval
+	int first = lo + max(offset, 0);
+	if (first >= hi || limit <= 0)
+		return KeyRange(end(), end());
+	int last = (limit >= hi - first) ? hi : first + limit;
+	return KeyRange(select(first), select(last));
+}
+
+// Returns the number of keys strictly smaller than a given key, i.e. the rank it has or
+// would have in the sorted order.
+// Input: Key - key of interest
+// Output: Int - Number of smaller keys
+template <class Key, class Compare, class Allocator, class Augment>
+int AVL<Key, Compare, Allocator, Augment> :: rank(KeyArg k)
+{
+	int count = 0;
+	NodeId curr = root;
+	while (curr != NIL)
+	{
+		if (compare(k, curr) <= 0) // Everything from here rightwards is >= k, so go left
+			curr = at(curr).left;
+		else // The current node and its left subtree are smaller than k
+		{
+			count += 1 + getSubsize(at(curr).left);
+			curr = at(curr).right;
+		}
+	}
+	return count;
+}
+
+// Finds the key with a given rank using the subtree sizes.
+// Input: Int - 0-based rank
+// Output: Iterator - Position of the key with that rank (end() if out of range)
+template <class Key, class Compare, class Allocator, class Augment>
+typename AVL<Key, Compare, Allocator, Augment>::Iterator AVL<Key, Compare, Allocator, Augment> :: select(int i)
+{
+	if (i < 0 || i >= size())
+		return end();
+	NodeId curr = root;
+	while (true)
+	{
+		int leftSize = getSubsize(at(curr).left);
+		if (i == leftSize) // Exactly i keys precede this node
+			return Iterator(this, curr);
+		if (i < leftSize)
+			curr = at(curr).left;
+		else
+		{
+			i -= leftSize + 1;
+			curr = at(curr).right;
+		}
+	}
+}
+
+// Returns the node holding the smallest key in a subtree.
+// Input: NodeId - Root of the subtree
+// Output: NodeId - Leftmost node (NIL if the subtree is empty)
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: minNode(NodeId n)
+{
+	if (n == NIL)
+		return NIL;
+	while (at(n).left != NIL)
+		n = at(n).left;
+	return n;
+}
+
+// Returns the node holding the largest key in a subtree.
+// Input: NodeId - Root of the subtree
+// Output: NodeId - Rightmost node (NIL if the subtree is empty)
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: maxNode(NodeId n)
+{
+	if (n == NIL)
+		return NIL;
+	while (at(n).right != NIL)
+		n = at(n).right;
+	return n;
+}
+
+// Returns the in-order successor of a node, following parent links when there is no right subtree.
+// Input: NodeId - Node of interest
+// Output: NodeId - Next node in key order (NIL if this is the last)
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: successor(NodeId n)
+{
+	if (n == NIL)
+		return NIL;
+	if (at(n).right != NIL) // The successor is the leftmost node of the right subtree
+		return minNode(at(n).right);
+	NodeId p = at(n).parent;
+	while (p != NIL && n == at(p).right) // Otherwise climb until we arrive from a left child
+	{
+		n = p;
+		p = at(p).parent;
+	}
+	return p;
+}
+
+// Returns the in-order predecessor of a node. Mirror image of successor().
+// Input: NodeId - Node of interest
+// Output: NodeId - Previous node in key order (NIL if this is the first)
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: predecessor(NodeId n)
+{
+	if (n == NIL)
+		return NIL;
+	if (at(n).left != NIL) // The predecessor is the rightmost node of the left subtree
+		return maxNode(at(n).left);
+	NodeId p = at(n).parent;
+	while (p != NIL && n == at(p).left) // Otherwise climb until we arrive from a right child
+	{
+		n = p;
+		p = at(p).parent;
+	}
+	return p;
+}
+
+/* RANGE QUERIES */
+// Returns the cardinality of the range of keys in [k1, k2], if feasible.
+// Input: Key - lower bound, Key - upper bound
+// Output: Int - Indicates number of keys in the range
+template <class Key, class Compare, class Allocator, class Augment>
+int AVL<Key, Compare, Allocator, Augment> :: range(KeyArg k1, KeyArg k2)
+{
+	return range(root, k1, k2); // Call the recursive helper function
+}
+
+// Recursive helper function for processing range queries within a subtree
+// rooted at a given node.
+// Input: NodeId - Root of the subtree, Key - lower bound, Key - upper bound
+// Output: Int - Indicates number of keys in the range
+template <class Key, class Compare, class Allocator, class Augment>
+int AVL<Key, Compare, Allocator, Augment> :: range(NodeId start, KeyArg k1, KeyArg k2)
+{
+	if (start == NIL) // Base case: There are no further nodes to recurse on, so return.
+		return 0;
+	Node& s = at(start);
+	if (compare(k2, start) < 0) // k2 < start->key => k1 < start->key, so go left
+		return range(s.left, k1, k2);
+	if (compare(k1, start) > 0) // k1 > start->key => k2 > start->key, so go right
+		return range(s.right, k1, k2);
+
+	// k1 <= start->key <= k2, so find all nodes greater than k1 in the left subtree and all nodes
+	// smaller than k2 in the right subtree.
+	return 1 + geq(s.left, k1) + leq(s.right, k2);
+}
+
+// Returns the number of nodes "less than or equal to" a given input, throughout a subtree
+// rooted at a given input node.
+// Input: NodeId - Root of the subtree to search; Key - key of interest
+// Output: Int - Indicates number of nodes with keys smaller than input
+template <class Key, class Compare, class Allocator, class Augment>
+int AVL<Key, Compare, Allocator, Augment> :: leq(NodeId start, KeyArg k)
+{
+	if (start == NIL) // Base case: There are no further nodes to recurse on, so return
+		return 0;
+	Node& s = at(start);
+	int cmp = compare(k, start);
+	if (cmp == 0) // If the keys are equal, simply return the size of the left subtree + start
+		return 1 + getSubsize(s.left);
+	else if (cmp < 0) // If the current key is larger, we go left
+		return leq(s.left, k);
+	else // If the current key is smaller, return the size of the left subtree + start and recurse right
+		return 1 + getSubsize(s.left) + leq(s.right, k);
+}
+
+// Returns the number of nodes "greater than or equal to" a given input, throughout a subtree
+// rooted at a given input node.
+// Input: NodeId - Root of the subtree to search; Key - key of interest
+// Output: Int - Indicates number of nodes with keys greater than input
+template <class Key, class Compare, class Allocator, class Augment>
+int AVL<Key, Compare, Allocator, Augment> :: geq(NodeId start, KeyArg k)
+{
+	if (start == NIL) // Base case: There are no further nodes to recurse on, so return
+		return 0;
+	Node& s = at(start);
+	int cmp = compare(k, start);
+	if (cmp == 0) // If the keyes are equal, simply return the size of the right subtree + start
+		return 1 + getSubsize(s.right);
+	else if (cmp > 0) // If the current key is smaller, we go right
+		return geq(s.right, k);
+	else // If the current key is larger, return the size of the right subtree + start and recurse left
+		return 1 + getSubsize(s.right) + geq(s.left, k);
+}
+
+// Combines the augmentation values of every key in [k1, k2], in key order, the same way
+// range() counts them: one descent to where the bounds part ways, then one down each side
+// taking whole subtree aggregates.
+// Input: Key - lower bound, Key - upper bound
+// Output: Value - Combined values (the identity if the range is empty)
+template <class Key, class Compare, class Allocator, class Augment>
+typename AVL<Key, Compare, Allocator, Augment>::Value AVL<Key, Compare, Allocator, Augment> :: rangeAggregate(KeyArg k1, KeyArg k2)
+{
+	NodeId n = root;
+	while (n != NIL)
+	{
+		Node& s = at(n);
+		if (compare(k2, n) < 0) // k2 < n->key => k1 < n->key, so go left
+			n = s.left;
+		else if (compare(k1, n) > 0) // k1 > n->key => k2 > n->key, so go right
+			n = s.right;
+		else // k1 <= n->key <= k2, so the range is a suffix of the left subtree, n, and a prefix of the right
+			return Augment::combine(Augment::combine(aggregateGeq(s.left, k1), s.own), aggregateLeq(s.right, k2));
+	}
+	return Augment::identity();
+}
+
+// Recursive helper for rangeAggregate: combines the values of the keys of a subtree that are
+// greater than or equal to a given key.
+// Input: NodeId - Root of the subtree, Key - key of interest
+// Output: Value - Combined values, in key order
+template <class Key, class Compare, class Allocator, class Augment>
+typename AVL<Key, Compare, Allocator, Augment>::Value AVL<Key, Compare, Allocator, Augment> :: aggregateGeq(NodeId start, KeyArg k)
+{
+	if (start == NIL)
+		return Augment::identity();
+	Node& s = at(start);
+	int cmp = compare(k, start);
+	if (cmp > 0) // The node and its left subtree are below the key, so go right
+		return aggregateGeq(s.right, k);
+	Value above = Augment::combine(s.own, getAggregate(s.right)); // The node and its right subtree all count
+	if (cmp == 0)
+		return above;
+	return Augment::combine(aggregateGeq(s.left, k), above);
+}
+
+// Recursive helper for rangeAggregate: combines the values of the keys of a subtree that are
+// less than or equal to a given key.
+// Input: NodeId - Root of the subtree, Key - key of interest
+// Output: Value - Combined values, in key order
+template <class Key, class Compare, class Allocator, class Augment>
+typename AVL<Key, Compare, Allocator, Augment>::Value AVL<Key, Compare, Allocator, Augment> :: aggregateLeq(NodeId start, KeyArg k)
+{
+	if (start == NIL)
+		return Augment::identity();
+	Node& s = at(start);
+	int cmp = compare(k, start);
+	if (cmp < 0) // The node and its right subtree are above the key, so go left
+		return aggregateLeq(s.left, k);
+	Value below = Augment::combine(getAggregate(s.left), s.own); // The node and its left subtree all count
+	if (cmp == 0)
+		return below;
+	return Augment::combine(below, aggregateLeq(s.right, k));
+}
+
+/* BATCHED QUERIES */
+// Finds many keys at once. The keys are sorted so that queries falling in the same subtree are
+// walked down together, and the walk interleaves every descent of a tree level while prefetching
+// the nodes of the next one. Large batches are split across threads.
+// Input: Random-access iterators - Keys to find, Unsigned - Maximum number of threads to use
+// Output: Vector of NodeIds - Node holding each key, in input order (NIL where absent)
+template <class Key, class Compare, class Allocator, class Augment>
+template <class RandomIt>
+vector<NodeId> AVL<Key, Compare, Allocator, Augment> :: findBatch(RandomIt first, RandomIt last, unsigned threads)
+{
+	size_t count = last - first;
+	vector<Probe> probes(count);
+	lookupBatch(count, [&](size_t i) -> KeyArg { return first[i]; }, probes.data(), threads);
+	vector<NodeId> out(count);
+	for (size_t i = 0; i < count; i++)
+		out[i] = probes[i].node;
+	return out;
+}
+
+// Answers many range queries at once. Each [k1, k2] pair becomes two probes, one counting the
+// keys below k1 and one counting the keys up to k2, which are resolved together as in findBatch.
+// Input: Random-access iterators - Pairs (k1, k2), Unsigned - Maximum number of threads to use
+// Output: Vector of ints - Number of keys in each [k1, k2], in input order (as range() would return)
+template <class Key, class Compare, class Allocator, class Augment>
+template <class RandomIt>
+vector<int> AVL<Key, Compare, Allocator, Augment> :: rangeBatch(RandomIt first, RandomIt last, unsigned threads)
+{
+	size_t count = last - first;
+	vector<Probe> probes(2 * count);
+	lookupBatch(2 * count, [&](size_t i) -> KeyArg { return (i & 1) ? first[i / 2].second : first[i / 2].first; }, probes.data(), threads);
+	vector<int> out(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		const Probe& lo = probes[2 * i];
+		const Probe& hi = probes[2 * i + 1];
+		out[i] = max(0, hi.less + (hi.node != NIL) - lo.less); // Zero when k1 > k2, as with range()
+	}
+	return out;
+}
+
+// Splits a batch of probes into contiguous slices, one per thread, then sorts and resolves each.
+// Input: Size - Number of probes, KeyAt - Returns the key of a probe, Probe pointer - Receives
+//        the outcome of each probe, Unsigned - Maximum number of threads to use
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+template <class KeyAt>
+void AVL<Key, Compare, Allocator, Augment> :: lookupBatch(size_t count, KeyAt keyAt, Probe* out, unsigned threads)
+{
+	size_t parts = max<size_t>(1, min<size_t>(threads, count / BATCH_GRAIN));
+	auto solve = [&](size_t from, size_t to)
+	{
+		// Sort by the keys' 64-bit prefixes first, so that full keys are only compared on a tie
+		vector<pair<uint64_t, uint32_t>> sorted(to - from);
+		for (size_t i = from; i < to; i++)
+			sorted[i - from] = make_pair(Traits::prefix(keyAt(i)), (uint32_t) i);
+		sort(sorted.begin(), sorted.end(), [&](const pair<uint64_t, uint32_t>& a, const pair<uint64_t, uint32_t>& b)
+		{
+			if (a.first != b.first)
+				return a.first < b.first;
+			if constexpr (Traits::exact_prefix)
+				return false;
+			else
+				return Traits::compareKeys(comp, keyAt(a.second), keyAt(b.second)) < 0;
+		});
+		vector<uint32_t> order(sorted.size());
+		for (size_t i = 0; i < sorted.size(); i++)
+			order[i] = sorted[i].second;
+		lookupSorted(order.data(), (uint32_t) order.size(), keyAt, out);
+	};
+	vector<future<void>> workers;
+	for (size_t p = 1; p < parts; p++)
+		workers.push_back(async(launch::async, solve, p * count / parts, (p + 1) * count / parts));
+	solve(0, count / parts);
+	for (future<void>& w : workers)
+		w.get();
+}
+
+// Resolves a sorted slice of probes. The tree is walked breadth-first: each task pairs a node with
+// the run of probes that reached it, which splits into the probes below, at and above its key.
+// All tasks of one level are handled before the next, and each child is prefetched as soon as it
+// is queued, so the cache misses of independent descents overlap.
+// Input: uint32_t pointer - Probe indices in key order, uint32_t - Number of them,
+//        KeyAt - Returns the key of a probe, Probe pointer - Receives the outcome of each probe
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+template <class KeyAt>
+void AVL<Key, Compare, Allocator, Augment> :: lookupSorted(const uint32_t* order, uint32_t count, KeyAt keyAt, Probe* out)
+{
+	// A node together with the probes [lo, hi) that reached it and the number of keys left of its subtree
+	struct Task
+	{
+		NodeId node;
+		uint32_t lo, hi;
+		int base;
+	};
+	vector<Task> level, next;
+	if (root != NIL && count > 0)
+		level.push_back(Task{root, 0, count, 0});
+	else
+		for (uint32_t i = 0; i < count; i++)
+			out[order[i]] = Probe{NIL, 0};
+
+	while (!level.empty())
+	{
+		for (const Task& t : level)
+		{
+			Node& n = at(t.node);
+			// Probes [t.lo, a) are below the key, [a, b) equal to it and [b, t.hi) above it
+			uint32_t a, b;
+			if (t.hi - t.lo == 1) // A lone probe, as deep in the tree most are, needs just one compare
+			{
+				int cmp = compare(keyAt(order[t.lo]), t.node);
+				a = (cmp < 0) ? t.hi : t.lo;
+				b = (cmp > 0) ? t.lo : t.hi;
+			}
+			else
+			{
+				a = partition_point(order + t.lo, order + t.hi, [&](uint32_t p) { return compare(keyAt(p), t.node) < 0; }) - order;
+				b = partition_point(order + a, order + t.hi, [&](uint32_t p) { return compare(keyAt(p), t.node) == 0; }) - order;
+			}
+			int below = t.base + getSubsize(n.left);
+			for (uint32_t i = a; i < b; i++)
+				out[order[i]] = Probe{t.node, below};
+			if (t.lo < a) // LEFT: Some probes continue into the left subtree
+			{
+				if (n.left != NIL)
+				{
+					__builtin_prefetch(&at(n.left));
+					next.push_back(Task{n.left, t.lo, a, t.base});
+				}
+				else
+					for (uint32_t i = t.lo; i < a; i++)
+						out[order[i]] = Probe{NIL, t.base};
+			}
+			if (b < t.hi) // RIGHT: Some probes continue into the right subtree
+			{
+				if (n.right != NIL)
+				{
+					__builtin_prefetch(&at(n.right));
+					next.push_back(Task{n.right, b, t.hi, below + 1});
+				}
+				else
+					for (uint32_t i = b; i < t.hi; i++)
+						out[order[i]] = Probe{NIL, below + 1};
+			}
+		}
+		level.swap(next);
+		next.clear();
+	}
+}
+
+/* SPLIT/JOIN AND SET OPERATIONS */
+// Splits the subtree rooted at a given node around a key. The subtree is consumed: its nodes
+// are redistributed between the two returned subtrees, plus the matching node if there is one.
+// Input: NodeId - Root of the subtree, Key - key to split around
+// Output: SplitResult - Subtree of smaller keys, node holding the key (NIL if absent), subtree of larger keys
+template <class Key, class Compare, class Allocator, class Augment>
+typename AVL<Key, Compare, Allocator, Augment>::SplitResult AVL<Key, Compare, Allocator, Augment> :: split(NodeId t, KeyArg k)
+{
+	if (t == NIL) // Base case: Splitting an empty tree gives two empty trees
+		return SplitResult{NIL, NIL, NIL};
+	NodeId l = at(t).left, r = at(t).right;
+	int cmp = compare(k, t);
+	if (cmp == 0) // The root holds the key, so its children are the two halves
+	{
+		setParent(l, NIL);
+		setParent(r, NIL);
+		return SplitResult{l, t, r};
+	}
+	if (cmp < 0) // The key is in the left subtree, so the root and right subtree go above it
+	{
+		SplitResult s = split(l, k);
+		s.right = join(s.right, t, r);
+		return s;
+	}
+	SplitResult s = split(r, k); // Otherwise the root and left subtree go below the key
+	s.left = join(l, t, s.left);
+	return s;
+}
+
+// Joins two subtrees around a middle node. Every key in the left subtree must be smaller than the
+// middle key, which must in turn be smaller than every key in the right subtree. Takes time
+// proportional to the difference in heights of the two subtrees.
+// Input: NodeId - Left subtree, NodeId - Middle node, NodeId - Right subtree
+// Output: NodeId - Root of the joined subtree, whose parent is NIL
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: join(NodeId tl, NodeId k, NodeId tr)
+{
+	NodeId t;
+	if (getHeight(tl) > getHeight(tr) + 1) // The left subtree is much taller, so descend its right spine
+		t = joinRight(tl, k, tr);
+	else if (getHeight(tr) > getHeight(tl) + 1) // The right subtree is much taller, so descend its left spine
+		t = joinLeft(tl, k, tr);
+	else // Heights are within one of each other, so the middle node can simply sit on top
+	{
+		link(k, tl, tr);
+		t = k;
+	}
+	setParent(t, NIL);
+	return t;
+}
+
+// Helper for join() when the left subtree is taller. Walks down the right spine of the left
+// subtree until it finds a node short enough to pair with the right subtree, then rebalances on
+// the way back up.
+// Input: NodeId - Taller left subtree, NodeId - Middle node, NodeId - Right subtree
+// Output: NodeId - Root of the joined subtree
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: joinRight(NodeId tl, NodeId k, NodeId tr)
+{
+	NodeId l = at(tl).left, c = at(tl).right;
+	if (getHeight(c) <= getHeight(tr) + 1) // Base case: c and the right subtree are close enough in height
+	{
+		link(k, c, tr);
+		if (getHeight(k) <= getHeight(l) + 1)
+		{
+			link(tl, l, k);
+			return tl;
+		}
+		Stats::rotation(true);
+		link(tl, l, rightRotate(k)); // k ended up two taller than l, so double-rotate
+		return leftRotate(tl);
+	}
+	NodeId t = joinRight(c, k, tr); // Recursive case: keep descending the right spine
+	link(tl, l, t);
+	if (getHeight(t) <= getHeight(l) + 1)
+		return tl;
+	Stats::rotation(false);
+	return leftRotate(tl);
+}
+
+// Helper for join() when the right subtree is taller. Mirror image of joinRight().
+// Input: NodeId - Left subtree, NodeId - Middle node, NodeId - Taller right subtree
+// Output: NodeId - Root of the joined subtree
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: joinLeft(NodeId tl, NodeId k, NodeId tr)
+{
+	NodeId c = at(tr).left, r = at(tr).right;
+	if (getHeight(c) <= getHeight(tl) + 1) // Base case: c and the left subtree are close enough in height
+	{
+		link(k, tl, c);
+		if (getHeight(k) <= getHeight(r) + 1)
+		{
+			link(tr, k, r);
+			return tr;
+		}
+		Stats::rotation(true);
+		link(tr, leftRotate(k), r); // k ended up two taller than r, so double-rotate
+		return rightRotate(tr);
+	}
+	NodeId t = joinLeft(tl, k, c); // Recursive case: keep descending the left spine
+	link(tr, t, r);
+	if (getHeight(t) <= getHeight(r) + 1)
+		return tr;
+	Stats::rotation(false);
+	return rightRotate(tr);
+}
+
+// Joins two subtrees whose keys are already in order, without a middle node. The largest node of
+// the left subtree is detached and used as the middle node.
+// Input: NodeId - Left subtree, NodeId - Right subtree
+// Output: NodeId - Root of the joined subtree
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: join2(NodeId tl, NodeId tr)
+{
+	if (tl == NIL)
+		return tr;
+	NodeId last;
+	NodeId rest = splitLast(tl, last);
+	return join(rest, last, tr);
+}
+
+// Detaches the node holding the largest key of a subtree.
+// Input: NodeId - Root of the subtree (must not be NIL), NodeId reference - Receives the detached node
+// Output: NodeId - Root of the remaining subtree
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: splitLast(NodeId t, NodeId& last)
+{
+	NodeId l = at(t).left, r = at(t).right;
+	if (r == NIL) // Base case: The root is the largest node, so the left subtree is what remains
+	{
+		last = t;
+		setParent(l, NIL);
+		return l;
+	}
+	NodeId rest = splitLast(r, last);
+	return join(l, t, rest);
+}
+
+// Adds every key of another tree to this one. The other tree is left untouched.
+// Input: AVL - Tree whose keys to add, Unsigned - Maximum number of threads to use
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: unionWith(const AVL& other, unsigned threads)
+{
+	runSetOp(other, threads, [this](SetOpContext& ctx, NodeId a, NodeId b, int depth) { return unionOf(ctx, a, b, depth); });
+}
+
+// Removes every key of this tree that does not also appear in another tree.
+// Input: AVL - Tree to intersect with, Unsigned - Maximum number of threads to use
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: intersectWith(const AVL& other, unsigned threads)
+{
+	runSetOp(other, threads, [this](SetOpContext& ctx, NodeId a, NodeId b, int depth) { return intersectionOf(ctx, a, b, depth); });
+}
+
+// Removes every key of this tree that appears in another tree.
+// Input: AVL - Tree whose keys to remove, Unsigned - Maximum number of threads to use
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: differenceWith(const AVL& other, unsigned threads)
+{
+	runSetOp(other, threads, [this](SetOpContext& ctx, NodeId a, NodeId b, int depth) { return differenceOf(ctx, a, b, depth); });
+}
+
+// Shared driver for the set operations. The other tree is first copied into this tree's arenas,
+// because the split/join recursion relinks nodes of both inputs. The recursion itself never
+// allocates, so its parallel tasks only share the mutex-guarded list of discarded nodes.
+// Input: AVL - Other operand, Unsigned - Maximum number of threads, Op - Recursive set operation
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+template <class Op>
+void AVL<Key, Compare, Allocator, Augment> :: runSetOp(const AVL& other, unsigned threads, Op op)
+{
+	if (&other == this) // A tree combined with itself needs no copy; only difference changes anything
+	{
+		AVL copy(comp, nodes.allocator()); // Same comparator and allocator as this tree
+		copy.root = copy.import(*this, root, NIL);
+		runSetOp(copy, threads, op);
+		return;
+	}
+	NodeId b = import(other, other.root, NIL);
+
+	// Fork while there are idle threads: each level of forking doubles the number of tasks.
+	int depth = 0;
+	while (threads > 1u << depth)
+		depth++;
+
+	SetOpContext ctx;
+	root = op(ctx, root, b, depth);
+	setParent(root, NIL);
+	for (NodeId n : ctx.discarded) // Release dropped nodes now that no task is running
+		dropNode(n);
+	evict();
+	reclaim();
+}
+
+// Copies a subtree of another tree into this tree's arenas, preserving its shape.
+// Input: AVL - Source tree, NodeId - Root of the source subtree, NodeId - Parent for the copy
+// Output: NodeId - Root of the copied subtree
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: import(const AVL& other, NodeId start, NodeId parent)
+{
+	if (start == NIL)
+		return NIL;
+	const Node& src = other.nodes[start];
+	NodeId n = newNode(Traits::view(src.key), src.own);
+	setParent(n, parent);
+	at(n).left = import(other, src.left, n);
+	at(n).right = import(other, src.right, n);
+	update(n);
+	return n;
+}
+
+// Queues a node dropped by a set operation for release.
+// Input: SetOpContext - Operation state, NodeId - Node to drop
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: discard(SetOpContext& ctx, NodeId n)
+{
+	lock_guard<mutex> guard(ctx.lock);
+	ctx.discarded.push_back(n);
+}
+
+// Queues every node of a subtree dropped by a set operation for release.
+// Input: SetOpContext - Operation state, NodeId - Root of the subtree to drop
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: discardTree(SetOpContext& ctx, NodeId t)
+{
+	if (t == NIL)
+		return;
+	vector<NodeId> pending(1, t), found;
+	while (!pending.empty()) // Collect the subtree without holding the lock
+	{
+		NodeId n = pending.back();
+		pending.pop_back();
+		found.push_back(n);
+		if (at(n).left != NIL)
+			pending.push_back(at(n).left);
+		if (at(n).right != NIL)
+			pending.push_back(at(n).right);
+	}
+	lock_guard<mutex> guard(ctx.lock);
+	ctx.discarded.insert(ctx.discarded.end(), found.begin(), found.end());
+}
+
+// Runs two independent recursive calls, on separate threads if the fork budget allows it and
+// the subproblems are large enough to be worth a thread.
+// Input: Bool - Whether to fork, Functions - Two tasks to run
+// Output: Pair - Results of the two tasks
+template <class Key, class Compare, class Allocator, class Augment>
+template <class LeftTask, class RightTask>
+pair<NodeId, NodeId> AVL<Key, Compare, Allocator, Augment> :: forkJoin(bool fork, LeftTask left, RightTask right)
+{
+	if (!fork)
+	{
+		NodeId l = left();
+		return make_pair(l, right());
+	}
+	future<NodeId> r = async(launch::async, right);
+	NodeId l = left();
+	return make_pair(l, r.get());
+}
+
+// Recursive helper for unionWith. Splits a around the root of b and unions the halves.
+// Input: SetOpContext - Operation state, NodeId - First subtree, NodeId - Second subtree,
+//        Int - Remaining fork depth
+// Output: NodeId - Root of the union
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: unionOf(SetOpContext& ctx, NodeId a, NodeId b, int depth)
+{
+	if (a == NIL)
+		return b;
+	if (b == NIL)
+		return a;
+	bool fork = depth > 0 && getSubsize(a) + getSubsize(b) >= SET_OP_GRAIN;
+	NodeId bl = at(b).left, br = at(b).right;
+	SplitResult s = split(a, Traits::view(at(b).key));
+	if (s.match != NIL) // The key is in both trees, so keep b's copy only, with b's value folded into a's as insert() would
+	{
+		Value v = at(s.match).own;
+		Augment::absorb(v, at(b).own);
+		at(b).own = v;
+		discard(ctx, s.match);
+	}
+	pair<NodeId, NodeId> halves = forkJoin(fork,
+		[&]() { return unionOf(ctx, s.left, bl, depth - 1); },
+		[&]() { return unionOf(ctx, s.right, br, depth - 1); });
+	return join(halves.first, b, halves.second);
+}
+
+// Recursive helper for intersectWith. Splits a around the root of b and intersects the halves.
+// Input: SetOpContext - Operation state, NodeId - First subtree, NodeId - Second subtree,
+//        Int - Remaining fork depth
+// Output: NodeId - Root of the intersection
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: intersectionOf(SetOpContext& ctx, NodeId a, NodeId b, int depth)
+{
+	if (a == NIL || b == NIL) // Nothing survives, so drop whatever is left of either side
+	{
+		discardTree(ctx, a);
+		discardTree(ctx, b);
+		return NIL;
+	}
+	bool fork = depth > 0 && getSubsize(a) + getSubsize(b) >= SET_OP_GRAIN;
+	NodeId bl = at(b).left, br = at(b).right;
+	SplitResult s = split(a, Traits::view(at(b).key));
+	pair<NodeId, NodeId> halves = forkJoin(fork,
+		[&]() { return intersectionOf(ctx, s.left, bl, depth - 1); },
+		[&]() { return intersectionOf(ctx, s.right, br, depth - 1); });
+	if (s.match != NIL) // The key is in both trees, so it survives (as b's copy, holding a's value)
+	{
+		at(b).own = at(s.match).own;
+		discard(ctx, s.match);
+		return join(halves.first, b, halves.second);
+	}
+	discard(ctx, b);
+	return join2(halves.first, halves.second);
+}
+
+// Recursive helper for differenceWith. Splits a around the root of b and subtracts the halves.
+// Input: SetOpContext - Operation state, NodeId - First subtree, NodeId - Second subtree,
+//        Int - Remaining fork depth
+// Output: NodeId - Root of the difference
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: differenceOf(SetOpContext& ctx, NodeId a, NodeId b, int depth)
+{
+	if (a == NIL || b == NIL) // Nothing left to subtract (or subtract from); b's leftovers are dropped
+	{
+		discardTree(ctx, b);
+		return a;
+	}
+	bool fork = depth > 0 && getSubsize(a) + getSubsize(b) >= SET_OP_GRAIN;
+	NodeId bl = at(b).left, br = at(b).right;
+	SplitResult s = split(a, Traits::view(at(b).key));
+	discard(ctx, b); // b's own key never survives
+	if (s.match != NIL)
+		discard(ctx, s.match);
+	pair<NodeId, NodeId> halves = forkJoin(fork,
+		[&]() { return differenceOf(ctx, s.left, bl, depth - 1); },
+		[&]() { return differenceOf(ctx, s.right, br, depth - 1); });
+	return join2(halves.first, halves.second);
+}
+
+/* SNAPSHOTS */
+// Compiles the current keys into a FrozenAVL. Later changes to this tree do not affect it. The
+// index holds keys alone, so it is only offered for trees without an augmentation.
+// Input: None
+// Output: FrozenAVL - Read-only index over the keys, answering find and range queries like this tree
+template <class Key, class Compare, class Allocator, class Augment>
+FrozenAVL<Key, Compare> AVL<Key, Compare, Allocator, Augment> :: freeze()
+{
+	static_assert(is_same_v<Augment, NoAugment>, "AVL::freeze: a frozen index holds no augmentation values");
+	return FrozenAVL<Key, Compare>(begin(), end(), comp);
+}
+
+// Writes the tree as an on-disk image (see MappedAVL.h), keeping its shape. The image holds keys
+// alone, so it is only offered for trees without an augmentation.
+// Input: String - Path of the image file, replaced if it exists
+// Output: None (throws runtime_error if the file cannot be written)
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: save(const string& path)
+{
+	static_assert(is_same_v<Augment, NoAugment>, "AVL::save: an image holds no augmentation values");
+	MappedAVL<Key, Compare>::write(*this, path);
+}
+
+/* BALANCE/ROTATIONS */
+// Fix the balance of the subtree rooted at a given node as needed.
+// Input: NodeId - Root of the subtree to fix
+// Output: NodeId - New root of the subtree
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: fixBalance(NodeId n)
+{
+	int bal = getBalance(n); // Obtain the balance factor of the subtree
+	if (bal > 1) // LEFT: The subtree is left-heavy
+	{
+		if (getBalance(at(n).left) >= 0) // LEFT: The left subtree of the current subtree is left-heavy (or, after an erase, level), so single-rotate
+		{
+			Stats::rotation(false);
+			return rightRotate(n);
+		}
+		else // RIGHT: The left subtree of the current subtree is right-heavy, so double-rotate
+		{
+			Stats::rotation(true);
+			at(n).left = leftRotate(at(n).left); // First left-rotate the left subtree
+			return rightRotate(n); // Now right-rotate the current subtree
+		}
+	}
+	else if (bal < -1) // RIGHT: The subtree is right-heavy
+	{
+		if (getBalance(at(n).right) <= 0) // RIGHT: The right subtree of the current subtree is right-heavy (or, after an erase, level), so single-rotate
+		{
+			Stats::rotation(false);
+			return leftRotate(n);
+		}
+		else // LEFT: The right subtree of the current subtree is left-heavy, so double-rotate
+		{
+			Stats::rotation(true);
+			at(n).right = rightRotate(at(n).right); // First right-rotate the right subtree
+			return leftRotate(n); // Now left-rotate the current subtree
+		}
+	}
+	return n; // If no balance modifications are made, simply return the node
+}
+
+// Performs a left rotation on the subtree rooted at x.
+// Input: NodeId - Root of subtree to perform rotation on
+// Output: NodeId - New root of subtree
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: leftRotate(NodeId x)
+{
+	// Obtain indices of the necessary nodes prior to rotation.
+	// assumes x is non-NIL and x's right child is non-NIL
+	NodeId y = at(x).right;
+	NodeId t2 = at(y).left;
+
+	/* STEP 1: Make y's parent to be x's parent, x's parent to be y,
+	 * and t2's parent to be x. */
+	setParent(y, at(x).parent);
+	setParent(x, y);
+	setParent(t2, x);
+
+	/* STEP 2: Make x's right subtree to be t2 and y's left child to be x. */
+	at(x).right = t2;
+	at(y).left = x;
+
+	/* STEP 3: Update the heights, subtree sizes and aggregates of x and then y, which is now above it. */
+	update(x);
+	update(y);
+
+	// Return the new root.
+	return y;
+}
+
+// Performs a right rotation on the subtree rooted at y.
+// Input: NodeId - Root of subtree to perform rotation on
+// Output: NodeId - New root of subtree
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId AVL<Key, Compare, Allocator, Augment> :: rightRotate(NodeId y)
+{
+	// Obtain indices of the necessary nodes prior to rotation.
+	NodeId x = at(y).left;
+	NodeId t2 = at(x).right;
+
+	/* STEP 1: Make x's parent to be y's parent, y's parent to be x,
+	 * and t2's parent to be y. */
+	setParent(x, at(y).parent);
+	setParent(y, x);
+	setParent(t2, y);
+
+	/* STEP 2: Make y's left subtree to be t2 and x's right child to be y. */
+	at(y).left = t2;
+	at(x).right = y;
+
+	/* STEP 3: Update the heights, subtree sizes and aggregates of y and then x, which is now above it. */
+	update(y);
+	update(x);
+
+	// Return the new root.
+	return x;
+}
+
+/* ACCESSORS */
+// Returns the height at the given node, if feasible.
+// Input: NodeId - Node of interest
+// Output: Int - Height of the node
+template <class Key, class Compare, class Allocator, class Augment>
+int AVL<Key, Compare, Allocator, Augment> :: getHeight(NodeId n)
+{
+	if (n == NIL)
+			return -1;
+	return at(n).height;
+}
+
+// Returns the balance factor at the given node, if feasible.
+// Input: NodeId - Node of interest
+// Output: Int - Balance factor of the node
+template <class Key, class Compare, class Allocator, class Augment>
+int AVL<Key, Compare, Allocator, Augment> :: getBalance(NodeId n)
+{
+	if (n == NIL)
+		return 0;
+	return getHeight(at(n).left) - getHeight(at(n).right);
+}
+
+// Returns the subtree size of the given node, if feasible.
+// Input: NodeId - Node of interest
+// Output: Int - Balance factor of the node
+template <class Key, class Compare, class Allocator, class Augment>
+int AVL<Key, Compare, Allocator, Augment> :: getSubsize(NodeId n)
+{
+	if (n == NIL)
+		return 0;
+	return at(n).subsize;
+}
+
+// Returns the memory held by the tree's arenas.
+// Input: None
+// Output: size_t - Bytes reserved by the node and key slabs
+template <class Key, class Compare, class Allocator, class Augment>
+size_t AVL<Key, Compare, Allocator, Augment> :: bytesReserved()
+{
+	return nodes.bytesReserved() + keys.bytesReserved();
+}
+
+// Checks every structural invariant of the tree.
+// Input: None
+// Output: Bool - True if the tree is a valid AVL tree with correct heights and subtree sizes
+template <class Key, class Compare, class Allocator, class Augment>
+bool AVL<Key, Compare, Allocator, Augment> :: checkInvariants()
+{
+	bool ok = true;
+	verify(root, NIL, NIL, NIL, ok);
+	return ok;
+}
+
+// Recursive helper for checkInvariants().
+// Input: NodeId - Root of the subtree, NodeId - Expected parent,
+//        NodeIds - Nodes whose keys bound the subtree's keys exclusively (NIL if unbounded),
+//        Bool reference - Cleared if a violation is found
+// Output: Int - Height of the subtree
+template <class Key, class Compare, class Allocator, class Augment>
+int AVL<Key, Compare, Allocator, Augment> :: verify(NodeId n, NodeId parent, NodeId lo, NodeId hi, bool& ok)
+{
+	if (n == NIL)
+		return -1;
+	KeyArg k = Traits::view(at(n).key);
+	if (at(n).parent != parent)
+		ok = false;
+	if ((lo != NIL && Traits::compareKeys(comp, k, Traits::view(at(lo).key)) <= 0) || (hi != NIL && Traits::compareKeys(comp, k, Traits::view(at(hi).key)) >= 0))
+		ok = false;
+	int hl = verify(at(n).left, n, lo, n, ok);
+	int hr = verify(at(n).right, n, n, hi, ok);
+	if (at(n).height != 1 + max(hl, hr) || hl - hr > 1 || hr - hl > 1)
+		ok = false;
+	if (at(n).subsize != 1 + getSubsize(at(n).left) + getSubsize(at(n).right))
+		ok = false;
+	return 1 + max(hl, hr);
+}
+
+/* MUTATORS */
+// Modifies the height attribute of a given node, if feasible.
+// Input: NodeId - Node of interest
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: setHeight(NodeId n, int h)
+{
+	if (n == NIL || h < 0)
+		return;
+	at(n).height = h;
+}
+
+// Modifies the subtree size attribute of a given node, if feasible.
+// Input: NodeId - Node of interest
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: setSubsize(NodeId n, int s)
+{
+	if (n == NIL || s < 0)
+		return;
+	at(n).subsize = s;
+}
+
+// Modifies the parent index of a given node, if feasible.
+// Input: NodeId - Node of interest, NodeId - Parent node
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: setParent(NodeId n, NodeId p)
+{
+	if (n == NIL)
+		return;
+	at(n).parent = p;
+}
+
+// Removes every key from the tree. The arenas drop their slabs wholesale, so unless the key
+// type owns resources of its own this never walks the nodes.
+// Input: None
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: clear()
+{
+	destroyKeys(root);
+	nodes.clear();
+	keys.clear();
+	root = NIL;
+}
+
+// Makes two subtrees the children of a node and recomputes its height, subtree size and aggregate.
+// Input: NodeId - Parent node, NodeId - Left subtree, NodeId - Right subtree
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: link(NodeId n, NodeId l, NodeId r)
+{
+	at(n).left = l;
+	at(n).right = r;
+	setParent(l, n);
+	setParent(r, n);
+	update(n);
+}
+
+// Recomputes the fields a node derives from its children. Every structural change (insert,
+// rotation, link) goes through here, so the augmentation can never fall out of date.
+// Input: NodeId - Node whose children are final (must not be NIL)
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: update(NodeId n)
+{
+	Node& s = at(n);
+	s.height = 1 + max(getHeight(s.left), getHeight(s.right));
+	s.subsize = 1 + getSubsize(s.left) + getSubsize(s.right);
+	if constexpr (!is_same_v<Augment, NoAugment>)
+		s.agg = Augment::combine(Augment::combine(getAggregate(s.left), s.own), getAggregate(s.right));
+}
+
+/* TRAVERSAL AND PRINT METHODS */
+// Calls a function on every node of a subtree, in pre-, in-, post- or level order. Nothing is
+// recursive and nothing is allocated, so the depth of the tree does not matter.
+// Input: NodeId - Root of the subtree, Order - Traversal order, Function - Called with the NodeId of each node
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+template <class Visit>
+void AVL<Key, Compare, Allocator, Augment> :: traverse(NodeId start, Order order, Visit visit)
+{
+	if (start == NIL)
+		return;
+	if (order != Order::Level)
+	{
+		walk(start, -1, [&](NodeId n, Order step) { if (step == order) visit(n); });
+		return;
+	}
+	// One walk per level. Each walk only enters subtrees tall enough to reach its level, so
+	// the upper levels are cheap to revisit and no queue is needed.
+	for (int level = 0, h = getHeight(start); level <= h; level++)
+		walk(start, level, [&](NodeId n, Order step) { if (step == Order::Pre) visit(n); });
+}
+
+// Walks a subtree without a stack, using the parent links to climb back up. Where the walk
+// came from (the parent, the left child or the right child) tells it what to do next at each
+// node. A level walk only reports the nodes at one depth and skips subtrees that cannot reach it.
+// Input: NodeId - Root of the subtree, Int - Depth to report (-1 for every node),
+//        Function - Called with each node and the step (Pre, In or Post) it is at
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+template <class Visit>
+void AVL<Key, Compare, Allocator, Augment> :: walk(NodeId start, int level, Visit visit)
+{
+	NodeId stop = at(start).parent;
+	NodeId prev = stop, n = start;
+	int depth = 0;
+	auto enter = [&](NodeId c) { return c != NIL && (level < 0 || (depth < level && depth + 1 + getHeight(c) >= level)); };
+	while (n != stop)
+	{
+		Node& s = at(n);
+		bool report = level < 0 || depth == level;
+		if (prev == s.parent) // Arrived from above
+		{
+			if (report)
+				visit(n, Order::Pre);
+			if (enter(s.left))
+			{
+				prev = n;
+				n = s.left;
+				depth++;
+				continue;
+			}
+		}
+		if (prev == s.parent || prev == s.left) // The left subtree is done
+		{
+			if (report)
+				visit(n, Order::In);
+			if (enter(s.right))
+			{
+				prev = n;
+				n = s.right;
+				depth++;
+				continue;
+			}
+		}
+		if (report) // Both subtrees are done, so climb back up
+			visit(n, Order::Post);
+		prev = n;
+		n = s.parent;
+		depth--;
+	}
+}
+
+// Writes every node of the tree to a sink, which receives the output in pieces.
+// Input: Sink - Callable taking a string_view, Order - Traversal order
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+template <class Sink> requires invocable<Sink&, string_view>
+void AVL<Key, Compare, Allocator, Augment> :: dump(Sink&& sink, Order order)
+{
+	dumpSubtree(root, order, sink);
+}
+
+// Writes every node of the tree to a stream.
+// Input: Ostream - Destination, Order - Traversal order
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void AVL<Key, Compare, Allocator, Augment> :: dump(ostream& out, Order order)
+{
+	auto sink = [&](string_view piece) { out.write(piece.data(), piece.size()); };
+	dumpSubtree(root, order, sink);
+}
+
+// Writes every node of a subtree to a sink as <KEY>(h = <HEIGHT>, s = <SUBSIZE>). The numbers
+// are formatted with to_chars into a buffer on the stack.
+// Input: NodeId - Root of the subtree, Order - Traversal order, Sink - Callable taking a string_view
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+template <class Sink>
+void AVL<Key, Compare, Allocator, Augment> :: dumpSubtree(NodeId start, Order order, Sink& sink)
+{
+	traverse(start, order, [&](NodeId n)
+	{
+		Traits::print(sink, at(n).key);
+		char buf[48];
+		char* end = buf + sizeof(buf);
+		char* p = copy_n("(h = ", 5, buf);
+		p = to_chars(p, end, getHeight(n)).ptr;
+		p = copy_n(", s = ", 6, p);
+		p = to_chars(p, end, getSubsize(n)).ptr;
+		*p++ = ')';
+		sink(string_view(buf, p - buf));
+	});
+}
+
+// Returns a string listing the nodes of the tree in preorder form.
+// Input: None
+// Output: String - Preorder representation of AVL tree
+template <class Key, class Compare, class Allocator, class Augment>
+string AVL<Key, Compare, Allocator, Augment> :: printPreOrder()
+{
+	return printPreOrder(root);
+}
+
+// Returns a string listing the nodes of the subtree rooted at a given node in preorder form.
+// Input: NodeId - Root of the subtree
+// Output: Preorder traversal of the subtree rooted at given node
+template <class Key, class Compare, class Allocator, class Augment>
+string AVL<Key, Compare, Allocator, Augment> :: printPreOrder(NodeId start)
+{
+	string output;
+	auto sink = [&](string_view piece) { output.append(piece); };
+	dumpSubtree(start, Order::Pre, sink);
+	return output;
+}
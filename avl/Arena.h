@@ -0,0 +1,110 @@
+/*
+	Slab arenas backing the AVL tree. NodeArena hands out nodes from contiguous slabs and
+	addresses them by 32-bit index, while KeyArena packs the bytes of every key into large
+	blocks. Both release their memory a slab at a time, so tearing down a tree never has to
+	visit its nodes. Both draw their memory from the allocator the tree was given. A whole
+	subtree can also be handed back to a NodeArena in O(1): it is only taken apart, a node at a
+	time, as later allocations reuse it.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "../common/Stats.h"
+using namespace std;
+
+typedef uint32_t NodeId; // Index of a node within its tree's arena
+const NodeId NIL = 0; // Index 0 is never handed out, so it plays the role of NULL
+
+// Slab storage for nodes of type T. T must have NodeId fields named left, right and parent.
+// Released nodes and subtrees are kept on a free list threaded through parent; the children
+// of a released node are themselves free, and are pushed onto the list when it is reused.
+template <class T, class Allocator = allocator<T>>
+class NodeArena
+{
+	private:
+		typedef typename allocator_traits<Allocator>::template rebind_alloc<T> SlabAllocator;
+
+		static constexpr uint32_t SLAB_BITS = 12; // Each slab holds 2^12 nodes
+		static constexpr uint32_t SLAB_SIZE = 1u << SLAB_BITS;
+		static constexpr uint32_t SLAB_MASK = SLAB_SIZE - 1;
+
+		[[no_unique_address]] SlabAllocator alloc; // Source of slab memory
+		vector<T*> slabs; // Slabs are never moved once allocated, so node references stay valid
+		NodeId next; // Next index that has never been handed out
+		NodeId freeList; // Head of the list of released subtrees, linked through their parent index
+		size_t live; // Number of nodes currently handed out
+
+	public:
+		explicit NodeArena(const Allocator& a = Allocator());
+		~NodeArena();
+		NodeArena(const NodeArena&) = delete;
+		NodeArena& operator=(const NodeArena&) = delete;
+		NodeArena(NodeArena&&) noexcept;
+		NodeArena& operator=(NodeArena&&) noexcept;
+
+		NodeId allocate(); // Returns the index of an uninitialized node
+		void release(NodeId); // Returns a node to the arena for reuse
+		void releaseTree(NodeId, size_t); // Returns a whole subtree of a given size to the arena in O(1)
+		void clear(); // Frees every slab at once, invalidating all indices
+
+		T& operator[](NodeId id) { return slabs[id >> SLAB_BITS][id & SLAB_MASK]; }
+		const T& operator[](NodeId id) const { return slabs[id >> SLAB_BITS][id & SLAB_MASK]; }
+
+		size_t size() const { return live; } // Number of nodes currently in use
+		size_t bytesReserved() const { return slabs.size() * SLAB_SIZE * sizeof(T); } // Total bytes held by the slabs
+		Allocator allocator() const { return Allocator(alloc); } // Allocator the slabs come from
+};
+
+// Block storage for the bytes of string keys. Each key is stored as a 32-bit length followed
+// by its bytes, so a node only needs a pointer to find both.
+template <class Allocator = allocator<char>>
+class KeyArena
+{
+	private:
+		typedef typename allocator_traits<Allocator>::template rebind_alloc<char> BlockAllocator;
+
+		static constexpr size_t BLOCK_SIZE = 64 * 1024; // Size of a regular key block
+		static constexpr size_t LARGE_KEY = BLOCK_SIZE / 4; // Keys at least this long get a block to themselves
+
+		[[no_unique_address]] BlockAllocator alloc; // Source of block memory
+		vector<pair<char*, size_t>> blocks; // Every block owned by the arena, with its size
+		char* cursor; // Next free byte in the current block
+		size_t remaining; // Bytes left in the current block
+		size_t reserved; // Total bytes held by the blocks
+		size_t stored; // Number of keys stored since the arena was last cleared
+
+	public:
+		explicit KeyArena(const Allocator& a = Allocator());
+		~KeyArena();
+		KeyArena(const KeyArena&) = delete;
+		KeyArena& operator=(const KeyArena&) = delete;
+		KeyArena(KeyArena&&) noexcept;
+		KeyArena& operator=(KeyArena&&) noexcept;
+
+		const char* store(string_view); // Copies the key into the arena and returns the address of its bytes
+		void clear(); // Frees every block at once
+
+		// Returns the length of a key stored by any KeyArena, which is kept just before its bytes
+		static uint32_t lengthOf(const char* bytes)
+		{
+			uint32_t len;
+			memcpy(&len, bytes - sizeof(uint32_t), sizeof(uint32_t));
+			return len;
+		}
+
+		size_t bytesReserved() const { return reserved; }
+		size_t count() const { return stored; } // Keys stored so far, including any no longer in use
+		Allocator allocator() const { return Allocator(alloc); } // Allocator the blocks come from
+};
+
+#include "Arena.tpp"
+#endif
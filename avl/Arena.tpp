@@ -0,0 +1,246 @@
+/*
+	Slab arenas backing the AVL tree. This implements the methods described in the header file.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+/* NODE ARENA */
+// Constructor starts with no slabs; index 0 is skipped so that it can act as NIL.
+template <class T, class Allocator>
+NodeArena<T, Allocator> :: NodeArena(const Allocator& a) : alloc(a)
+{
+	next = 1;
+	freeList = NIL;
+	live = 0;
+}
+
+// Destructor releases every slab.
+template <class T, class Allocator>
+NodeArena<T, Allocator> :: ~NodeArena()
+{
+	clear();
+}
+
+// Move constructor takes over the slabs of another arena, leaving it empty.
+template <class T, class Allocator>
+NodeArena<T, Allocator> :: NodeArena(NodeArena&& other) noexcept : alloc(other.alloc)
+{
+	slabs = std::move(other.slabs);
+	next = other.next;
+	freeList = other.freeList;
+	live = other.live;
+	other.slabs.clear();
+	other.next = 1;
+	other.freeList = NIL;
+	other.live = 0;
+}
+
+// Move assignment releases our own slabs before taking over those of another arena.
+template <class T, class Allocator>
+NodeArena<T, Allocator>& NodeArena<T, Allocator> :: operator=(NodeArena&& other) noexcept
+{
+	if (this != &other)
+	{
+		clear();
+		swap(alloc, other.alloc);
+		swap(slabs, other.slabs);
+		swap(next, other.next);
+		swap(freeList, other.freeList);
+		swap(live, other.live);
+	}
+	return *this;
+}
+
+// Hands out a node, preferring previously released ones before growing into a new slab.
+// Input: None
+// Output: NodeId - Index of the node, whose fields are left uninitialized
+template <class T, class Allocator>
+NodeId NodeArena<T, Allocator> :: allocate()
+{
+	NodeId id;
+	if (freeList != NIL) // Reuse a released node if there is one
+	{
+		id = freeList;
+		T& n = (*this)[id];
+		freeList = n.parent;
+		if (n.left != NIL) // Its children, if it had any, are released subtrees in their own right
+		{
+			(*this)[n.left].parent = freeList;
+			freeList = n.left;
+		}
+		if (n.right != NIL)
+		{
+			(*this)[n.right].parent = freeList;
+			freeList = n.right;
+		}
+	}
+	else
+	{
+		if (next == 0) // The 32-bit index space wrapped around
+			throw length_error("NodeArena: node index space exhausted");
+		if ((next >> SLAB_BITS) == slabs.size()) // The current slab is full, so start a new one
+		{
+			slabs.push_back(allocator_traits<SlabAllocator>::allocate(alloc, SLAB_SIZE));
+			Stats::allocation(0, SLAB_SIZE * sizeof(T));
+		}
+		id = next++;
+	}
+	live++;
+	Stats::allocation(1, 0);
+	return id;
+}
+
+// Returns a node to the arena so that a later allocation can reuse it. Any resources
+// held by the node must already have been released by the caller.
+// Input: NodeId - Index of the node to release
+// Output: None
+template <class T, class Allocator>
+void NodeArena<T, Allocator> :: release(NodeId id)
+{
+	if (id == NIL)
+		return;
+	T& n = (*this)[id];
+	n.left = n.right = NIL; // Whatever the node still points to is not being released with it
+	n.parent = freeList; // Thread the node onto the free list
+	freeList = id;
+	live--;
+}
+
+// Returns every node of a subtree to the arena at once. Only the root is touched; the rest
+// of the subtree is taken apart lazily by allocate(). Resources held by the nodes must
+// already have been released by the caller.
+// Input: NodeId - Root of the subtree, Size - Number of nodes in the subtree
+// Output: None
+template <class T, class Allocator>
+void NodeArena<T, Allocator> :: releaseTree(NodeId root, size_t count)
+{
+	if (root == NIL)
+		return;
+	(*this)[root].parent = freeList;
+	freeList = root;
+	live -= count;
+}
+
+// Frees all slabs at once without visiting any node.
+// Input: None
+// Output: None
+template <class T, class Allocator>
+void NodeArena<T, Allocator> :: clear()
+{
+	for (T* slab : slabs)
+		allocator_traits<SlabAllocator>::deallocate(alloc, slab, SLAB_SIZE);
+	slabs.clear();
+	next = 1;
+	freeList = NIL;
+	live = 0;
+}
+
+/* KEY ARENA */
+// Constructor starts with no blocks.
+template <class Allocator>
+KeyArena<Allocator> :: KeyArena(const Allocator& a) : alloc(a)
+{
+	cursor = NULL;
+	remaining = 0;
+	reserved = 0;
+	stored = 0;
+}
+
+// Destructor releases every block.
+template <class Allocator>
+KeyArena<Allocator> :: ~KeyArena()
+{
+	clear();
+}
+
+// Move constructor takes over the blocks of another arena, leaving it empty.
+template <class Allocator>
+KeyArena<Allocator> :: KeyArena(KeyArena&& other) noexcept : alloc(other.alloc)
+{
+	blocks = std::move(other.blocks);
+	cursor = other.cursor;
+	remaining = other.remaining;
+	reserved = other.reserved;
+	stored = other.stored;
+	other.blocks.clear();
+	other.cursor = NULL;
+	other.remaining = 0;
+	other.reserved = 0;
+	other.stored = 0;
+}
+
+// Move assignment releases our own blocks before taking over those of another arena.
+template <class Allocator>
+KeyArena<Allocator>& KeyArena<Allocator> :: operator=(KeyArena&& other) noexcept
+{
+	if (this != &other)
+	{
+		clear();
+		swap(alloc, other.alloc);
+		swap(blocks, other.blocks);
+		swap(cursor, other.cursor);
+		swap(remaining, other.remaining);
+		swap(reserved, other.reserved);
+		swap(stored, other.stored);
+	}
+	return *this;
+}
+
+// Copies a key into the arena, preceded by its 32-bit length.
+// Input: String view - Key to store
+// Output: Char pointer - Address of the stored bytes, valid until the arena is cleared
+template <class Allocator>
+const char* KeyArena<Allocator> :: store(string_view k)
+{
+	if (k.size() > UINT32_MAX) // Keys only record 32-bit lengths
+		throw length_error("KeyArena: key longer than 4 GiB");
+	uint32_t len = (uint32_t) k.size();
+	size_t need = sizeof(uint32_t) + k.size();
+	char* dest;
+	if (need >= LARGE_KEY) // Large keys get a dedicated block so they do not waste the current one
+	{
+		dest = allocator_traits<BlockAllocator>::allocate(alloc, need);
+		blocks.push_back(make_pair(dest, need));
+		reserved += need;
+		Stats::allocation(0, need);
+	}
+	else
+	{
+		if (need > remaining) // The current block cannot fit the key, so start a new one
+		{
+			cursor = allocator_traits<BlockAllocator>::allocate(alloc, BLOCK_SIZE);
+			blocks.push_back(make_pair(cursor, BLOCK_SIZE));
+			remaining = BLOCK_SIZE;
+			reserved += BLOCK_SIZE;
+			Stats::allocation(0, BLOCK_SIZE);
+		}
+		dest = cursor;
+		cursor += need;
+		remaining -= need;
+	}
+	stored++;
+	memcpy(dest, &len, sizeof(uint32_t)); // The length sits just before the bytes
+	if (!k.empty())
+		memcpy(dest + sizeof(uint32_t), k.data(), k.size());
+	return dest + sizeof(uint32_t);
+}
+
+// Frees all blocks at once.
+// Input: None
+// Output: None
+template <class Allocator>
+void KeyArena<Allocator> :: clear()
+{
+	for (pair<char*, size_t>& block : blocks)
+		allocator_traits<BlockAllocator>::deallocate(alloc, block.first, block.second);
+	blocks.clear();
+	cursor = NULL;
+	remaining = 0;
+	reserved = 0;
+	stored = 0;
+}
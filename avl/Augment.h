@@ -0,0 +1,116 @@
+/*
+	Subtree-aggregate policies for the AVL tree. An augmentation is a monoid: a value type, an
+	identity() and an associative combine(). Every node holds its own value and the combination
+	of all values in its subtree, in key order, and the tree recomputes the latter whenever a
+	structural change (insert, rotation, split, join) touches the node. AVL::rangeAggregate()
+	then folds the values of any key range in O(log n), the same way range() counts keys.
+
+	Values are stored in the node slabs, which are never constructed or destroyed member by
+	member, so the value type must be trivially copyable. Besides the monoid, a policy says
+	what a key is worth when it is inserted without a value (lift()), and how the value of a
+	key that is inserted again is folded into the one it already has (absorb()). The policies provided are:
+	  - NoAugment, the default, which holds nothing and costs nothing,
+	  - SumAugment, MinAugment and MaxAugment over an arithmetic value (a weight given with
+	    insertValue(), or the key itself when it converts to one),
+	  - CountAugment, which counts duplicate inserts instead of dropping them, turning the
+	    tree into a multiset.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef AUGMENT_H
+#define AUGMENT_H
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+using namespace std;
+
+// Value of the empty augmentation
+struct NoValue
+{
+};
+
+/* NO AUGMENTATION */
+// Keeps nothing, so the tree pays nothing.
+struct NoAugment
+{
+	typedef NoValue value_type;
+	static value_type identity() { return value_type(); }
+	static value_type combine(const value_type&, const value_type&) { return value_type(); }
+	template <class KeyArg>
+	static value_type lift(const KeyArg&) { return value_type(); }
+	static void absorb(value_type&, const value_type&) {}
+};
+
+/* SUM */
+// Total of the values in a range, such as the bytes held by the keys. Inserting a key again
+// replaces its value.
+template <class V>
+struct SumAugment
+{
+	typedef V value_type;
+	static value_type identity() { return V(); }
+	static value_type combine(const value_type& a, const value_type& b) { return a + b; }
+	template <class KeyArg>
+	static value_type lift(const KeyArg& k)
+	{
+		if constexpr (is_convertible_v<KeyArg, V>)
+			return static_cast<V>(k);
+		else
+			return identity();
+	}
+	static void absorb(value_type& own, const value_type& incoming) { own = incoming; }
+};
+
+/* MIN AND MAX */
+// Smallest value in a range. Inserting a key again keeps the smaller of its two values.
+template <class V>
+struct MinAugment
+{
+	typedef V value_type;
+	static value_type identity() { return numeric_limits<V>::max(); }
+	static value_type combine(const value_type& a, const value_type& b) { return min(a, b); }
+	template <class KeyArg>
+	static value_type lift(const KeyArg& k)
+	{
+		if constexpr (is_convertible_v<KeyArg, V>)
+			return static_cast<V>(k);
+		else
+			return identity();
+	}
+	static void absorb(value_type& own, const value_type& incoming) { own = min(own, incoming); }
+};
+
+// Largest value in a range, such as the latest timestamp. Inserting a key again keeps the
+// larger of its two values.
+template <class V>
+struct MaxAugment
+{
+	typedef V value_type;
+	static value_type identity() { return numeric_limits<V>::lowest(); }
+	static value_type combine(const value_type& a, const value_type& b) { return max(a, b); }
+	template <class KeyArg>
+	static value_type lift(const KeyArg& k)
+	{
+		if constexpr (is_convertible_v<KeyArg, V>)
+			return static_cast<V>(k);
+		else
+			return identity();
+	}
+	static void absorb(value_type& own, const value_type& incoming) { own = max(own, incoming); }
+};
+
+/* DUPLICATE COUNT */
+// Number of times each key was inserted. The tree still holds one node per distinct key, but
+// a repeated insert bumps that node's count, and rangeAggregate() counts every copy.
+struct CountAugment
+{
+	typedef long long value_type;
+	static value_type identity() { return 0; }
+	static value_type combine(const value_type& a, const value_type& b) { return a + b; }
+	template <class KeyArg>
+	static value_type lift(const KeyArg&) { return 1; }
+	static void absorb(value_type& own, const value_type& incoming) { own += incoming; }
+};
+#endif
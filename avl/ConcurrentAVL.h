@@ -0,0 +1,117 @@
+/*
+	Concurrent variant of the AVL tree. This is the header file that provides class/method
+	definitions.
+
+	Readers (contains, leq, geq, range, size) never take a lock. They descend hand-over-hand
+	with optimistic validation in the style of Bronson et al. ("A Practical Concurrent Binary
+	Search Tree"): every node carries a version number that is made odd while a rotation
+	replaces one of its child pointers. A reader records the version of each node it arrives
+	at, and after reading the next child pointer checks that neither the version nor the
+	pointer has changed; on any mismatch it restarts from the root. Counting readers also
+	check the versions of their whole path before returning, so no subtree is counted twice.
+
+	Writers lock only the nodes they touch. An insert locks the parent of the new leaf to link
+	it, then walks back up, locking each node together with its parent to recompute height
+	and subtree size, and also locking the child (and grandchild) being rotated when the node
+	is out of balance. Locks are always taken parent first; a writer that cannot get a child
+	lock releases what it holds and retries, so writers cannot deadlock.
+
+	Nodes are never removed, so a node a reader has reached stays valid for the lifetime of
+	the tree. Lookups are linearizable. Counts (leq, geq, range, size) are exact whenever no
+	insert is in flight, and otherwise may miss inserts that have not finished their walk up.
+
+	Nodes live in slabs, like the sequential tree, but are addressed by pointer: a lock-free
+	reader could not safely read a slab directory that a writer might be growing.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef CONCURRENTAVL_H
+#define CONCURRENTAVL_H
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "KeyTraits.h"
+using namespace std;
+
+template <class Key, class Compare = less<Key>>
+class ConcurrentAVL
+{
+	public:
+		typedef KeyTraits<Key, Compare> Traits;
+		typedef typename Traits::arg_type KeyArg; // Type through which keys are passed in
+
+	private:
+		class Node
+		{
+			public:
+				alignas(Key) unsigned char keyBytes[sizeof(Key)]; // Contains the data (left unconstructed in the root holder)
+				atomic<Node*> left, right, parent; // Pointers to the children and parent
+				atomic<uint64_t> version; // Odd while a rotation is relinking this node's children
+				atomic<int> height; // Tracks the height of the node (distance from the root of its subtree)
+				atomic<int> subsize; // Tracks the subtree size (number of nodes below)
+				atomic<bool> locked; // Per-node writer lock
+
+				Node() : left(NULL), right(NULL), parent(NULL), version(0), height(0), subsize(1), locked(false) {}
+				const Key& key() const { return *reinterpret_cast<const Key*>(keyBytes); }
+		};
+
+		// Outcome of an optimistic descent
+		enum Status { FOUND, ABSENT, RETRY };
+
+		static constexpr size_t SLAB_SIZE = 4096; // Nodes per slab
+		static constexpr int MAX_PATH = 96; // Longest path a counting reader records (AVL height stays below 1.45 log2 n)
+
+		Node holder; // Sentinel above the root; the root is holder.right
+		[[no_unique_address]] Compare comp; // Ordering of the keys
+		mutex allocLock; // Guards the slab list during allocation
+		vector<Node*> slabs; // Slabs of nodes, never moved once allocated
+		size_t used; // Nodes handed out from the last slab
+
+		Node* newNode(KeyArg, Node*); // Allocates and constructs a leaf node
+		Status descend(KeyArg, Node*&, uint64_t&, int&) const; // Optimistically walks down to a key or its empty slot
+		int countBelow(KeyArg, bool) const; // Counts keys below (or up to) a given key without locking
+		void repair(Node*); // Walks up from a node, recomputing fields and rebalancing
+		bool rebalance(Node*, Node*, int); // Rotates an unbalanced node whose parent and itself are locked
+		void rotateRight(Node*, Node*, Node*); // Right rotation of a node under a given parent
+		void rotateLeft(Node*, Node*, Node*); // Left rotation of a node under a given parent
+		void recompute(Node*); // Recomputes the height and subtree size of a node from its children
+		int verify(const Node*, const Node*, const Key*, const Key*, bool&) const; // Recursive helper for checkInvariants
+
+		static atomic<Node*>& child(Node* n, int dir) { return dir < 0 ? n->left : n->right; }
+		static int heightOf(const Node* n) { return n == NULL ? -1 : n->height.load(memory_order_acquire); }
+		static int sizeOf(const Node* n) { return n == NULL ? 0 : n->subsize.load(memory_order_acquire); }
+		static void lock(Node*); // Spins until the node's lock is acquired
+		static bool tryLock(Node* n) { return !n->locked.exchange(true, memory_order_acquire); }
+		static void unlock(Node* n) { n->locked.store(false, memory_order_release); }
+
+	public:
+		// Constructors
+		ConcurrentAVL();
+		explicit ConcurrentAVL(const Compare&);
+		~ConcurrentAVL();
+		ConcurrentAVL(const ConcurrentAVL&) = delete;
+		ConcurrentAVL& operator=(const ConcurrentAVL&) = delete;
+
+		// Insert methods (thread-safe)
+		bool insert(KeyArg); // Inserts a key, returning false if it was already present
+
+		// Find methods (thread-safe, lock-free)
+		bool contains(KeyArg) const; // Returns whether the key is present
+
+		// Range queries (thread-safe, lock-free)
+		int range(KeyArg, KeyArg) const; // Returns the number of keys in [k1, k2]
+		int leq(KeyArg) const; // Returns the number of keys "less than or equal" to the given key
+		int geq(KeyArg) const; // Returns the number of keys "greater than or equal" to the given key
+		int size() const; // Returns the number of keys
+
+		// Diagnostics (only meaningful while no writer is running)
+		bool checkInvariants() const; // Checks ordering, parent links, heights, subtree sizes and balance
+};
+
+#include "ConcurrentAVL.tpp"
+#endif
@@ -0,0 +1,452 @@
+/*
+	Concurrent variant of the AVL tree. This implements the methods described in the header file.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include <algorithm>
+#include <thread>
+#include <type_traits>
+
+// Default constructor
+template <class Key, class Compare>
+ConcurrentAVL<Key, Compare> :: ConcurrentAVL() : ConcurrentAVL(Compare())
+{
+}
+
+// Constructor taking a comparator
+template <class Key, class Compare>
+ConcurrentAVL<Key, Compare> :: ConcurrentAVL(const Compare& c) : comp(c)
+{
+	used = SLAB_SIZE; // Forces the first allocation to start a slab
+}
+
+// Destructor destroys every key ever constructed (including those of nodes lost to a
+// duplicate insert race) and releases the slabs. Must not run concurrently with any other call.
+template <class Key, class Compare>
+ConcurrentAVL<Key, Compare> :: ~ConcurrentAVL()
+{
+	for (size_t i = 0; i < slabs.size(); i++)
+	{
+		size_t count = (i + 1 == slabs.size()) ? used : SLAB_SIZE;
+		for (size_t j = 0; j < count; j++)
+		{
+			if constexpr (!is_trivially_destructible_v<Key>)
+				reinterpret_cast<Key*>(slabs[i][j].keyBytes)->~Key();
+			slabs[i][j].~Node();
+		}
+		::operator delete(static_cast<void*>(slabs[i]));
+	}
+}
+
+// Allocates a leaf node from the slabs and constructs its key. Only the slab list is locked.
+// Input: Key - Key for the new node, Node pointer - Its parent
+// Output: Node pointer - The new node
+template <class Key, class Compare>
+typename ConcurrentAVL<Key, Compare>::Node* ConcurrentAVL<Key, Compare> :: newNode(KeyArg k, Node* parent)
+{
+	Node* n;
+	{
+		lock_guard<mutex> guard(allocLock);
+		if (used == SLAB_SIZE) // The current slab is full, so start a new one
+		{
+			slabs.push_back(static_cast<Node*>(::operator new(sizeof(Node) * SLAB_SIZE)));
+			used = 0;
+		}
+		n = new (&slabs.back()[used]) Node();
+		used++;
+	}
+	new (n->keyBytes) Key(k);
+	n->parent.store(parent, memory_order_relaxed);
+	return n;
+}
+
+/* INSERT METHODS */
+// Inserts a key. The slot for the new leaf is found optimistically; only its parent is locked
+// to link the leaf, after which repair() restores heights, subtree sizes and balance.
+// Input: Key - Key to insert
+// Output: Bool - True if the key was inserted, false if it was already present
+template <class Key, class Compare>
+bool ConcurrentAVL<Key, Compare> :: insert(KeyArg k)
+{
+	Node* fresh = NULL; // Allocated once and reused across retries
+	while (true)
+	{
+		Node* p;
+		uint64_t pv;
+		int dir;
+		Status s = descend(k, p, pv, dir);
+		if (s == FOUND) // Duplicate keys are not permitted (a node lost to this race stays in its slab)
+			return false;
+		if (s == RETRY)
+		{
+			this_thread::yield();
+			continue;
+		}
+		if (fresh == NULL)
+			fresh = newNode(k, p);
+		lock(p);
+		if (p->version.load(memory_order_acquire) != pv || child(p, dir).load(memory_order_acquire) != NULL)
+		{
+			unlock(p); // The slot was taken or p was rotated while we were not looking
+			continue;
+		}
+		fresh->parent.store(p, memory_order_relaxed);
+		child(p, dir).store(fresh, memory_order_release); // Publishes the fully built node
+		unlock(p);
+		repair(p);
+		return true;
+	}
+}
+
+// Walks from a node up to the root. At each step the node and its parent are locked, the node's
+// height and subtree size are recomputed from its children, and it is rotated if out of balance.
+// Input: Node pointer - First node to repair
+// Output: None
+template <class Key, class Compare>
+void ConcurrentAVL<Key, Compare> :: repair(Node* n)
+{
+	while (n != &holder)
+	{
+		Node* p = n->parent.load(memory_order_acquire);
+		lock(p);
+		if (!tryLock(n)) // Parent first, then child; back off rather than wait while holding p
+		{
+			unlock(p);
+			this_thread::yield();
+			continue;
+		}
+		if (n->parent.load(memory_order_acquire) != p) // A rotation moved n before we got the locks
+		{
+			unlock(n);
+			unlock(p);
+			continue;
+		}
+		int bal = heightOf(n->left.load(memory_order_acquire)) - heightOf(n->right.load(memory_order_acquire));
+		if (bal > 1 || bal < -1)
+		{
+			if (!rebalance(p, n, bal)) // Could not lock the nodes to rotate, so retry this step
+			{
+				unlock(n);
+				unlock(p);
+				this_thread::yield();
+				continue;
+			}
+		}
+		else
+			recompute(n);
+		unlock(n);
+		unlock(p);
+		n = p;
+	}
+}
+
+// Rotates an unbalanced node. The parent and the node must already be locked; the child (and
+// grandchild, for a double rotation) are try-locked here.
+// Input: Node pointer - Parent, Node pointer - Unbalanced node, Int - Its balance factor
+// Output: Bool - True if the rotation was done, false if a lock could not be taken
+template <class Key, class Compare>
+bool ConcurrentAVL<Key, Compare> :: rebalance(Node* p, Node* n, int bal)
+{
+	if (bal > 1) // LEFT: The subtree is left-heavy
+	{
+		Node* c = n->left.load(memory_order_acquire);
+		if (!tryLock(c))
+			return false;
+		Node* cl = c->left.load(memory_order_acquire);
+		Node* cr = c->right.load(memory_order_acquire);
+		if (heightOf(cl) >= heightOf(cr)) // LEFT: single rotation
+			rotateRight(p, n, c);
+		else // RIGHT: double rotation through the grandchild
+		{
+			if (!tryLock(cr))
+			{
+				unlock(c);
+				return false;
+			}
+			rotateLeft(n, c, cr);
+			rotateRight(p, n, cr);
+			unlock(cr);
+		}
+		unlock(c);
+	}
+	else // RIGHT: The subtree is right-heavy
+	{
+		Node* c = n->right.load(memory_order_acquire);
+		if (!tryLock(c))
+			return false;
+		Node* cl = c->left.load(memory_order_acquire);
+		Node* cr = c->right.load(memory_order_acquire);
+		if (heightOf(cr) >= heightOf(cl)) // RIGHT: single rotation
+			rotateLeft(p, n, c);
+		else // LEFT: double rotation through the grandchild
+		{
+			if (!tryLock(cl))
+			{
+				unlock(c);
+				return false;
+			}
+			rotateRight(n, c, cl);
+			rotateLeft(p, n, cl);
+			unlock(cl);
+		}
+		unlock(c);
+	}
+	return true;
+}
+
+// Performs a right rotation of n (whose left child is c) beneath p. All three must be locked.
+// Their versions are odd for the duration, since each of them has a child pointer replaced.
+// Input: Node pointer - Parent, Node pointer - Node to rotate down, Node pointer - Its left child
+// Output: None
+template <class Key, class Compare>
+void ConcurrentAVL<Key, Compare> :: rotateRight(Node* p, Node* n, Node* c)
+{
+	for (Node* x : {p, n, c}) // Readers passing through any of the three must now retry
+		x->version.fetch_add(1);
+	Node* t2 = c->right.load(memory_order_acquire);
+	n->left.store(t2, memory_order_release);
+	if (t2 != NULL)
+		t2->parent.store(n, memory_order_release);
+	c->right.store(n, memory_order_release);
+	n->parent.store(c, memory_order_release);
+	c->parent.store(p, memory_order_release);
+	if (p->left.load(memory_order_acquire) == n)
+		p->left.store(c, memory_order_release);
+	else
+		p->right.store(c, memory_order_release);
+	recompute(n);
+	recompute(c);
+	for (Node* x : {p, n, c})
+		x->version.fetch_add(1);
+}
+
+// Performs a left rotation of n (whose right child is c) beneath p. Mirror image of rotateRight().
+// Input: Node pointer - Parent, Node pointer - Node to rotate down, Node pointer - Its right child
+// Output: None
+template <class Key, class Compare>
+void ConcurrentAVL<Key, Compare> :: rotateLeft(Node* p, Node* n, Node* c)
+{
+	for (Node* x : {p, n, c}) // Readers passing through any of the three must now retry
+		x->version.fetch_add(1);
+	Node* t2 = c->left.load(memory_order_acquire);
+	n->right.store(t2, memory_order_release);
+	if (t2 != NULL)
+		t2->parent.store(n, memory_order_release);
+	c->left.store(n, memory_order_release);
+	n->parent.store(c, memory_order_release);
+	c->parent.store(p, memory_order_release);
+	if (p->left.load(memory_order_acquire) == n)
+		p->left.store(c, memory_order_release);
+	else
+		p->right.store(c, memory_order_release);
+	recompute(n);
+	recompute(c);
+	for (Node* x : {p, n, c})
+		x->version.fetch_add(1);
+}
+
+// Recomputes the height and subtree size of a node from its children.
+// Input: Node pointer - Node of interest (must be locked)
+// Output: None
+template <class Key, class Compare>
+void ConcurrentAVL<Key, Compare> :: recompute(Node* n)
+{
+	Node* l = n->left.load(memory_order_acquire);
+	Node* r = n->right.load(memory_order_acquire);
+	n->height.store(1 + max(heightOf(l), heightOf(r)), memory_order_release);
+	n->subsize.store(1 + sizeOf(l) + sizeOf(r), memory_order_release);
+}
+
+// Acquires the lock of a node, spinning briefly and then yielding.
+// Input: Node pointer - Node to lock
+// Output: None
+template <class Key, class Compare>
+void ConcurrentAVL<Key, Compare> :: lock(Node* n)
+{
+	int spins = 0;
+	while (!tryLock(n))
+	{
+		while (n->locked.load(memory_order_relaxed))
+		{
+			if (++spins > 64)
+				this_thread::yield();
+		}
+	}
+}
+
+/* FIND METHODS */
+// Optimistically walks from the root towards a key without taking any lock. On arriving at each
+// node its version is recorded; after reading the next child, the parent's version and child
+// pointer are checked again, so a rotation anywhere on the path forces a retry.
+// Input: Key - key of interest; Node pointer/version/int references - Receive the last node
+//        visited, its version and the direction of the empty slot (only meaningful for ABSENT)
+// Output: Status - FOUND, ABSENT, or RETRY if a concurrent rotation got in the way
+template <class Key, class Compare>
+typename ConcurrentAVL<Key, Compare>::Status ConcurrentAVL<Key, Compare> :: descend(KeyArg k, Node*& p, uint64_t& pv, int& dir) const
+{
+	p = const_cast<Node*>(&holder);
+	pv = holder.version.load(memory_order_acquire);
+	dir = 1; // The root hangs off the right of the holder
+	if (pv & 1) // The root is being rotated right now
+		return RETRY;
+	Node* n = holder.right.load(memory_order_acquire);
+	while (true)
+	{
+		if (n == NULL) // Reached an empty slot; it is only meaningful if p did not change meanwhile
+			return p->version.load(memory_order_acquire) == pv ? ABSENT : RETRY;
+		uint64_t nv = n->version.load(memory_order_acquire);
+		if (nv & 1) // n is being rotated down right now
+			return RETRY;
+		if (child(p, dir).load(memory_order_acquire) != n || p->version.load(memory_order_acquire) != pv)
+			return RETRY; // n is no longer where we found it
+		int cmp = Traits::compareKeys(comp, k, n->key());
+		if (cmp == 0)
+			return FOUND;
+		p = n;
+		pv = nv;
+		dir = cmp < 0 ? -1 : 1;
+		n = child(p, dir).load(memory_order_acquire);
+	}
+}
+
+// Returns whether a key is present. Lock-free.
+// Input: Key - key of interest
+// Output: Bool - True if found
+template <class Key, class Compare>
+bool ConcurrentAVL<Key, Compare> :: contains(KeyArg k) const
+{
+	while (true)
+	{
+		Node* p;
+		uint64_t pv;
+		int dir;
+		Status s = descend(k, p, pv, dir);
+		if (s != RETRY)
+			return s == FOUND;
+		this_thread::yield();
+	}
+}
+
+/* RANGE QUERIES */
+// Counts the keys smaller than (or, if inclusive, equal to) a given key with the same validated
+// descent as descend(), adding up left subtree sizes along the way. Since a rotation further
+// down can lift a node over subtrees that were already counted, the versions of the whole path
+// are checked once more at the end, and the count is only returned if none of them moved.
+// Input: Key - key of interest, Bool - Whether to count a key equal to it
+// Output: Int - Number of such keys
+template <class Key, class Compare>
+int ConcurrentAVL<Key, Compare> :: countBelow(KeyArg k, bool inclusive) const
+{
+	pair<Node*, uint64_t> path[MAX_PATH]; // Nodes visited with the versions seen on arrival
+	while (true)
+	{
+		int count = 0, depth = 0;
+		Node* p = const_cast<Node*>(&holder);
+		uint64_t pv = holder.version.load(memory_order_acquire);
+		int dir = 1;
+		bool retry = (pv & 1) != 0;
+		path[depth++] = make_pair(p, pv);
+		Node* n = holder.right.load(memory_order_acquire);
+		while (!retry && n != NULL)
+		{
+			uint64_t nv = n->version.load(memory_order_acquire);
+			if ((nv & 1) || depth == MAX_PATH || child(p, dir).load(memory_order_acquire) != n || p->version.load(memory_order_acquire) != pv)
+			{
+				retry = true;
+				break;
+			}
+			path[depth++] = make_pair(n, nv);
+			int cmp = Traits::compareKeys(comp, k, n->key());
+			int below = 1 + sizeOf(n->left.load(memory_order_acquire)); // n and its left subtree
+			if (cmp == 0) // Everything left of n is smaller; n itself counts only if inclusive
+			{
+				count += inclusive ? below : below - 1;
+				break;
+			}
+			if (cmp > 0)
+				count += below;
+			p = n;
+			pv = nv;
+			dir = cmp < 0 ? -1 : 1;
+			n = child(p, dir).load(memory_order_acquire);
+		}
+		for (int i = 0; !retry && i < depth; i++)
+			retry = path[i].first->version.load(memory_order_acquire) != path[i].second;
+		if (!retry)
+			return count;
+		this_thread::yield();
+	}
+}
+
+// Returns the number of keys in [k1, k2]. Lock-free.
+// Input: Key - lower bound, Key - upper bound
+// Output: Int - Indicates number of keys in the range
+template <class Key, class Compare>
+int ConcurrentAVL<Key, Compare> :: range(KeyArg k1, KeyArg k2) const
+{
+	return max(0, countBelow(k2, true) - countBelow(k1, false));
+}
+
+// Returns the number of keys less than or equal to a given key. Lock-free.
+// Input: Key - key of interest
+// Output: Int - Number of such keys
+template <class Key, class Compare>
+int ConcurrentAVL<Key, Compare> :: leq(KeyArg k) const
+{
+	return countBelow(k, true);
+}
+
+// Returns the number of keys greater than or equal to a given key. Lock-free.
+// Input: Key - key of interest
+// Output: Int - Number of such keys
+template <class Key, class Compare>
+int ConcurrentAVL<Key, Compare> :: geq(KeyArg k) const
+{
+	return max(0, size() - countBelow(k, false));
+}
+
+// Returns the number of keys in the tree. Lock-free.
+// Input: None
+// Output: Int - Number of keys
+template <class Key, class Compare>
+int ConcurrentAVL<Key, Compare> :: size() const
+{
+	return sizeOf(holder.right.load(memory_order_acquire));
+}
+
+/* DIAGNOSTICS */
+// Checks every structural invariant of the tree. Only meaningful when no writer is running.
+// Input: None
+// Output: Bool - True if the tree is a valid AVL tree with correct augmentation
+template <class Key, class Compare>
+bool ConcurrentAVL<Key, Compare> :: checkInvariants() const
+{
+	bool ok = true;
+	verify(holder.right.load(), &holder, NULL, NULL, ok);
+	return ok;
+}
+
+// Recursive helper for checkInvariants().
+// Input: Node pointer - Root of the subtree, Node pointer - Expected parent,
+//        Key pointers - Exclusive bounds on the keys of the subtree (NULL if unbounded),
+//        Bool reference - Cleared if a violation is found
+// Output: Int - Height of the subtree
+template <class Key, class Compare>
+int ConcurrentAVL<Key, Compare> :: verify(const Node* n, const Node* parent, const Key* lo, const Key* hi, bool& ok) const
+{
+	if (n == NULL)
+		return -1;
+	if (n->parent.load() != parent || n->locked.load() || (n->version.load() & 1))
+		ok = false;
+	if ((lo != NULL && Traits::compareKeys(comp, n->key(), *lo) <= 0) || (hi != NULL && Traits::compareKeys(comp, n->key(), *hi) >= 0))
+		ok = false;
+	int hl = verify(n->left.load(), n, lo, &n->key(), ok);
+	int hr = verify(n->right.load(), n, &n->key(), hi, ok);
+	if (n->height.load() != 1 + max(hl, hr) || hl - hr > 1 || hr - hl > 1)
+		ok = false;
+	if (n->subsize.load() != 1 + sizeOf(n->left.load()) + sizeOf(n->right.load()))
+		ok = false;
+	return 1 + max(hl, hr);
+}
@@ -0,0 +1,128 @@
+/*
+	Read-only snapshot of an AVL tree, compiled for lookups. This is the header file that
+	provides class/method definitions.
+
+	A FrozenAVL holds no nodes and no pointers. Every key is reduced to its order-preserving
+	64-bit prefix (KeyTraits::prefix), and the prefixes are laid out as a static search tree in
+	the B-ary generalization of the Eytzinger layout: blocks of 8 prefixes, each block exactly
+	one 64-byte cache line, with the children of block b stored at blocks b * 9 + 1 to b * 9 + 9
+	so the whole tree is one array addressed by arithmetic. A lookup visits one cache line per
+	level (about log9 n lines instead of log2 n scattered nodes) and ranks the key within the
+	line with a SIMD compare (AVX2 or SSE4.2 when the compiler targets them, a branch-free loop
+	otherwise). findBatch() runs a group of lookups in lockstep and prefetches the next line of
+	each, so their cache misses overlap.
+
+	The full keys are kept in sorted order in a side buffer and are only read when prefixes tie,
+	which for integer and short byte keys never happens. Each slot of the tree also records the
+	rank of its key (the number of keys before it), so find(), rank(), leq(), geq() and range()
+	are all answered by a single descent and give the same results as the live AVL.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef FROZENAVL_H
+#define FROZENAVL_H
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "KeyTraits.h"
+using namespace std;
+
+// Side buffer holding a FrozenAVL's keys in sorted order. Keys are kept as plain values...
+template <class Key, bool Packed>
+class FrozenKeys
+{
+	private:
+		vector<Key> keys;
+
+	public:
+		void reserve(size_t n) { keys.reserve(n); }
+		void shrink() { keys.shrink_to_fit(); }
+		void push(const Key& k) { keys.push_back(k); }
+		const Key& operator[](size_t i) const { return keys[i]; }
+		size_t size() const { return keys.size(); }
+		size_t bytesReserved() const { return keys.capacity() * sizeof(Key); }
+};
+
+// ...except for strings under their natural order, whose bytes are packed end to end.
+template <>
+class FrozenKeys<string, true>
+{
+	private:
+		vector<char> bytes; // Key bytes, end to end
+		vector<size_t> offsets = vector<size_t>(1, 0); // Start of each key, plus one past the last
+
+	public:
+		void reserve(size_t n) { offsets.reserve(n + 1); }
+		void shrink() { bytes.shrink_to_fit(); offsets.shrink_to_fit(); }
+		void push(string_view k) { bytes.insert(bytes.end(), k.begin(), k.end()); offsets.push_back(bytes.size()); }
+		string_view operator[](size_t i) const { return string_view(bytes.data() + offsets[i], offsets[i + 1] - offsets[i]); }
+		size_t size() const { return offsets.size() - 1; }
+		size_t bytesReserved() const { return bytes.capacity() + offsets.capacity() * sizeof(size_t); }
+};
+
+template <class Key, class Compare = less<Key>>
+class FrozenAVL
+{
+	public:
+		typedef KeyTraits<Key, Compare> Traits;
+		typedef typename Traits::arg_type KeyArg; // Type through which keys are passed in
+
+	private:
+		static constexpr int B = 8; // Prefixes per block (one cache line)
+		static constexpr uint64_t SIGN = uint64_t(1) << 63; // Stored prefixes are offset by this so SIMD can use signed compares
+		static constexpr uint64_t PADDING = ~uint64_t(0) ^ SIGN; // Fills the slots past the last key
+
+		// Releases the cache-line aligned block array
+		struct AlignedDelete
+		{
+			void operator()(uint64_t* p) const { ::operator delete[](p, align_val_t(64)); }
+		};
+
+		size_t n; // Number of keys
+		size_t blocks; // Number of blocks in the search tree
+		unique_ptr<uint64_t[], AlignedDelete> tree; // blocks * B offset prefixes, in B-ary Eytzinger order
+		vector<uint32_t> ranks; // Rank of the key in each slot of tree (n for padding)
+		FrozenKeys<Key, is_same_v<typename Traits::stored_type, PackedString>> keys; // Keys in sorted order
+		[[no_unique_address]] Compare comp; // Ordering of the keys
+
+		void compile(); // Builds the search tree over the sorted keys
+		void build(size_t, const vector<uint64_t>&, size_t&); // Recursive helper that fills a block and its subtrees in order
+		static int countLess(const uint64_t*, uint64_t); // Counts the prefixes in a block below a given one
+		size_t descend(uint64_t) const; // Walks the search tree, returning the slot of the first prefix not below a given one
+		size_t resolve(KeyArg, uint64_t, size_t, bool&) const; // Turns a slot into a rank, comparing full keys on a prefix tie
+		size_t lowerBound(KeyArg, bool&) const; // Returns the rank of the first key not less than a given key
+
+	public:
+		// Constructors
+		FrozenAVL();
+		template <class InputIt>
+		FrozenAVL(InputIt, InputIt, const Compare& = Compare()); // Compiles the keys of a range (sorted or not)
+
+		// Find methods
+		bool contains(KeyArg) const; // Returns whether the key is present
+		int find(KeyArg) const; // Returns the rank of the key (-1 if absent)
+		template <class ForwardIt, class OutputIt>
+		void findBatch(ForwardIt, ForwardIt, OutputIt) const; // Writes find() of every key in a range, overlapping their cache misses
+		KeyArg at(int i) const { return keys[i]; } // Returns the key with a given 0-based rank (must be in range)
+
+		// Range queries
+		int range(KeyArg, KeyArg) const; // Returns the number of keys in [k1, k2]
+		int rank(KeyArg) const; // Returns the number of keys smaller than the given key
+		int leq(KeyArg) const; // Returns the number of keys "less than or equal" to the given key
+		int geq(KeyArg) const; // Returns the number of keys "greater than or equal" to the given key
+
+		// Accessors
+		int size() const { return (int) n; } // Returns the number of keys
+		size_t bytesReserved() const; // Returns the bytes held by the search tree, ranks and keys
+};
+
+#include "FrozenAVL.tpp"
+#endif
@@ -0,0 +1,317 @@
+/*
+	Read-only snapshot of an AVL tree, compiled for lookups. This implements the methods
+	described in the header file.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include <algorithm>
+#include <numeric>
+#if defined(__AVX2__) || defined(__SSE4_2__)
+#include <immintrin.h>
+#endif
+
+// Default constructor; an empty index
+template <class Key, class Compare>
+FrozenAVL<Key, Compare> :: FrozenAVL() : n(0), blocks(0)
+{
+}
+
+// Compiles the keys of a range. Keys coming from an AVL (see AVL::freeze) are already strictly
+// increasing and are copied in one pass; any other range is sorted and deduplicated first.
+// Input: Iterators - Range of keys, Compare - Ordering of the keys
+template <class Key, class Compare>
+template <class InputIt>
+FrozenAVL<Key, Compare> :: FrozenAVL(InputIt first, InputIt last, const Compare& c) : n(0), blocks(0), comp(c)
+{
+	if constexpr (is_base_of_v<random_access_iterator_tag, typename iterator_traits<InputIt>::iterator_category>)
+		keys.reserve(distance(first, last));
+	for (; first != last; ++first)
+		keys.push(*first);
+
+	bool sorted = true;
+	for (size_t i = 1; sorted && i < keys.size(); i++)
+		sorted = Traits::compareKeys(comp, keys[i - 1], keys[i]) < 0;
+	if (!sorted)
+	{
+		vector<size_t> order(keys.size());
+		iota(order.begin(), order.end(), 0);
+		stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return Traits::compareKeys(comp, keys[a], keys[b]) < 0; });
+		auto end = unique(order.begin(), order.end(), [&](size_t a, size_t b) { return Traits::compareKeys(comp, keys[a], keys[b]) == 0; });
+		decltype(keys) deduped;
+		deduped.reserve(end - order.begin());
+		for (auto it = order.begin(); it != end; ++it)
+			deduped.push(keys[*it]);
+		keys = move(deduped);
+	}
+	keys.shrink();
+	compile();
+}
+
+/* BUILD METHODS */
+// Lays the prefixes of the sorted keys out as a static B-ary search tree. There are just enough
+// blocks to hold every key; the slots after the last key hold PADDING, which sorts after all.
+// Input: None
+// Output: None
+template <class Key, class Compare>
+void FrozenAVL<Key, Compare> :: compile()
+{
+	n = keys.size();
+	blocks = (n + B - 1) / B;
+	vector<uint64_t> prefixes(n);
+	for (size_t i = 0; i < n; i++)
+		prefixes[i] = Traits::prefix(keys[i]) ^ SIGN;
+	tree.reset(static_cast<uint64_t*>(::operator new[](blocks * B * sizeof(uint64_t), align_val_t(64))));
+	ranks.assign(blocks * B, (uint32_t) n);
+	size_t next = 0;
+	build(0, prefixes, next);
+}
+
+// Fills a block and the subtrees below it with consecutive keys, in order: the subtree left of
+// slot i, then slot i itself, and finally the subtree right of the last slot.
+// Input: Size - Block to fill, Vector - Offset prefixes in key order, Size reference - Rank of the next key to place
+// Output: None
+template <class Key, class Compare>
+void FrozenAVL<Key, Compare> :: build(size_t b, const vector<uint64_t>& prefixes, size_t& next)
+{
+	if (b >= blocks)
+		return;
+	for (int i = 0; i < B; i++)
+	{
+		build(b * (B + 1) + i + 1, prefixes, next);
+		if (next < n)
+		{
+			tree[b * B + i] = prefixes[next];
+			ranks[b * B + i] = (uint32_t) next++;
+		}
+		else
+			tree[b * B + i] = PADDING;
+	}
+	build(b * (B + 1) + B + 1, prefixes, next);
+}
+
+/* FIND METHODS */
+// Counts the prefixes in a block that are smaller than a given one. Since the block is sorted
+// this is also the position of the first prefix not smaller, and which child to descend into.
+// Input: uint64_t pointer - Block of B offset prefixes (64-byte aligned), uint64_t - Offset prefix
+// Output: Int - Count between 0 and B
+template <class Key, class Compare>
+int FrozenAVL<Key, Compare> :: countLess(const uint64_t* block, uint64_t x)
+{
+#if defined(__AVX2__)
+	__m256i key = _mm256_set1_epi64x((long long) x);
+	__m256i lo = _mm256_cmpgt_epi64(key, _mm256_load_si256(reinterpret_cast<const __m256i*>(block)));
+	__m256i hi = _mm256_cmpgt_epi64(key, _mm256_load_si256(reinterpret_cast<const __m256i*>(block + 4)));
+	int mask = _mm256_movemask_pd(_mm256_castsi256_pd(lo)) | (_mm256_movemask_pd(_mm256_castsi256_pd(hi)) << 4);
+	return __builtin_popcount(mask);
+#elif defined(__SSE4_2__)
+	__m128i key = _mm_set1_epi64x((long long) x);
+	int mask = 0;
+	for (int i = 0; i < B; i += 2)
+		mask |= _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(key, _mm_load_si128(reinterpret_cast<const __m128i*>(block + i))))) << i;
+	return __builtin_popcount(mask);
+#else
+	int count = 0;
+	for (int i = 0; i < B; i++)
+		count += (int64_t) block[i] < (int64_t) x;
+	return count;
+#endif
+}
+
+// Walks the search tree for an offset prefix, one cache line per level.
+// Input: uint64_t - Offset prefix of the key of interest
+// Output: Size - Slot holding the first prefix not below it (blocks * B if there is none)
+template <class Key, class Compare>
+size_t FrozenAVL<Key, Compare> :: descend(uint64_t x) const
+{
+	size_t slot = blocks * B;
+	size_t b = 0;
+	while (b < blocks)
+	{
+		int j = countLess(&tree[b * B], x);
+		if (j < B) // Deeper candidates are always closer, so the last one seen wins
+			slot = b * B + j;
+		b = b * (B + 1) + j + 1;
+	}
+	return slot;
+}
+
+// Turns the slot found by descend() into the rank of the first key not less than a given key.
+// If the prefix in that slot ties with the key's (and prefixes are not exact), the keys
+// themselves are compared, galloping forward through the run of equal prefixes.
+// Input: Key - key of interest, uint64_t - Its offset prefix, Size - Slot from descend(),
+//        Bool reference - Set to whether the key is present
+// Output: Size - Rank of the first key not less than the given key (n if there is none)
+template <class Key, class Compare>
+size_t FrozenAVL<Key, Compare> :: resolve(KeyArg k, uint64_t x, size_t slot, bool& equal) const
+{
+	equal = false;
+	if (slot == blocks * B || ranks[slot] == n) // Every key is smaller
+		return n;
+	size_t r = ranks[slot];
+	if (tree[slot] != x) // The prefix already shows the key found is larger
+		return r;
+	if constexpr (Traits::exact_prefix)
+	{
+		equal = true;
+		return r;
+	}
+	else
+	{
+		int cmp = Traits::compareKeys(comp, k, keys[r]);
+		if (cmp <= 0)
+		{
+			equal = (cmp == 0);
+			return r;
+		}
+		size_t lo = r + 1, step = 1; // keys[lo - 1] < k
+		while (lo + step - 1 < n && Traits::compareKeys(comp, k, keys[lo + step - 1]) > 0)
+		{
+			lo += step;
+			step *= 2;
+		}
+		size_t hi = min(n, lo + step - 1); // keys[hi] >= k, or hi == n
+		while (lo < hi)
+		{
+			size_t mid = lo + (hi - lo) / 2;
+			if (Traits::compareKeys(comp, k, keys[mid]) > 0)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		equal = lo < n && Traits::compareKeys(comp, k, keys[lo]) == 0;
+		return lo;
+	}
+}
+
+// Finds the rank of the first key not less than a given key.
+// Input: Key - key of interest, Bool reference - Set to whether that key is present
+// Output: Size - Rank of the first key not less than the given key (n if there is none)
+template <class Key, class Compare>
+size_t FrozenAVL<Key, Compare> :: lowerBound(KeyArg k, bool& equal) const
+{
+	uint64_t x = Traits::prefix(k) ^ SIGN;
+	return resolve(k, x, descend(x), equal);
+}
+
+// Finds many keys at once. A single lookup is one chain of dependent cache misses, so this
+// descends a group of lookups in lockstep, one level at a time, prefetching the next block of
+// each as soon as it is known; the misses of the whole group then overlap.
+// Input: Forward iterators - Range of keys to look up, Output iterator - Receives the rank of each key (-1 if absent)
+// Output: None
+template <class Key, class Compare>
+template <class ForwardIt, class OutputIt>
+void FrozenAVL<Key, Compare> :: findBatch(ForwardIt first, ForwardIt last, OutputIt out) const
+{
+	static constexpr int GROUP = 16; // Lookups in flight at once
+	ForwardIt pending[GROUP];
+	uint64_t x[GROUP];
+	size_t b[GROUP], slot[GROUP];
+	while (first != last)
+	{
+		int count = 0;
+		for (; count < GROUP && first != last; ++first, count++)
+		{
+			pending[count] = first;
+			x[count] = Traits::prefix(*first) ^ SIGN;
+			b[count] = 0;
+			slot[count] = blocks * B;
+		}
+		for (bool active = blocks > 0; active;)
+		{
+			active = false;
+			for (int g = 0; g < count; g++)
+			{
+				if (b[g] >= blocks)
+					continue;
+				int j = countLess(&tree[b[g] * B], x[g]);
+				if (j < B)
+					slot[g] = b[g] * B + j;
+				b[g] = b[g] * (B + 1) + j + 1;
+				if (b[g] < blocks)
+				{
+					__builtin_prefetch(&tree[b[g] * B]);
+					active = true;
+				}
+			}
+		}
+		for (int g = 0; g < count; g++)
+		{
+			bool equal;
+			size_t r = resolve(*pending[g], x[g], slot[g], equal);
+			*out++ = equal ? (int) r : -1;
+		}
+	}
+}
+
+// Returns whether a key is present.
+// Input: Key - key of interest
+// Output: Bool - True if found
+template <class Key, class Compare>
+bool FrozenAVL<Key, Compare> :: contains(KeyArg k) const
+{
+	bool equal;
+	lowerBound(k, equal);
+	return equal;
+}
+
+// Finds a key.
+// Input: Key - key of interest
+// Output: Int - Rank of the key (-1 if absent), usable with at()
+template <class Key, class Compare>
+int FrozenAVL<Key, Compare> :: find(KeyArg k) const
+{
+	bool equal;
+	size_t r = lowerBound(k, equal);
+	return equal ? (int) r : -1;
+}
+
+/* RANGE QUERIES */
+// Returns the number of keys in [k1, k2], like AVL::range.
+// Input: Key - lower bound, Key - upper bound
+// Output: Int - Indicates number of keys in the range
+template <class Key, class Compare>
+int FrozenAVL<Key, Compare> :: range(KeyArg k1, KeyArg k2) const
+{
+	return max(0, leq(k2) - rank(k1));
+}
+
+// Returns the number of keys smaller than a given key.
+// Input: Key - key of interest
+// Output: Int - Number of such keys
+template <class Key, class Compare>
+int FrozenAVL<Key, Compare> :: rank(KeyArg k) const
+{
+	bool equal;
+	return (int) lowerBound(k, equal);
+}
+
+// Returns the number of keys less than or equal to a given key.
+// Input: Key - key of interest
+// Output: Int - Number of such keys
+template <class Key, class Compare>
+int FrozenAVL<Key, Compare> :: leq(KeyArg k) const
+{
+	bool equal;
+	size_t r = lowerBound(k, equal);
+	return (int) r + (equal ? 1 : 0);
+}
+
+// Returns the number of keys greater than or equal to a given key.
+// Input: Key - key of interest
+// Output: Int - Number of such keys
+template <class Key, class Compare>
+int FrozenAVL<Key, Compare> :: geq(KeyArg k) const
+{
+	return (int) n - rank(k);
+}
+
+// Returns the number of bytes held by the search tree, the ranks and the keys.
+// Input: None
+// Output: Size - Bytes reserved
+template <class Key, class Compare>
+size_t FrozenAVL<Key, Compare> :: bytesReserved() const
+{
+	return blocks * B * sizeof(uint64_t) + ranks.capacity() * sizeof(uint32_t) + keys.bytesReserved();
+}
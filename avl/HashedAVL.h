@@ -0,0 +1,124 @@
+/*
+	AVL tree paired with a hash index over its nodes. This is the header file that provides
+	class/method definitions.
+
+	A point lookup in the tree costs one compare and usually one cache miss per level. When most
+	queries are exact matches, HashedAVL answers them from a SwissTable-style HashTable (see
+	../hashtable/HashTable.h) whose slots hold nothing but node indices: a lookup hashes the key,
+	matches one group of control bytes and compares the key against the node the matching slot
+	points to, skipping the descent entirely. Ordered queries (range, rank, leq, geq, scan,
+	rangeAggregate) still go through the tree, so both kinds stay exact.
+
+	Keys live only in the tree. The index hashes a slot's key by reading it from its node (only
+	needed when the index grows) and compares keys the same way the tree does, through KeyTraits.
+	Node indices never change while a key stays in the tree, and string keys moved by arena
+	compaction keep their node, so the index only changes on insert and erase. For comparators
+	other than the natural order, keys that compare equal must also have equal std::hash values.
+
+	The index keeps a pointer to the tree, so a HashedAVL can be neither copied nor moved. Its
+	tree cannot be bounded with a capacity: evictions would bypass the index.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef HASHEDAVL_H
+#define HASHEDAVL_H
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "AVL.h"
+#include "../hashtable/HashTable.h"
+using namespace std;
+
+template <class Key, class Compare = less<Key>, class Allocator = allocator<Key>, class Augment = NoAugment>
+class HashedAVL
+{
+	public:
+		typedef AVL<Key, Compare, Allocator, Augment> Tree;
+		typedef typename Tree::Node Node;
+		typedef typename Tree::Traits Traits;
+		typedef typename Tree::KeyArg KeyArg; // Type through which keys are passed in
+		typedef typename Tree::Value Value; // Per-key value and subtree aggregate of the augmentation
+		typedef typename Tree::Iterator Iterator;
+		typedef typename Tree::KeyRange KeyRange;
+
+	private:
+		// Index entry: a node of the tree, wrapped so it never converts to or from a key
+		struct NodeRef
+		{
+			NodeId id;
+		};
+
+		// Hashes a key, or the key held by an indexed node
+		struct NodeHash
+		{
+			typedef void is_transparent;
+			Tree* tree;
+			uint64_t operator()(KeyArg k) const { return Traits::hash(k); }
+			uint64_t operator()(NodeRef r) const { return Traits::hash(Traits::view(tree->at(r.id).key)); }
+		};
+
+		// Compares an indexed node against a key (through KeyTraits, like the tree) or another node
+		struct NodeEqual
+		{
+			typedef void is_transparent;
+			Tree* tree;
+			bool operator()(NodeRef r, KeyArg k) const { return tree->compare(k, r.id) == 0; }
+			bool operator()(NodeRef a, NodeRef b) const { return a.id == b.id; }
+		};
+
+		Tree tree; // Ordered storage of the keys
+		HashTable<NodeRef, NoValue, NodeHash, NodeEqual, Allocator> index; // Node of every key, by hash of the key
+
+		void reindex(); // Rebuilds the index from the tree
+
+	public:
+		// Constructors
+		HashedAVL();
+		explicit HashedAVL(const Compare&, const Allocator& = Allocator());
+		template <class InputIt>
+		HashedAVL(InputIt, InputIt, const Compare& = Compare(), const Allocator& = Allocator()); // Bulk-loads the keys in a range
+		HashedAVL(const HashedAVL&) = delete;
+		HashedAVL& operator=(const HashedAVL&) = delete;
+
+		// Insert methods
+		void insert(KeyArg k) { insertValue(k, Augment::lift(k)); } // Inserts a key, if not present
+		void insertValue(KeyArg, const Value&); // Inserts a key with a given value, or folds the value into the key's own if present
+		template <class InputIt>
+		void assign(InputIt, InputIt); // Replaces the contents with the keys in a range
+
+		// Erase methods
+		bool erase(KeyArg); // Removes a key, returning whether it was present
+		int eraseRange(KeyArg, KeyArg); // Removes every key in [k1, k2], returning how many were removed
+		void clear(); // Removes every key
+
+		// Point lookups, answered by the index
+		Node* find(KeyArg); // Returns the node holding a key (NULL if absent)
+		NodeId findId(KeyArg); // Returns the index of the node holding a key (NIL if absent)
+		bool contains(KeyArg k) { return index.contains(k); } // Returns whether a key is present
+
+		// Ordered queries, answered by the tree
+		int range(KeyArg k1, KeyArg k2) { return tree.range(k1, k2); } // Returns the number of keys in [k1, k2]
+		int rank(KeyArg k) { return tree.rank(k); } // Returns the number of keys smaller than the given key
+		int leq(KeyArg k) { return tree.leq(tree.getRoot(), k); } // Returns the number of keys "less than or equal" to the given key
+		int geq(KeyArg k) { return tree.geq(tree.getRoot(), k); } // Returns the number of keys "greater than or equal" to the given key
+		Value rangeAggregate(KeyArg k1, KeyArg k2) { return tree.rangeAggregate(k1, k2); } // Combines the values of the keys in [k1, k2]
+		Iterator begin() { return tree.begin(); } // Iterator to the smallest key
+		Iterator end() { return tree.end(); } // Iterator past the largest key
+		Iterator lowerBound(KeyArg k) { return tree.lowerBound(k); } // Iterator to the first key not less than the given key
+		Iterator upperBound(KeyArg k) { return tree.upperBound(k); } // Iterator to the first key greater than the given key
+		Iterator select(int i) { return tree.select(i); } // Iterator to the key with the given 0-based rank (end() if out of range)
+		KeyRange scan(KeyArg k1, KeyArg k2) { return tree.scan(k1, k2); } // Lazy range over the keys in [k1, k2]
+
+		// Accessors
+		Node& at(NodeId n) { return tree.at(n); } // Returns the node stored at a given index (must not be NIL)
+		int size() { return tree.size(); } // Returns the number of keys
+		void reserve(size_t n) { index.reserve(n); } // Makes room in the index for a number of keys
+		double loadFactor() const { return index.loadFactor(); } // Returns the fraction of index slots in use
+		size_t bytesReserved() { return tree.bytesReserved() + index.bytesReserved(); } // Returns the number of bytes held by the tree and the index
+};
+
+#include "HashedAVL.tpp"
+#endif
@@ -0,0 +1,130 @@
+/*
+	AVL tree paired with a hash index over its nodes. This implements the methods described in
+	the header file.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+// Default constructor; an empty tree and an empty index
+template <class Key, class Compare, class Allocator, class Augment>
+HashedAVL<Key, Compare, Allocator, Augment> :: HashedAVL() : HashedAVL(Compare())
+{
+}
+
+// Constructor with a given comparator and allocator
+// Input: Compare - Ordering of the keys, Allocator - Allocator for nodes, key bytes and index slots
+template <class Key, class Compare, class Allocator, class Augment>
+HashedAVL<Key, Compare, Allocator, Augment> :: HashedAVL(const Compare& c, const Allocator& a)
+	: tree(c, a), index(0, NodeHash{&tree}, NodeEqual{&tree}, a)
+{
+}
+
+// Constructor that bulk-loads the keys in a range into the tree and then indexes every node.
+// Input: Iterators - Range of keys, Compare - Ordering of the keys, Allocator - Allocator
+template <class Key, class Compare, class Allocator, class Augment>
+template <class InputIt>
+HashedAVL<Key, Compare, Allocator, Augment> :: HashedAVL(InputIt first, InputIt last, const Compare& c, const Allocator& a)
+	: tree(first, last, c, a), index(0, NodeHash{&tree}, NodeEqual{&tree}, a)
+{
+	reindex();
+}
+
+// Rebuilds the index from scratch, sized for the whole tree up front.
+// Input: None
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void HashedAVL<Key, Compare, Allocator, Augment> :: reindex()
+{
+	index.clear();
+	index.reserve(tree.size());
+	tree.traverse(tree.getRoot(), Tree::Order::Pre, [this](NodeId n) { index.insert(NodeRef{n}); });
+}
+
+/* INSERT METHODS */
+// Inserts a key with a given augmentation value. A key already in the index is found without
+// touching the tree, unless its value has to be folded in; a new key goes into the tree, and
+// the node the tree placed it in goes into the index.
+// Input: Key - Key to insert, Value - Augmentation value of the key
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void HashedAVL<Key, Compare, Allocator, Augment> :: insertValue(KeyArg k, const Value& v)
+{
+	if (index.contains(k))
+	{
+		if constexpr (!is_same_v<Augment, NoAugment>)
+			tree.insertValue(k, v);
+		return;
+	}
+	index.insert(NodeRef{tree.insertValue(k, v)});
+}
+
+// Replaces the contents with the keys in a range, building the tree in one pass where it can
+// and then indexing every node.
+// Input: Iterators - Range of keys
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+template <class InputIt>
+void HashedAVL<Key, Compare, Allocator, Augment> :: assign(InputIt first, InputIt last)
+{
+	tree.assign(first, last);
+	reindex();
+}
+
+/* ERASE METHODS */
+// Removes a key. The index entry goes first, while the node it is compared against still
+// holds the key.
+// Input: Key - Key to remove
+// Output: Bool - True if the key was present
+template <class Key, class Compare, class Allocator, class Augment>
+bool HashedAVL<Key, Compare, Allocator, Augment> :: erase(KeyArg k)
+{
+	if (!index.erase(k))
+		return false;
+	tree.erase(k);
+	return true;
+}
+
+// Removes every key in [k1, k2]. The nodes in the range are dropped from the index one by one,
+// walking them in key order, and then the tree cuts them out in one piece. An empty range
+// (k1 > k2) stops the walk before it starts.
+// Input: Key - lower bound, Key - upper bound
+// Output: Int - Number of keys removed
+template <class Key, class Compare, class Allocator, class Augment>
+int HashedAVL<Key, Compare, Allocator, Augment> :: eraseRange(KeyArg k1, KeyArg k2)
+{
+	for (Iterator it = tree.lowerBound(k1); it != tree.end() && tree.compare(k2, it.node()) >= 0; ++it)
+		index.erase(NodeRef{it.node()});
+	return tree.eraseRange(k1, k2);
+}
+
+// Removes every key from the tree and the index.
+// Input: None
+// Output: None
+template <class Key, class Compare, class Allocator, class Augment>
+void HashedAVL<Key, Compare, Allocator, Augment> :: clear()
+{
+	index.clear();
+	tree.clear();
+}
+
+/* FIND METHODS */
+// Finds the node holding a key through the index.
+// Input: Key - Key to look for
+// Output: Node pointer - Node holding the key (NULL if absent)
+template <class Key, class Compare, class Allocator, class Augment>
+typename HashedAVL<Key, Compare, Allocator, Augment>::Node* HashedAVL<Key, Compare, Allocator, Augment> :: find(KeyArg k)
+{
+	NodeId n = findId(k);
+	return n == NIL ? NULL : &tree.at(n);
+}
+
+// Finds the index of the node holding a key through the index.
+// Input: Key - Key to look for
+// Output: NodeId - Node holding the key (NIL if absent)
+template <class Key, class Compare, class Allocator, class Augment>
+NodeId HashedAVL<Key, Compare, Allocator, Augment> :: findId(KeyArg k)
+{
+	auto* e = index.find(k);
+	return e == NULL ? NIL : e->key.id;
+}
@@ -0,0 +1,270 @@
+/*
+	Compile-time key policies for the AVL tree. KeyTraits decides how a key is stored inside
+	a node, how a lookup argument is passed, and how two keys are compared (compare() for a key
+	against a stored key, compareKeys() for two keys passed in). Each policy also maps a key to
+	an order-preserving 64-bit prefix (prefix(), exact if exact_prefix is set) for structures
+	that search over packed integers, such as FrozenAVL, hashes a key consistently with its
+	equality (hash(), for hash indexes such as HashedAVL), and writes a key's text to a sink
+	(print(), any callable taking string_view) without building a string where it can. Every comparison in
+	the tree is a single three-way compare that returns a negative number, zero or a positive
+	number, so each node visit needs exactly one call.
+
+	The generic policy stores the key as-is and derives the three-way result from the tree's
+	comparator. Specializations exist for keys with a natural total order:
+	  - arithmetic keys (IDs, timestamps) compare with branch-free integer arithmetic,
+	  - fixed-width byte keys (array<unsigned char, N>) compare with a single memcmp,
+	  - string keys ordered by less<string> pack their bytes into a KeyArena and compare
+	    through string_view, so no std::string is ever built inside the tree. Each node also
+	    caches the first 8 bytes of its key as a big-endian integer, so most node visits are
+	    decided by one integer compare without touching the key bytes at all.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef KEYTRAITS_H
+#define KEYTRAITS_H
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "Arena.h"
+using namespace std;
+
+// Placeholder key store for policies that keep the whole key inside the node.
+template <class Allocator>
+struct NoKeyStore
+{
+	explicit NoKeyStore(const Allocator& = Allocator()) {}
+	void clear() {}
+	size_t bytesReserved() const { return 0; }
+};
+
+// Packs the first 8 bytes of a string into an integer, big-endian and zero-padded, so that
+// comparing two prefixes as integers orders them the same way as comparing the bytes.
+// Input: String view - Key bytes
+// Output: uint64_t - Normalized prefix
+inline uint64_t keyPrefix(string_view k)
+{
+	uint64_t p = 0;
+	if (!k.empty())
+		memcpy(&p, k.data(), k.size() < sizeof(p) ? k.size() : sizeof(p));
+	if constexpr (endian::native == endian::little)
+		p = __builtin_bswap64(p);
+	return p;
+}
+
+// Handle to string bytes living in a KeyArena, whose length is stored just before the bytes.
+// Converts to string_view for reading.
+struct PackedString
+{
+	uint64_t prefix; // keyPrefix() of the bytes, kept in the node so most compares never follow data
+	const char* data; // Address of the first byte
+
+	uint32_t size() const { return KeyArena<>::lengthOf(data); }
+	string_view view() const { return string_view(data, size()); }
+	operator string_view() const { return view(); }
+};
+
+// True if Compare is the natural "less than" ordering of Key.
+template <class Key, class Compare>
+constexpr bool isNaturalOrder = is_same_v<Compare, less<Key>> || is_same_v<Compare, less<>>;
+
+/* GENERIC POLICY */
+// Stores the key in the node and asks the comparator twice for the three-way result.
+template <class Key, class Compare, class Enable = void>
+struct KeyTraits
+{
+	typedef Key stored_type; // What a node holds
+	typedef const Key& arg_type; // How lookups receive a key
+	template <class Allocator> using store_type = NoKeyStore<Allocator>; // Side storage for key bytes
+	static constexpr bool trivial_teardown = is_trivially_destructible_v<Key>; // True if nodes can be dropped unvisited
+
+	template <class Store>
+	static void construct(stored_type& slot, arg_type k, Store&) { new (&slot) Key(k); }
+	static void destroy(stored_type& slot) { slot.~Key(); }
+	static arg_type view(const stored_type& s) { return s; }
+
+	static int compare(const Compare& comp, arg_type a, const stored_type& b)
+	{
+		if (comp(a, b))
+			return -1;
+		return comp(b, a) ? 1 : 0;
+	}
+	static int compareKeys(const Compare& comp, arg_type a, arg_type b) { return compare(comp, a, b); }
+
+	static constexpr bool exact_prefix = false; // True if equal prefixes imply equal keys
+	static uint64_t prefix(arg_type) { return 0; } // Order-preserving 64-bit summary of a key (none known here)
+	static uint64_t hash(arg_type k) { return std::hash<Key>()(k); } // Hash of a key, equal for keys that compare equal
+
+	static string toString(const stored_type& s)
+	{
+		ostringstream out;
+		out << s;
+		return out.str();
+	}
+	template <class Sink>
+	static void print(Sink& sink, const stored_type& s) { sink(string_view(toString(s))); }
+};
+
+/* ARITHMETIC POLICY */
+// Integer and floating-point keys under their natural order. The three-way result is computed
+// from two flag-setting compares, which the compiler turns into setcc instructions, not branches.
+template <class Key, class Compare>
+struct KeyTraits<Key, Compare, enable_if_t<is_arithmetic_v<Key> && isNaturalOrder<Key, Compare>>>
+{
+	typedef Key stored_type;
+	typedef Key arg_type;
+	template <class Allocator> using store_type = NoKeyStore<Allocator>;
+	static constexpr bool trivial_teardown = true;
+
+	template <class Store>
+	static void construct(stored_type& slot, arg_type k, Store&) { slot = k; }
+	static void destroy(stored_type&) {}
+	static arg_type view(const stored_type& s) { return s; }
+
+	static int compare(const Compare&, arg_type a, stored_type b) { return (a > b) - (a < b); }
+	static int compareKeys(const Compare& comp, arg_type a, arg_type b) { return compare(comp, a, b); }
+
+	// Integers are offset so that signed values order as unsigned ones. Floating-point values go
+	// through double (exact for float) with the usual sign-flip trick; -0.0 is folded into 0.0.
+	static constexpr bool exact_prefix = sizeof(Key) <= sizeof(uint64_t) && (is_integral_v<Key> || is_same_v<Key, float> || is_same_v<Key, double>);
+	static uint64_t prefix(arg_type k)
+	{
+		if constexpr (is_integral_v<Key> && is_signed_v<Key>)
+			return static_cast<uint64_t>(static_cast<int64_t>(k)) ^ (uint64_t(1) << 63);
+		else if constexpr (is_integral_v<Key>)
+			return static_cast<uint64_t>(k);
+		else if constexpr (exact_prefix)
+		{
+			uint64_t bits = bit_cast<uint64_t>(k == 0 ? 0.0 : static_cast<double>(k));
+			return (bits >> 63) ? ~bits : bits | (uint64_t(1) << 63);
+		}
+		else
+			return 0;
+	}
+
+	// Exact prefixes already fold -0.0 into 0.0, so equal keys hash alike.
+	static uint64_t hash(arg_type k)
+	{
+		if constexpr (exact_prefix)
+			return prefix(k);
+		else
+			return std::hash<Key>()(k);
+	}
+
+	static string toString(stored_type s) { return to_string(s); }
+	template <class Sink>
+	static void print(Sink& sink, stored_type s)
+	{
+		if constexpr (is_same_v<Key, bool>)
+			sink(string_view(s ? "1" : "0"));
+		else
+		{
+			char buf[64];
+			to_chars_result r = to_chars(buf, buf + sizeof(buf), s);
+			sink(string_view(buf, r.ptr - buf));
+		}
+	}
+};
+
+/* FIXED-WIDTH BYTE POLICY */
+// Fixed-width binary keys (hashes, UUIDs, packed composite keys) ordered lexicographically.
+template <size_t N, class Compare>
+struct KeyTraits<array<unsigned char, N>, Compare, enable_if_t<isNaturalOrder<array<unsigned char, N>, Compare>>>
+{
+	typedef array<unsigned char, N> stored_type;
+	typedef const stored_type& arg_type;
+	template <class Allocator> using store_type = NoKeyStore<Allocator>;
+	static constexpr bool trivial_teardown = true;
+
+	template <class Store>
+	static void construct(stored_type& slot, arg_type k, Store&) { slot = k; }
+	static void destroy(stored_type&) {}
+	static arg_type view(const stored_type& s) { return s; }
+
+	static int compare(const Compare&, arg_type a, const stored_type& b) { return memcmp(a.data(), b.data(), N); }
+	static int compareKeys(const Compare& comp, arg_type a, arg_type b) { return compare(comp, a, b); }
+
+	static constexpr bool exact_prefix = N <= sizeof(uint64_t);
+	static uint64_t prefix(arg_type k) { return keyPrefix(string_view(reinterpret_cast<const char*>(k.data()), N)); }
+	static uint64_t hash(arg_type k) { return std::hash<string_view>()(string_view(reinterpret_cast<const char*>(k.data()), N)); }
+
+	static string toString(const stored_type& s)
+	{
+		static const char digits[] = "0123456789abcdef";
+		string out;
+		for (unsigned char c : s)
+		{
+			out += digits[c >> 4];
+			out += digits[c & 15];
+		}
+		return out;
+	}
+	template <class Sink>
+	static void print(Sink& sink, const stored_type& s)
+	{
+		static const char digits[] = "0123456789abcdef";
+		char buf[64];
+		size_t used = 0;
+		for (unsigned char c : s)
+		{
+			buf[used++] = digits[c >> 4];
+			buf[used++] = digits[c & 15];
+			if (used == sizeof(buf))
+			{
+				sink(string_view(buf, used));
+				used = 0;
+			}
+		}
+		if (used > 0)
+			sink(string_view(buf, used));
+	}
+};
+
+/* STRING POLICY */
+// Strings under their natural order. Key bytes are packed into the tree's KeyArena and nodes
+// only hold a PackedString, so nodes stay trivially destructible and lookups take string_view.
+// Compares look at the cached prefixes first and only read the key bytes when those tie.
+template <class Compare>
+struct KeyTraits<string, Compare, enable_if_t<isNaturalOrder<string, Compare>>>
+{
+	typedef PackedString stored_type;
+	typedef string_view arg_type;
+	template <class Allocator> using store_type = KeyArena<Allocator>;
+	static constexpr bool trivial_teardown = true;
+
+	template <class Store>
+	static void construct(stored_type& slot, arg_type k, Store& keys)
+	{
+		slot.prefix = keyPrefix(k);
+		slot.data = keys.store(k);
+	}
+	static void destroy(stored_type&) {}
+	static arg_type view(const stored_type& s) { return s.view(); }
+
+	static int compare(const Compare&, arg_type a, const stored_type& b)
+	{
+		uint64_t pa = keyPrefix(a);
+		if (pa != b.prefix)
+			return pa < b.prefix ? -1 : 1;
+		return a.compare(b.view()); // Same first 8 bytes (or a shorter key padded with zeros)
+	}
+	static int compareKeys(const Compare&, arg_type a, arg_type b) { return a.compare(b); }
+
+	static constexpr bool exact_prefix = false;
+	static uint64_t prefix(arg_type k) { return keyPrefix(k); }
+	static uint64_t hash(arg_type k) { return std::hash<string_view>()(k); }
+
+	static string toString(const stored_type& s) { return string(s.view()); }
+	template <class Sink>
+	static void print(Sink& sink, const stored_type& s) { sink(s.view()); }
+};
+#endif
@@ -0,0 +1,175 @@
+/*
+	On-disk image of an AVL tree, queried in place through mmap. This is the header file that
+	provides class/method definitions.
+
+	AVL::save() writes a tree as a flat file: a versioned header, then an array of fixed-size
+	node records, then a blob holding the bytes of string keys. Nodes are numbered in
+	breadth-first order starting at 1 (so NIL keeps meaning "no child" and the top levels of the
+	tree share the first few pages), and each record keeps its key, its child indices and the
+	height/subsize augmentation of the live node. MappedAVL maps such a file read-only and
+	answers find() and range() queries directly on the mapped bytes: opening an image does no
+	parsing and allocates nothing per node, however large the tree.
+
+	The header records the format version, the byte order and the key layout, and a checksum
+	over the whole file. An image that fails any of these checks is rejected when it is opened,
+	so a truncated or corrupt file is never silently misread. Verifying the checksum reads the
+	file once from start to end; it can be skipped for images known to be intact. Records are
+	not read when an image is opened. Instead every query checks each child index it follows
+	and each key it reads against the bounds in the header, one comparison per node visited,
+	and throws if a damaged record would lead it outside the mapping.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef MAPPEDAVL_H
+#define MAPPEDAVL_H
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "Arena.h"
+#include "Augment.h"
+#include "KeyTraits.h"
+using namespace std;
+
+// Fixed-size header at the start of every image.
+struct ImageHeader
+{
+	char magic[8]; // IMAGE_MAGIC
+	uint32_t version; // IMAGE_VERSION of the writer
+	uint32_t byteOrder; // IMAGE_BYTE_ORDER as seen by the writer
+	uint32_t keyKind; // Layout of the keys (see imageKeyKind)
+	uint32_t keySize; // sizeof the key type
+	uint32_t nodeSize; // sizeof one node record
+	uint32_t root; // Index of the root record (NIL if the tree is empty)
+	uint64_t count; // Number of keys (records 1 to count)
+	uint64_t nodesOffset; // File offset of the record array (right after the header), starting with the unused record 0
+	uint64_t blobOffset; // File offset of the key blob
+	uint64_t blobBytes; // Size of the key blob, which ends the file
+	uint64_t checksum; // imageChecksum() chained over the header (with this field zeroed), the records and the blob
+};
+
+const char IMAGE_MAGIC[8] = {'A', 'V', 'L', 'I', 'M', 'A', 'G', 'E'};
+const uint32_t IMAGE_VERSION = 1;
+const uint32_t IMAGE_BYTE_ORDER = 0x01020304;
+
+// Hashes a run of bytes for the image checksum, 32 bytes per step in four independent lanes
+// so that verifying a large image runs at memory speed.
+// Input: Char pointer - Bytes to hash, Size - Number of bytes, uint64_t - Running checksum to continue from
+// Output: uint64_t - Checksum
+inline uint64_t imageChecksum(const char* p, size_t len, uint64_t seed)
+{
+	static constexpr uint64_t P1 = 0x9e3779b185ebca87ULL, P2 = 0xc2b2ae3d27d4eb4fULL;
+	auto rotl = [](uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+	uint64_t lanes[4] = {seed + P1 + P2, seed + P2, seed, seed - P1};
+	size_t i = 0;
+	for (; i + 32 <= len; i += 32)
+		for (int j = 0; j < 4; j++)
+		{
+			uint64_t w;
+			memcpy(&w, p + i + 8 * j, sizeof(w));
+			lanes[j] = rotl(lanes[j] + w * P2, 31) * P1;
+		}
+	uint64_t h = len + P1;
+	for (int j = 0; j < 4; j++)
+		h = (h ^ (rotl(lanes[j] * P2, 31) * P1)) * P1 + P2;
+	for (; i < len; i++)
+		h = rotl(h ^ (static_cast<unsigned char>(p[i]) * P1), 11) * P2;
+	h ^= h >> 33;
+	h *= P2;
+	h ^= h >> 29;
+	return h;
+}
+
+// Key as laid out in a node record. Keys whose bytes are their value are stored whole...
+template <class Key, bool Packed>
+struct ImageKey
+{
+	static_assert(is_trivially_copyable_v<Key>, "MappedAVL: keys must be trivially copyable or strings under their natural order");
+	Key key;
+};
+
+// ...while string keys keep their prefix in the record and their bytes in the blob.
+template <>
+struct ImageKey<string, true>
+{
+	uint64_t prefix; // keyPrefix() of the key
+	uint64_t offset; // Position of the key bytes in the blob
+	uint32_t length; // Number of key bytes
+};
+
+// Fixed-size record for one node of an image.
+template <class Key, bool Packed>
+struct ImageNode
+{
+	ImageKey<Key, Packed> key;
+	NodeId left, right; // Indices of the child records (NIL if absent)
+	int32_t height; // Height of the node, as in the live tree
+	int32_t subsize; // Number of nodes in its subtree, as in the live tree
+};
+
+template <class Key, class Compare = less<Key>>
+class MappedAVL
+{
+	public:
+		typedef KeyTraits<Key, Compare> Traits;
+		typedef typename Traits::arg_type KeyArg; // Type through which keys are passed in
+		static constexpr bool Packed = is_same_v<typename Traits::stored_type, PackedString>;
+		typedef ImageNode<Key, Packed> Node;
+
+	private:
+		const char* base; // Start of the mapping (NULL if nothing is mapped)
+		size_t length; // Size of the mapping
+		const ImageHeader* header; // Header at the start of the mapping
+		const Node* nodes; // Node records, indexed by NodeId
+		const char* blob; // Bytes of string keys
+		[[no_unique_address]] Compare comp; // Ordering of the keys
+
+		static uint32_t imageKeyKind(); // Tag describing how this key type is laid out
+		void validate(const string&, bool); // Rejects the mapped file unless it is an intact image of this key type
+		void unmap(); // Releases the mapping
+		NodeId child(NodeId, NodeId) const; // Checks a child index read from a record before it is followed
+		string_view keyBytes(NodeId) const; // Checks that a string key lies inside the blob and returns its bytes
+		int compare(KeyArg, NodeId) const; // Three-way compare of a key against a node record
+		int leq(NodeId, KeyArg) const; // Counts the keys of a subtree less than or equal to a key
+		int geq(NodeId, KeyArg) const; // Counts the keys of a subtree greater than or equal to a key
+
+	public:
+		// Constructors
+		explicit MappedAVL(const string&, bool = true, const Compare& = Compare()); // Maps an image, verifying its checksum unless told not to
+		~MappedAVL();
+		MappedAVL(const MappedAVL&) = delete;
+		MappedAVL& operator=(const MappedAVL&) = delete;
+		MappedAVL(MappedAVL&&) noexcept;
+		MappedAVL& operator=(MappedAVL&&) noexcept;
+
+		// Writes a tree as an image
+		template <class Tree>
+		static void write(Tree&, const string&);
+
+		// Find methods
+		NodeId find(KeyArg) const; // Returns the record holding the key (NIL if absent)
+		bool contains(KeyArg k) const { return find(k) != NIL; } // Returns whether the key is present
+		KeyArg keyAt(NodeId) const; // Returns the key of a record (must not be NIL)
+
+		// Range queries
+		int range(KeyArg, KeyArg) const; // Returns the number of keys in [k1, k2]
+		int rank(KeyArg) const; // Returns the number of keys smaller than the given key
+		int leq(KeyArg k) const { return leq(getRoot(), k); } // Returns the number of keys "less than or equal" to the given key
+		int geq(KeyArg k) const { return geq(getRoot(), k); } // Returns the number of keys "greater than or equal" to the given key
+
+		// Accessors
+		const Node& at(NodeId n) const { return nodes[n]; } // Returns the record at a given index (must not be NIL)
+		NodeId getRoot() const { return header ? header->root : NIL; } // Returns the index of the root record (NIL if empty)
+		int getHeight(NodeId n) const { return n == NIL ? -1 : nodes[n].height; } // Returns the height of a record (-1 if NIL)
+		int getSubsize(NodeId n) const { return n == NIL ? 0 : nodes[n].subsize; } // Returns the subtree size of a record (0 if NIL)
+		int size() const { return getSubsize(getRoot()); } // Returns the number of keys
+		size_t bytesMapped() const { return length; } // Returns the size of the mapped file
+};
+
+#include "MappedAVL.tpp"
+#endif
@@ -0,0 +1,380 @@
+/*
+	On-disk image of an AVL tree, queried in place through mmap. This implements the methods
+	described in the header file.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include <cerrno>
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Maps an image file read-only and checks it before any query can touch it.
+// Input: String - Path of the image, Bool - Whether to verify the checksum, Compare - Ordering of the keys
+template <class Key, class Compare>
+MappedAVL<Key, Compare> :: MappedAVL(const string& path, bool verify, const Compare& c) : base(NULL), length(0), header(NULL), nodes(NULL), blob(NULL), comp(c)
+{
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw runtime_error("MappedAVL: cannot open " + path + ": " + strerror(errno));
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(ImageHeader))
+	{
+		::close(fd);
+		throw runtime_error("MappedAVL: " + path + " is too short to be an image");
+	}
+	length = (size_t) st.st_size;
+	void* p = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd); // The mapping keeps the file alive
+	if (p == MAP_FAILED)
+		throw runtime_error("MappedAVL: cannot map " + path + ": " + strerror(errno));
+	base = static_cast<const char*>(p);
+	try
+	{
+		validate(path, verify);
+	}
+	catch (...)
+	{
+		unmap();
+		throw;
+	}
+}
+
+// Destructor
+template <class Key, class Compare>
+MappedAVL<Key, Compare> :: ~MappedAVL()
+{
+	unmap();
+}
+
+// Move constructor; the other image is left empty
+template <class Key, class Compare>
+MappedAVL<Key, Compare> :: MappedAVL(MappedAVL&& other) noexcept : base(other.base), length(other.length), header(other.header), nodes(other.nodes), blob(other.blob), comp(move(other.comp))
+{
+	other.base = NULL;
+	other.length = 0;
+	other.header = NULL;
+}
+
+// Move assignment; releases this image's mapping first
+template <class Key, class Compare>
+MappedAVL<Key, Compare>& MappedAVL<Key, Compare> :: operator=(MappedAVL&& other) noexcept
+{
+	if (this != &other)
+	{
+		unmap();
+		base = other.base;
+		length = other.length;
+		header = other.header;
+		nodes = other.nodes;
+		blob = other.blob;
+		comp = move(other.comp);
+		other.base = NULL;
+		other.length = 0;
+		other.header = NULL;
+	}
+	return *this;
+}
+
+// Releases the mapping, if any.
+// Input: None
+// Output: None
+template <class Key, class Compare>
+void MappedAVL<Key, Compare> :: unmap()
+{
+	if (base != NULL)
+		munmap(const_cast<char*>(base), length);
+	base = NULL;
+	length = 0;
+	header = NULL;
+}
+
+/* IMAGE FORMAT */
+// Returns a tag for the layout of this key type, so an image written for one key type is never
+// read as another of the same size.
+// Input: None
+// Output: uint32_t - 1 for strings, 2 for signed integers, 3 for unsigned integers, 4 for floating point, 5 otherwise
+template <class Key, class Compare>
+uint32_t MappedAVL<Key, Compare> :: imageKeyKind()
+{
+	if constexpr (Packed)
+		return 1;
+	else if constexpr (is_integral_v<Key>)
+		return is_signed_v<Key> ? 2 : 3;
+	else if constexpr (is_floating_point_v<Key>)
+		return 4;
+	else
+		return 5;
+}
+
+// Checks that the mapped file is a complete image of this key type, written on a machine with
+// the same byte order, and (if asked to) that its checksum matches, then locates its sections.
+// Only the header is read unless the checksum is verified; the records are checked as queries
+// reach them (see child() and keyBytes()).
+// Input: String - Path of the image (for error messages), Bool - Whether to verify the checksum
+// Output: None (throws runtime_error if the image is rejected)
+template <class Key, class Compare>
+void MappedAVL<Key, Compare> :: validate(const string& path, bool verify)
+{
+	const ImageHeader* h = reinterpret_cast<const ImageHeader*>(base);
+	auto reject = [&](const char* why) { throw runtime_error("MappedAVL: " + path + " rejected: " + why); };
+	if (memcmp(h->magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC)) != 0)
+		reject("not an AVL image");
+	if (h->version != IMAGE_VERSION)
+		reject("unsupported format version");
+	if (h->byteOrder != IMAGE_BYTE_ORDER)
+		reject("written with a different byte order");
+	if (h->keyKind != imageKeyKind() || h->keySize != sizeof(Key) || h->nodeSize != sizeof(Node))
+		reject("written for a different key type");
+	if (h->count >= UINT32_MAX || h->root > h->count || (h->root == NIL) != (h->count == 0))
+		reject("bad node count");
+	if (h->nodesOffset != sizeof(ImageHeader) || h->blobOffset != h->nodesOffset + (h->count + 1) * sizeof(Node)
+		|| h->blobOffset > length || length - h->blobOffset != h->blobBytes)
+		reject("truncated or bad section offsets");
+	if (verify)
+	{
+		ImageHeader zeroed = *h;
+		zeroed.checksum = 0;
+		uint64_t sum = imageChecksum(reinterpret_cast<const char*>(&zeroed), sizeof(zeroed), 0);
+		sum = imageChecksum(base + h->nodesOffset, h->blobOffset - h->nodesOffset, sum);
+		if (imageChecksum(base + h->blobOffset, h->blobBytes, sum) != h->checksum)
+			reject("checksum mismatch");
+	}
+	header = h;
+	nodes = reinterpret_cast<const Node*>(base + h->nodesOffset);
+	blob = base + h->blobOffset;
+}
+
+// Writes a tree as an image. Nodes are numbered breadth-first from the root, so children are
+// always found after their parent and the first levels of the tree are packed together. The
+// file is written under a temporary name and renamed into place, so a crash while saving never
+// leaves a partial image at the given path. Records hold no augmentation values, so only trees
+// without an augmentation can be written.
+// Input: Tree - AVL tree to write, String - Path of the image
+// Output: None (throws runtime_error if the file cannot be written)
+template <class Key, class Compare>
+template <class Tree>
+void MappedAVL<Key, Compare> :: write(Tree& tree, const string& path)
+{
+	static_assert(is_same_v<typename Tree::Value, NoValue>, "MappedAVL: images hold no augmentation values");
+	size_t count = tree.size();
+	vector<Node> records(count + 1);
+	memset(static_cast<void*>(records.data()), 0, records.size() * sizeof(Node)); // Keep padding bytes deterministic for the checksum
+	string bytes; // Key blob
+	vector<NodeId> order(1, NIL); // order[i] is the live node written as record i
+	order.reserve(count + 1);
+	if (tree.getRoot() != NIL)
+		order.push_back(tree.getRoot());
+	for (size_t i = 1; i < order.size(); i++)
+	{
+		auto& s = tree.at(order[i]);
+		Node& r = records[i];
+		if constexpr (Packed)
+		{
+			string_view k = s.key.view();
+			r.key.prefix = s.key.prefix;
+			r.key.offset = bytes.size();
+			r.key.length = (uint32_t) k.size();
+			bytes.append(k);
+		}
+		else
+			r.key.key = s.key;
+		r.left = (s.left == NIL) ? NIL : (NodeId) order.size();
+		if (s.left != NIL)
+			order.push_back(s.left);
+		r.right = (s.right == NIL) ? NIL : (NodeId) order.size();
+		if (s.right != NIL)
+			order.push_back(s.right);
+		r.height = s.height;
+		r.subsize = s.subsize;
+	}
+
+	ImageHeader h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC));
+	h.version = IMAGE_VERSION;
+	h.byteOrder = IMAGE_BYTE_ORDER;
+	h.keyKind = imageKeyKind();
+	h.keySize = sizeof(Key);
+	h.nodeSize = sizeof(Node);
+	h.root = (count == 0) ? NIL : 1;
+	h.count = count;
+	h.nodesOffset = sizeof(ImageHeader);
+	h.blobOffset = h.nodesOffset + records.size() * sizeof(Node);
+	h.blobBytes = bytes.size();
+	uint64_t sum = imageChecksum(reinterpret_cast<const char*>(&h), sizeof(h), 0);
+	sum = imageChecksum(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Node), sum);
+	h.checksum = imageChecksum(bytes.data(), bytes.size(), sum);
+
+	string temp = path + ".tmp";
+	FILE* f = fopen(temp.c_str(), "wb");
+	if (f == NULL)
+		throw runtime_error("MappedAVL: cannot create " + temp + ": " + strerror(errno));
+	bool ok = fwrite(&h, sizeof(h), 1, f) == 1
+		&& fwrite(records.data(), sizeof(Node), records.size(), f) == records.size()
+		&& fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+	ok = (fflush(f) == 0) && ok;
+	ok = (fsync(fileno(f)) == 0) && ok;
+	ok = (fclose(f) == 0) && ok;
+	if (!ok || rename(temp.c_str(), path.c_str()) != 0)
+	{
+		int err = errno;
+		remove(temp.c_str());
+		throw runtime_error("MappedAVL: cannot write " + path + ": " + strerror(err));
+	}
+}
+
+/* FIND METHODS */
+// Returns a child index read from a record after checking that it names a later record of the
+// image. Images are written breadth-first, so every child comes after its parent; an index that
+// does not cannot be followed without leaving the records or walking in a circle.
+// Input: NodeId - Record the index was read from, NodeId - Child index
+// Output: NodeId - The child index (throws runtime_error if the image is damaged)
+template <class Key, class Compare>
+NodeId MappedAVL<Key, Compare> :: child(NodeId n, NodeId c) const
+{
+	if (c != NIL && (c <= n || c > header->count))
+		throw runtime_error("MappedAVL: damaged image: child index out of range");
+	return c;
+}
+
+// Returns the bytes of a string key after checking that they lie inside the blob.
+// Input: NodeId - Record of interest (must not be NIL)
+// Output: string_view - The key bytes (throws runtime_error if the image is damaged)
+template <class Key, class Compare>
+string_view MappedAVL<Key, Compare> :: keyBytes(NodeId n) const
+{
+	const ImageKey<Key, Packed>& s = nodes[n].key;
+	if (s.offset > header->blobBytes || s.length > header->blobBytes - s.offset)
+		throw runtime_error("MappedAVL: damaged image: key outside the blob");
+	return string_view(blob + s.offset, s.length);
+}
+
+// Three-way compare of a key against the key of a record.
+// Input: Key - key of interest, NodeId - Record to compare against
+// Output: Int - Negative, zero or positive as the key is smaller than, equal to or larger than the record's
+template <class Key, class Compare>
+int MappedAVL<Key, Compare> :: compare(KeyArg k, NodeId n) const
+{
+	if constexpr (Packed)
+	{
+		const ImageKey<Key, Packed>& s = nodes[n].key;
+		uint64_t p = keyPrefix(k);
+		if (p != s.prefix)
+			return p < s.prefix ? -1 : 1;
+		return k.compare(keyBytes(n));
+	}
+	else
+		return Traits::compare(comp, k, nodes[n].key.key);
+}
+
+// Finds the record holding a key.
+// Input: Key - key of interest
+// Output: NodeId - Index of the record (NIL if absent)
+template <class Key, class Compare>
+NodeId MappedAVL<Key, Compare> :: find(KeyArg k) const
+{
+	NodeId n = getRoot();
+	while (n != NIL)
+	{
+		int cmp = compare(k, n);
+		if (cmp == 0)
+			return n;
+		n = child(n, (cmp < 0) ? nodes[n].left : nodes[n].right);
+	}
+	return NIL;
+}
+
+// Returns the key of a record.
+// Input: NodeId - Record of interest (must not be NIL)
+// Output: Key - The record's key (a view into the mapping for strings)
+template <class Key, class Compare>
+typename MappedAVL<Key, Compare>::KeyArg MappedAVL<Key, Compare> :: keyAt(NodeId n) const
+{
+	if constexpr (Packed)
+		return keyBytes(n);
+	else
+		return nodes[n].key.key;
+}
+
+/* RANGE QUERIES */
+// Returns the number of keys in [k1, k2], like AVL::range.
+// Input: Key - lower bound, Key - upper bound
+// Output: Int - Indicates number of keys in the range
+template <class Key, class Compare>
+int MappedAVL<Key, Compare> :: range(KeyArg k1, KeyArg k2) const
+{
+	NodeId n = getRoot();
+	while (n != NIL)
+	{
+		if (compare(k2, n) < 0) // Both bounds are below this key, so go left
+			n = child(n, nodes[n].left);
+		else if (compare(k1, n) > 0) // Both bounds are above this key, so go right
+			n = child(n, nodes[n].right);
+		else // k1 <= key <= k2, so the answer splits across the two subtrees
+			return 1 + geq(child(n, nodes[n].left), k1) + leq(child(n, nodes[n].right), k2);
+	}
+	return 0;
+}
+
+// Returns the number of keys smaller than a given key.
+// Input: Key - key of interest
+// Output: Int - Number of such keys
+template <class Key, class Compare>
+int MappedAVL<Key, Compare> :: rank(KeyArg k) const
+{
+	return size() - geq(k);
+}
+
+// Counts the keys of a subtree that are less than or equal to a given key.
+// Input: NodeId - Root of the subtree, Key - key of interest
+// Output: Int - Number of such keys
+template <class Key, class Compare>
+int MappedAVL<Key, Compare> :: leq(NodeId n, KeyArg k) const
+{
+	int count = 0;
+	while (n != NIL)
+	{
+		int cmp = compare(k, n);
+		if (cmp < 0)
+		{
+			n = child(n, nodes[n].left);
+			continue;
+		}
+		count += 1 + getSubsize(child(n, nodes[n].left));
+		if (cmp == 0)
+			break;
+		n = child(n, nodes[n].right);
+	}
+	return count;
+}
+
+// Counts the keys of a subtree that are greater than or equal to a given key.
+// Input: NodeId - Root of the subtree, Key - key of interest
+// Output: Int - Number of such keys
+template <class Key, class Compare>
+int MappedAVL<Key, Compare> :: geq(NodeId n, KeyArg k) const
+{
+	int count = 0;
+	while (n != NIL)
+	{
+		int cmp = compare(k, n);
+		if (cmp > 0)
+		{
+			n = child(n, nodes[n].right);
+			continue;
+		}
+		count += 1 + getSubsize(child(n, nodes[n].right));
+		if (cmp == 0)
+			break;
+		n = child(n, nodes[n].left);
+	}
+	return count;
+}
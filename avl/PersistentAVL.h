@@ -0,0 +1,113 @@
+/*
+	Persistent (copy-on-write) variant of the AVL tree. This is the header file that provides
+	class/method definitions.
+
+	Nodes are immutable once built. An insert copies only the nodes on the path from the root to
+	the new leaf (plus the few a rotation touches), so each write allocates O(log n) nodes and
+	yields a new root that shares every untouched subtree with the versions before it.
+
+	snapshot() hands out the current root in O(1). A Snapshot answers queries against exactly
+	the keys present when it was taken, however many inserts happen afterwards, so long-running
+	readers never block writers and never need a deep copy. Nodes are reference counted, and a
+	node is freed as soon as no version (the live tree or any snapshot) still reaches it.
+
+	insert() and snapshot() may be called from any number of threads. A writer builds its new
+	path off to the side and then publishes the new root, starting over if another insert got
+	there first. The only lock is the one guarding the root pointer itself, held just long
+	enough to copy or swap it.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef PERSISTENTAVL_H
+#define PERSISTENTAVL_H
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "KeyTraits.h"
+using namespace std;
+
+template <class Key, class Compare = less<Key>>
+class PersistentAVL
+{
+	public:
+		typedef KeyTraits<Key, Compare> Traits;
+		typedef typename Traits::arg_type KeyArg; // Type through which keys are passed in
+
+	private:
+		class Node;
+		typedef shared_ptr<const Node> NodePtr; // Shared, immutable link to a subtree
+
+		class Node
+		{
+			public:
+				Key key; // Contains the data
+				NodePtr left, right; // Pointers to the children (no parent links, since subtrees are shared)
+				int height; // Tracks the height of the node (distance from the root of its subtree)
+				int subsize; // Tracks the subtree size (number of nodes below)
+
+				Node(const Key& k, NodePtr l, NodePtr r);
+		};
+
+		NodePtr root; // Current version of the tree
+		mutable mutex rootLock; // Guards reads and writes of root (never held while building a path)
+		[[no_unique_address]] Compare comp; // Ordering of the keys
+
+		static int heightOf(const NodePtr& n) { return n == NULL ? -1 : n->height; }
+		static int sizeOf(const NodePtr& n) { return n == NULL ? 0 : n->subsize; }
+		static NodePtr makeNode(const Key&, NodePtr, NodePtr); // Builds a node over two subtrees
+		static NodePtr balance(const Key&, NodePtr, NodePtr); // Builds a node over two subtrees, rotating if they differ in height by 2
+		NodePtr snapshotRoot() const; // Returns the current root under the root lock
+		NodePtr insert(const NodePtr&, KeyArg, bool&) const; // Recursive helper that returns the new version of a subtree
+
+	public:
+		// Read-only view of one version of the tree. Copying a snapshot is O(1), and every query
+		// on it is safe to run concurrently with inserts into the tree it came from.
+		class Snapshot
+		{
+			private:
+				NodePtr root; // Version this snapshot keeps alive
+				[[no_unique_address]] Compare comp;
+
+				int leq(KeyArg, bool) const; // Counts keys below (or up to) a given key
+
+			public:
+				Snapshot() {}
+				Snapshot(NodePtr r, const Compare& c) : root(move(r)), comp(c) {}
+
+				// Find methods
+				const Key* find(KeyArg) const; // Returns the stored key equal to the given key (NULL if absent)
+				bool contains(KeyArg k) const { return find(k) != NULL; } // Returns whether a key is present
+
+				// Range queries
+				int range(KeyArg, KeyArg) const; // Returns the number of keys in [k1, k2]
+				int leq(KeyArg k) const { return leq(k, true); } // Returns the number of keys "less than or equal" to the given key
+				int geq(KeyArg k) const { return size() - leq(k, false); } // Returns the number of keys "greater than or equal" to the given key
+				int rank(KeyArg k) const { return leq(k, false); } // Returns the number of keys smaller than the given key
+				const Key* select(int) const; // Returns the key with the given 0-based rank (NULL if out of range)
+				template <class Visitor>
+				void forEach(KeyArg, KeyArg, Visitor) const; // Calls a function on every key in [k1, k2], in order
+
+				// Accessors
+				int size() const { return sizeOf(root); } // Returns the number of keys in this version
+				int getHeight() const { return heightOf(root); } // Returns the height of this version (-1 if empty)
+		};
+
+		// Constructors
+		PersistentAVL();
+		explicit PersistentAVL(const Compare&);
+		PersistentAVL(const PersistentAVL&) = delete;
+		PersistentAVL& operator=(const PersistentAVL&) = delete;
+
+		// Insert methods (thread-safe)
+		bool insert(KeyArg); // Inserts a key as a new version, returning false if it was already present
+
+		// Versions
+		Snapshot snapshot() const; // O(1) handle on the current version
+		int size() const { return snapshot().size(); } // Returns the number of keys in the current version
+};
+
+#include "PersistentAVL.tpp"
+#endif
@@ -0,0 +1,244 @@
+/*
+	Persistent (copy-on-write) variant of the AVL tree. This implements the methods described in
+	the header file.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include <algorithm>
+
+// Node constructor; fills in the height and subtree size from the children
+template <class Key, class Compare>
+PersistentAVL<Key, Compare>::Node :: Node(const Key& k, NodePtr l, NodePtr r) : key(k), left(move(l)), right(move(r))
+{
+	height = 1 + max(heightOf(left), heightOf(right));
+	subsize = 1 + sizeOf(left) + sizeOf(right);
+}
+
+// Default constructor
+template <class Key, class Compare>
+PersistentAVL<Key, Compare> :: PersistentAVL() : PersistentAVL(Compare())
+{
+}
+
+// Constructor taking a comparator
+template <class Key, class Compare>
+PersistentAVL<Key, Compare> :: PersistentAVL(const Compare& c) : comp(c)
+{
+}
+
+/* INSERT METHODS */
+// Inserts a key. The new path is built without touching the current version, then published
+// if the root is still the one it was built from; otherwise it is rebuilt on top of the newer one.
+// Input: Key - Key to insert
+// Output: Bool - True if a new version was published, false if the key was already present
+template <class Key, class Compare>
+bool PersistentAVL<Key, Compare> :: insert(KeyArg k)
+{
+	NodePtr current = snapshotRoot();
+	while (true)
+	{
+		bool inserted = false;
+		NodePtr next = insert(current, k, inserted);
+		if (!inserted) // Duplicate keys are not permitted
+			return false;
+		lock_guard<mutex> guard(rootLock);
+		if (root == current)
+		{
+			root.swap(next); // The old root is released after the lock, when next goes out of scope
+			return true;
+		}
+		current = root; // Another insert published first
+	}
+}
+
+// Recursive helper that returns the version of a subtree with the key added. Only the nodes on
+// the search path are copied; all other subtrees are shared with the old version.
+// Input: Node pointer - Root of the subtree, Key - Key to insert, Bool reference - Set if the key was added
+// Output: Node pointer - Root of the new version of the subtree (the old root if the key was present)
+template <class Key, class Compare>
+typename PersistentAVL<Key, Compare>::NodePtr PersistentAVL<Key, Compare> :: insert(const NodePtr& n, KeyArg k, bool& inserted) const
+{
+	if (n == NULL)
+	{
+		inserted = true;
+		return makeNode(Key(k), NodePtr(), NodePtr());
+	}
+	int cmp = Traits::compareKeys(comp, k, n->key);
+	if (cmp == 0)
+		return n;
+	if (cmp < 0)
+	{
+		NodePtr l = insert(n->left, k, inserted);
+		return inserted ? balance(n->key, move(l), n->right) : n;
+	}
+	NodePtr r = insert(n->right, k, inserted);
+	return inserted ? balance(n->key, n->left, move(r)) : n;
+}
+
+/* VERSIONS */
+// Returns a handle on the current version of the tree.
+// Input: None
+// Output: Snapshot - Keeps the version alive and answers queries on it
+template <class Key, class Compare>
+typename PersistentAVL<Key, Compare>::Snapshot PersistentAVL<Key, Compare> :: snapshot() const
+{
+	return Snapshot(snapshotRoot(), comp);
+}
+
+// Returns the current root under the root lock.
+// Input: None
+// Output: Node pointer - Root of the current version
+template <class Key, class Compare>
+typename PersistentAVL<Key, Compare>::NodePtr PersistentAVL<Key, Compare> :: snapshotRoot() const
+{
+	lock_guard<mutex> guard(rootLock);
+	return root;
+}
+
+/* BALANCE/ROTATIONS */
+// Allocates a node over two subtrees.
+// Input: Key - Key of the node, Node pointers - Left and right subtrees
+// Output: Node pointer - The new node
+template <class Key, class Compare>
+typename PersistentAVL<Key, Compare>::NodePtr PersistentAVL<Key, Compare> :: makeNode(const Key& k, NodePtr l, NodePtr r)
+{
+	return make_shared<const Node>(k, move(l), move(r));
+}
+
+// Builds a node over two subtrees whose heights differ by at most 2, rotating if needed. The
+// rotated nodes are new copies, so the subtrees passed in are never modified.
+// Input: Key - Key of the node, Node pointers - Left and right subtrees
+// Output: Node pointer - Root of the balanced subtree
+template <class Key, class Compare>
+typename PersistentAVL<Key, Compare>::NodePtr PersistentAVL<Key, Compare> :: balance(const Key& k, NodePtr l, NodePtr r)
+{
+	int bal = heightOf(l) - heightOf(r);
+	if (bal > 1) // LEFT: The subtree is left-heavy
+	{
+		if (heightOf(l->left) >= heightOf(l->right)) // LEFT: single right rotation
+			return makeNode(l->key, l->left, makeNode(k, l->right, move(r)));
+		const NodePtr& lr = l->right; // RIGHT: double rotation through the grandchild
+		return makeNode(lr->key, makeNode(l->key, l->left, lr->left), makeNode(k, lr->right, move(r)));
+	}
+	if (bal < -1) // RIGHT: The subtree is right-heavy
+	{
+		if (heightOf(r->right) >= heightOf(r->left)) // RIGHT: single left rotation
+			return makeNode(r->key, makeNode(k, move(l), r->left), r->right);
+		const NodePtr& rl = r->left; // LEFT: double rotation through the grandchild
+		return makeNode(rl->key, makeNode(k, move(l), rl->left), makeNode(r->key, rl->right, r->right));
+	}
+	return makeNode(k, move(l), move(r));
+}
+
+/* SNAPSHOT QUERIES */
+// Finds a key in this version.
+// Input: Key - key of interest
+// Output: Key pointer - The stored key (NULL if absent); valid while the snapshot is alive
+template <class Key, class Compare>
+const Key* PersistentAVL<Key, Compare>::Snapshot :: find(KeyArg k) const
+{
+	const Node* n = root.get();
+	while (n != NULL)
+	{
+		int cmp = Traits::compareKeys(comp, k, n->key);
+		if (cmp == 0)
+			return &n->key;
+		n = (cmp < 0) ? n->left.get() : n->right.get();
+	}
+	return NULL;
+}
+
+// Counts the keys smaller than (or, if inclusive, equal to) a given key in this version.
+// Input: Key - key of interest, Bool - Whether to count a key equal to it
+// Output: Int - Number of such keys
+template <class Key, class Compare>
+int PersistentAVL<Key, Compare>::Snapshot :: leq(KeyArg k, bool inclusive) const
+{
+	int count = 0;
+	const Node* n = root.get();
+	while (n != NULL)
+	{
+		int cmp = Traits::compareKeys(comp, k, n->key);
+		if (cmp == 0)
+			return count + sizeOf(n->left) + (inclusive ? 1 : 0);
+		if (cmp > 0)
+		{
+			count += 1 + sizeOf(n->left);
+			n = n->right.get();
+		}
+		else
+			n = n->left.get();
+	}
+	return count;
+}
+
+// Returns the number of keys in [k1, k2] in this version.
+// Input: Key - lower bound, Key - upper bound
+// Output: Int - Indicates number of keys in the range
+template <class Key, class Compare>
+int PersistentAVL<Key, Compare>::Snapshot :: range(KeyArg k1, KeyArg k2) const
+{
+	if (Traits::compareKeys(comp, k1, k2) > 0)
+		return 0;
+	return leq(k2, true) - leq(k1, false);
+}
+
+// Finds the key with a given rank using the subtree sizes.
+// Input: Int - 0-based rank
+// Output: Key pointer - The key with that rank (NULL if out of range)
+template <class Key, class Compare>
+const Key* PersistentAVL<Key, Compare>::Snapshot :: select(int i) const
+{
+	if (i < 0 || i >= size())
+		return NULL;
+	const Node* n = root.get();
+	while (true)
+	{
+		int left = sizeOf(n->left);
+		if (i == left)
+			return &n->key;
+		if (i < left)
+			n = n->left.get();
+		else
+		{
+			i -= left + 1;
+			n = n->right.get();
+		}
+	}
+}
+
+// Visits every key in [k1, k2] in order. The walk keeps its own stack of pending ancestors,
+// since shared nodes have no parent links, and skips every subtree outside the interval.
+// Input: Key - lower bound, Key - upper bound, Visitor - Called with each key
+// Output: None
+template <class Key, class Compare>
+template <class Visitor>
+void PersistentAVL<Key, Compare>::Snapshot :: forEach(KeyArg k1, KeyArg k2, Visitor visit) const
+{
+	vector<const Node*> stack;
+	stack.reserve(heightOf(root) + 1);
+	const Node* n = root.get();
+	while (n != NULL || !stack.empty())
+	{
+		while (n != NULL) // Descend to the first key not below k1, remembering where to come back
+		{
+			if (Traits::compareKeys(comp, k1, n->key) > 0)
+				n = n->right.get();
+			else
+			{
+				stack.push_back(n);
+				n = n->left.get();
+			}
+		}
+		if (stack.empty())
+			return;
+		n = stack.back();
+		stack.pop_back();
+		if (Traits::compareKeys(comp, k2, n->key) < 0) // Past the upper bound, so nothing more to visit
+			return;
+		visit(static_cast<const Key&>(n->key));
+		n = n->right.get();
+	}
+}
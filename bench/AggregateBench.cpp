@@ -0,0 +1,71 @@
+/*
+	Benchmark for augmented AVL trees. Builds a tree of random 64-bit keys, each weighted with a
+	byte count, and answers "total bytes in [k1, k2]" queries both by scanning the range with
+	iterators and by rangeAggregate() over a SumAugment tree, for ranges of increasing width.
+
+	Build :  g++ -O2 -std=c++20 AggregateBench.cpp -o aggregate_bench
+	Usage :  ./aggregate_bench [keys] [queries]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../avl/AVL.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+typedef AVL<uint64_t, less<uint64_t>, allocator<uint64_t>, SumAugment<uint64_t>> WeightedAVL;
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+	size_t q = argc > 2 ? strtoull(argv[2], NULL, 10) : 5000;
+
+	mt19937_64 rng(29);
+	uint64_t space = 4 * n;
+	WeightedAVL weighted;
+	unordered_map<uint64_t, uint64_t> bytes; // What a scan has to look up per key without the augmentation
+	auto t = chrono::steady_clock::now();
+	for (size_t i = 0; i < n; i++)
+	{
+		uint64_t k = rng() % space, w = 64 + rng() % 4096;
+		weighted.insertValue(k, w);
+		bytes[k] = w;
+	}
+	printf("%zu keys, %zu queries, built in %.2f sec\n", n, q, secondsSince(t));
+	printf("%12s %16s %16s %10s\n", "keys/range", "scan q/sec", "aggregate q/sec", "speedup");
+
+	for (uint64_t width : {uint64_t(40), uint64_t(4000), uint64_t(40000)})
+	{
+		vector<uint64_t> starts(q);
+		for (uint64_t& s : starts)
+			s = rng() % space;
+
+		uint64_t scanned = 0, aggregated = 0;
+		t = chrono::steady_clock::now();
+		for (uint64_t s : starts)
+			for (uint64_t k : weighted.scan(s, s + width))
+				scanned += bytes[k];
+		double scanRate = q / secondsSince(t);
+		t = chrono::steady_clock::now();
+		for (uint64_t s : starts)
+			aggregated += weighted.rangeAggregate(s, s + width);
+		double aggregateRate = q / secondsSince(t);
+
+		printf("%12.0f %16.0f %16.0f %9.1fx\n", width / 4.0, scanRate, aggregateRate, aggregateRate / scanRate);
+		if (scanned != aggregated)
+			printf("  error: aggregates disagree with the scan (%llu vs %llu)\n", (unsigned long long) aggregated, (unsigned long long) scanned);
+	}
+	return 0;
+}
@@ -0,0 +1,156 @@
+/*
+	Benchmark comparing the arena-backed AVL tree against a tree of individually allocated
+	pointer nodes (std::set<string>, whose nodes have the same shape as the old AVL Node:
+	three pointers, balance bookkeeping and an embedded std::string). Reports live heap bytes per
+	node, find throughput and teardown time.
+
+	Two key sets are measured: URL-like keys whose first 8 bytes mostly differ (host first, as
+	most of our keys are), where the prefix cached in each AVL<string> node settles nearly every
+	compare, and keys that all share a long common prefix, where every compare falls back to
+	reading the key bytes.
+
+	Build :  g++ -O2 -std=c++20 ArenaBench.cpp -o arena_bench
+	Usage :  ./arena_bench [number of keys] [number of lookups]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../avl/AVL.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Every heap allocation in the process goes through these, so the benchmark can attribute live
+// bytes and allocation counts to each structure. Each block carries its size in a small header.
+// They are kept out of line so GCC does not pair the inlined free() with a new-expression and warn.
+static size_t heapBytes = 0;
+static size_t heapAllocs = 0;
+static const size_t HEADER = alignof(max_align_t);
+
+__attribute__((noinline)) void* operator new(size_t n)
+{
+	char* p = static_cast<char*>(malloc(n + HEADER));
+	if (p == NULL)
+		throw bad_alloc();
+	*reinterpret_cast<size_t*>(p) = n;
+	heapBytes += n;
+	heapAllocs++;
+	return p + HEADER;
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept
+{
+	if (p == NULL)
+		return;
+	char* base = static_cast<char*>(p) - HEADER;
+	heapBytes -= *reinterpret_cast<size_t*>(base);
+	heapAllocs--;
+	free(base);
+}
+
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+// Generates URL-like keys, which are long enough to defeat the small string optimization.
+// Input: Size - Number of keys, Generator - Random source, Bool - Whether all keys share one long prefix
+// Output: Vector of strings - The keys
+static vector<string> makeKeys(size_t n, mt19937_64& rng, bool sharedPrefix)
+{
+	vector<string> out;
+	out.reserve(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		if (sharedPrefix)
+			out.push_back("https://example.com/item/" + to_string(rng()));
+		else
+			out.push_back(to_string(rng()) + ".example.com/item/" + to_string(rng() % 1000));
+	}
+	return out;
+}
+
+// Measures the arena AVL and the pointer-node tree on one set of keys.
+// Input: Vector of strings - Keys to insert, Vector of strings - Keys to look up, String - Label for the key set
+// Output: None
+static void run(const vector<string>& keys, const vector<string>& probes, const char* label)
+{
+	size_t n = keys.size(), lookups = probes.size();
+	printf("\n%s\n", label);
+	printf("%-14s %12s %12s %14s %12s\n", "structure", "bytes/node", "allocs/node", "finds/sec", "teardown ms");
+
+	/* ARENA AVL */
+	{
+		size_t bytes0 = heapBytes, allocs0 = heapAllocs;
+		AVL<string>* tree = new AVL<string>();
+		for (const string& k : keys)
+			tree->insert(k);
+		double bytes = (double) (heapBytes - bytes0) / n;
+		double allocs = (double) (heapAllocs - allocs0) / n;
+
+		size_t hits = 0;
+		auto t = chrono::steady_clock::now();
+		for (const string& k : probes)
+			hits += tree->find(k) != NULL;
+		double findRate = lookups / secondsSince(t);
+
+		t = chrono::steady_clock::now();
+		delete tree;
+		double teardown = secondsSince(t) * 1e3;
+		printf("%-14s %12.1f %12.3f %14.0f %12.2f\n", "arena AVL", bytes, allocs, findRate, teardown);
+		if (hits != lookups)
+			printf("  error: arena AVL missed %zu keys\n", lookups - hits);
+	}
+
+	/* POINTER NODES */
+	{
+		size_t bytes0 = heapBytes, allocs0 = heapAllocs;
+		set<string>* tree = new set<string>();
+		for (const string& k : keys)
+			tree->insert(k);
+		double bytes = (double) (heapBytes - bytes0) / n;
+		double allocs = (double) (heapAllocs - allocs0) / n;
+
+		size_t hits = 0;
+		auto t = chrono::steady_clock::now();
+		for (const string& k : probes)
+			hits += tree->find(k) != tree->end();
+		double findRate = lookups / secondsSince(t);
+
+		t = chrono::steady_clock::now();
+		delete tree;
+		double teardown = secondsSince(t) * 1e3;
+		printf("%-14s %12.1f %12.3f %14.0f %12.2f\n", "pointer nodes", bytes, allocs, findRate, teardown);
+		if (hits != lookups)
+			printf("  error: pointer tree missed %zu keys\n", lookups - hits);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+	size_t lookups = argc > 2 ? strtoull(argv[2], NULL, 10) : 2000000;
+	printf("keys = %zu, lookups = %zu\n", n, lookups);
+
+	for (bool shared : {false, true})
+	{
+		mt19937_64 rng(42);
+		vector<string> keys = makeKeys(n, rng, shared);
+		vector<string> probes;
+		probes.reserve(lookups);
+		for (size_t i = 0; i < lookups; i++)
+			probes.push_back(keys[rng() % n]);
+		run(keys, probes, shared ? "keys sharing a 25-byte prefix" : "keys with varied first 8 bytes");
+	}
+	return 0;
+}
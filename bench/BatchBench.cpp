@@ -0,0 +1,110 @@
+/*
+	Benchmark for the batched AVL queries. Answers a batch of point lookups and a batch of range
+	counts one call at a time with find() and range(), then with findBatch() and rangeBatch() at
+	increasing thread counts, for 64-bit keys and URL-like string keys.
+
+	Build :  g++ -O2 -std=c++20 -pthread BatchBench.cpp -o batch_bench
+	Usage :  ./batch_bench [tree keys] [queries per batch] [max threads]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../avl/AVL.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+// Times single and batched queries over one tree.
+// Input: Vector - Keys to insert, Vector - Lookup keys, Vector - Range pairs, Unsigned - Maximum threads, String - Label
+// Output: None
+template <class Key>
+static void run(const vector<Key>& keys, const vector<Key>& lookups, const vector<pair<Key, Key>>& ranges, unsigned maxThreads, const char* label)
+{
+	AVL<Key> tree(keys.begin(), keys.end());
+	printf("\n%s: %d keys, %zu lookups, %zu ranges\n", label, tree.size(), lookups.size(), ranges.size());
+	printf("%-22s %8s %14s %14s\n", "method", "threads", "finds/sec", "ranges/sec");
+
+	long hits = 0, counted = 0;
+	auto t = chrono::steady_clock::now();
+	for (const Key& k : lookups)
+		hits += tree.find(k) != NULL;
+	double findRate = lookups.size() / secondsSince(t);
+	t = chrono::steady_clock::now();
+	for (const pair<Key, Key>& r : ranges)
+		counted += tree.range(r.first, r.second);
+	double rangeRate = ranges.size() / secondsSince(t);
+	printf("%-22s %8u %14.0f %14.0f\n", "find/range per query", 1u, findRate, rangeRate);
+
+	for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		t = chrono::steady_clock::now();
+		vector<NodeId> found = tree.findBatch(lookups.begin(), lookups.end(), threads);
+		findRate = lookups.size() / secondsSince(t);
+		t = chrono::steady_clock::now();
+		vector<int> counts = tree.rangeBatch(ranges.begin(), ranges.end(), threads);
+		rangeRate = ranges.size() / secondsSince(t);
+		printf("%-22s %8u %14.0f %14.0f\n", "findBatch/rangeBatch", threads, findRate, rangeRate);
+
+		long batchHits = 0, batchCounted = 0;
+		for (NodeId n : found)
+			batchHits += n != NIL;
+		for (int c : counts)
+			batchCounted += c;
+		if (batchHits != hits || batchCounted != counted)
+			printf("  error: batched results differ (%ld/%ld hits, %ld/%ld counted)\n", batchHits, hits, batchCounted, counted);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 4000000;
+	size_t q = argc > 2 ? strtoull(argv[2], NULL, 10) : 1000000;
+	unsigned maxThreads = argc > 3 ? strtoul(argv[3], NULL, 10) : thread::hardware_concurrency();
+	if (maxThreads == 0)
+		maxThreads = 1;
+
+	mt19937_64 rng(5);
+	{
+		vector<uint64_t> keys(n), lookups(q);
+		vector<pair<uint64_t, uint64_t>> ranges(q);
+		for (uint64_t& k : keys)
+			k = rng() % (4 * n);
+		for (uint64_t& k : lookups)
+			k = rng() % (4 * n);
+		for (pair<uint64_t, uint64_t>& r : ranges)
+		{
+			r.first = rng() % (4 * n);
+			r.second = r.first + rng() % 1000;
+		}
+		run(keys, lookups, ranges, maxThreads, "uint64_t keys");
+	}
+	{
+		auto url = [&]() { return to_string(rng() % (4 * n)) + ".example.com/item"; };
+		vector<string> keys(n / 4), lookups(q / 4);
+		vector<pair<string, string>> ranges(q / 4);
+		for (string& k : keys)
+			k = url();
+		for (string& k : lookups)
+			k = url();
+		for (pair<string, string>& r : ranges)
+		{
+			r.first = url();
+			r.second = r.first + "~";
+		}
+		run(keys, lookups, ranges, maxThreads, "string keys");
+	}
+	return 0;
+}
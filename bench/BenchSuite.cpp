@@ -0,0 +1,481 @@
+/*
+	Benchmark suite covering the structures. Every case is one operation (insert, find, range,
+	sort, radixsort, parallelsort, print) on one structure (AVL, LinkedList or
+	UnrolledLinkedList) at one size, with keys drawn from one of four distributions:
+	  - sequential: 0, 1, 2, ... in order,
+	  - random: uniform 64-bit keys,
+	  - zipf: keys drawn with a Zipfian skew (theta 0.99, as in YCSB), so a few keys are hot and
+	    inserts repeat them,
+	  - sorted: the random keys, but delivered in increasing order. This is the adversarial
+	    case: every insert lands on the rightmost spine of the tree, and the lists, which insert
+	    at the head, end up in reverse order for sort().
+	Finds and ranges probe keys picked uniformly from the inserted stream, so they are always
+	present and follow the skew of zipf; ranges span about 100 keys.
+
+	Each case runs in a forked child, so the peak RSS reported for it is its own and nothing
+	one case allocates can slow down the next. Per-operation latencies are sampled (up to 2^20
+	operations are timed individually, spread evenly over the run, with the clock's own cost
+	subtracted) and reported as percentiles; sort and print are single bulk operations and only
+	report their mean cost per element. LinkedList finds are linear scans, so they are cut down
+	to a budget of node visits and say so. The sorts exist only for the lists (the tree is
+	always sorted; the unrolled list has sort() alone); each is checked by streaming the sorted
+	list through print() and comparing the count and sum of what comes out with the keys that
+	went in.
+
+	The results are written as one JSON document with one record per case, so runs can be
+	compared with each other. Progress goes to stderr. The exit status is nonzero if any case
+	failed its own check of the results.
+
+	Build :  cmake --build <build dir> --target ds_bench   (see ../CMakeLists.txt)
+	Usage :  ./ds_bench [--smoke] [--sizes 1000,10000,...] [--queries N] [--structures avl,list,unrolled]
+	                    [--ops insert,find,range,sort,radixsort,parallelsort,print] [--dists sequential,random,zipf,sorted] [--out file]
+	         (sizes default to 1K through 100M; --smoke runs 1K and 10K with 1000 queries)
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../avl/AVL.h"
+#include "../common/Stats.h"
+#include "../linkedlist/LinkedList.h"
+#include "../linkedlist/UnrolledLinkedList.h"
+#include "ListCheck.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+const size_t MAX_SAMPLES = 1 << 20; // Operations timed individually per case
+const double LIST_VISIT_BUDGET = 2e8; // Node visits allowed for one case of list finds
+
+static volatile uint64_t sink; // Results are folded in here so no timed work can be optimized away
+
+// Scrambles an index into a well-spread 64-bit key.
+static uint64_t scramble(uint64_t i)
+{
+	uint64_t z = (i + 1) * 0x9e3779b97f4a7c15ULL;
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+// Draws ranks in [0, n) with a Zipfian skew, using the method of Gray et al. ("Quickly
+// Generating Billion-Record Synthetic Databases") that YCSB uses.
+class Zipf
+{
+	private:
+		double n, theta, alpha, zetan, eta;
+		mt19937_64 rng;
+
+	public:
+		Zipf(uint64_t items, uint64_t seed, double th = 0.99) : n((double) items), theta(th), rng(seed)
+		{
+			zetan = 0;
+			for (uint64_t i = 1; i <= items; i++)
+				zetan += 1.0 / pow((double) i, theta);
+			alpha = 1.0 / (1.0 - theta);
+			double zeta2 = 1.0 + pow(0.5, theta);
+			eta = (1.0 - pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta2 / zetan);
+		}
+
+		uint64_t next()
+		{
+			double u = uniform_real_distribution<double>(0.0, 1.0)(rng);
+			double uz = u * zetan;
+			if (uz < 1.0)
+				return 0;
+			if (uz < 1.0 + pow(0.5, theta))
+				return 1;
+			return min((uint64_t) (n * pow(eta * u - eta + 1.0, alpha)), (uint64_t) n - 1);
+		}
+};
+
+// Stream buffer that throws away what is written to it, for timing print() on its own.
+class NullBuffer : public streambuf
+{
+	protected:
+		int overflow(int c) override { return c; }
+		streamsize xsputn(const char*, streamsize n) override { sink = sink + n; return n; }
+};
+
+// Generates the keys of a case in insertion order.
+// Input: String - Distribution, Size - Number of keys
+// Output: Vector - Keys, with repeats for zipf
+static vector<uint64_t> makeKeys(const string& dist, size_t n)
+{
+	vector<uint64_t> keys(n);
+	if (dist == "sequential")
+		for (size_t i = 0; i < n; i++)
+			keys[i] = i;
+	else if (dist == "zipf")
+	{
+		Zipf z(n, 1);
+		for (size_t i = 0; i < n; i++)
+			keys[i] = scramble(z.next());
+	}
+	else
+	{
+		for (size_t i = 0; i < n; i++)
+			keys[i] = scramble(i);
+		if (dist == "sorted")
+			sort(keys.begin(), keys.end());
+	}
+	return keys;
+}
+
+// Picks the keys that finds and ranges probe, uniformly from the inserted stream. For zipf the
+// stream repeats hot keys, so the probes follow the same skew.
+// Input: Vector - Keys of the case, in insertion order, Size - Number of probes
+// Output: Vector - Probe keys
+static vector<uint64_t> makeProbes(const vector<uint64_t>& keys, size_t q)
+{
+	vector<uint64_t> probes(q);
+	mt19937_64 rng(2);
+	for (uint64_t& p : probes)
+		p = keys[rng() % keys.size()];
+	return probes;
+}
+
+// Latency profile of a timed run
+struct Timing
+{
+	size_t ops = 0; // Operations run
+	double seconds = 0; // Wall time of the whole run
+	vector<double> samples; // Individually timed operations, in nanoseconds
+};
+
+// Returns the median cost of reading the clock twice, which is subtracted from every sample.
+static double clockOverhead()
+{
+	vector<double> t(1001);
+	for (double& x : t)
+	{
+		auto a = Clock::now();
+		auto b = Clock::now();
+		x = chrono::duration<double, nano>(b - a).count();
+	}
+	nth_element(t.begin(), t.begin() + t.size() / 2, t.end());
+	return t[t.size() / 2];
+}
+
+// Runs an operation a number of times, timing the whole run and an evenly spread sample of
+// single operations.
+// Input: Size - Number of operations, Function - Runs operation i
+// Output: Timing - Wall time and samples
+template <class Op>
+static Timing timeOps(size_t count, Op op)
+{
+	Timing t;
+	t.ops = count;
+	size_t stride = max<size_t>(1, count / MAX_SAMPLES);
+	t.samples.reserve(count / stride + 1);
+	double overhead = clockOverhead();
+	size_t countdown = 0;
+	auto start = Clock::now();
+	for (size_t i = 0; i < count; i++)
+	{
+		if (countdown-- == 0)
+		{
+			countdown = stride - 1;
+			auto a = Clock::now();
+			op(i);
+			auto b = Clock::now();
+			t.samples.push_back(max(0.0, chrono::duration<double, nano>(b - a).count() - overhead));
+		}
+		else
+			op(i);
+	}
+	t.seconds = chrono::duration<double>(Clock::now() - start).count();
+	return t;
+}
+
+// Times a single bulk operation that processes a number of elements.
+// Input: Size - Elements processed, Function - The operation
+// Output: Timing - Wall time, with no samples
+template <class Op>
+static Timing timeBulk(size_t elements, Op op)
+{
+	Timing t;
+	t.ops = elements;
+	auto start = Clock::now();
+	op();
+	t.seconds = chrono::duration<double>(Clock::now() - start).count();
+	return t;
+}
+
+// Returns the peak resident set size of this process in kilobytes.
+static long peakRssKb()
+{
+	struct rusage u;
+	getrusage(RUSAGE_SELF, &u);
+	return u.ru_maxrss;
+}
+
+// Runs one case on a linked list, plain or unrolled. Both are filled by inserting at the head
+// and share find, sort and print; only LinkedList has the radix and parallel sorts.
+// Input: List - Empty list, String - Operation, Vectors - Keys and probes, Size - Number of queries
+// Output: Timing and error and note strings of the case, through the references
+template <class List>
+static void runList(List& list, const string& op, const vector<uint64_t>& keys, const vector<uint64_t>& probes, size_t q, Timing& t, string& error, string& note)
+{
+	size_t n = keys.size();
+	if (op == "insert")
+		t = timeOps(n, [&](size_t i) { list.insert((int) keys[i]); });
+	else
+	{
+		for (uint64_t k : keys)
+			list.insert((int) k);
+		if (op == "find")
+		{
+			size_t limit = max<size_t>(1, min<size_t>(q, (size_t) (LIST_VISIT_BUDGET / max<size_t>(n, 1))));
+			if (limit < q)
+				note = "queries cut to " + to_string(limit) + " (linear scans)";
+			size_t hits = 0;
+			t = timeOps(limit, [&](size_t i) { hits += list.find((int) probes[i]) != NULL; });
+			if (hits != limit)
+				error = "found " + to_string(hits) + " of " + to_string(limit) + " present keys";
+		}
+		else if (op == "sort" || op == "radixsort" || op == "parallelsort")
+		{
+			if (op == "sort")
+				t = timeBulk(n, [&]() { list.sort(); });
+			else if constexpr (is_same_v<List, LinkedList>)
+			{
+				if (op == "radixsort")
+					t = timeBulk(n, [&]() { list.radixSort(); });
+				else
+					t = timeBulk(n, [&]() { list.sortParallel(); });
+			}
+			uint64_t sum = 0;
+			for (uint64_t k : keys)
+				sum += (uint64_t) (long long) (int) k;
+			ListCheck check;
+			ostream out(&check);
+			list.print(out);
+			check.finish();
+			if (!check.sorted || check.seen != n || check.sum != sum)
+				error = "list is not sorted";
+		}
+		else if (op == "print")
+		{
+			NullBuffer buf;
+			ostream out(&buf);
+			t = timeBulk(n, [&]() { list.print(out); });
+		}
+		else
+			note = "not supported";
+	}
+}
+
+// Runs one case and formats its record. Called in the forked child.
+// Input: Strings - Structure, operation and distribution, Size - Number of keys, Size - Number of queries
+// Output: String - JSON record of the case
+static string runCase(const string& structure, const string& op, const string& dist, size_t n, size_t q)
+{
+	vector<uint64_t> keys = makeKeys(dist, n);
+	vector<uint64_t> probes = (op == "find" || op == "range") ? makeProbes(keys, q) : vector<uint64_t>();
+	Timing t;
+	string error, note;
+
+	if (structure == "avl")
+	{
+		AVL<uint64_t> tree;
+		if (op == "insert")
+		{
+			t = timeOps(n, [&](size_t i) { tree.insert(keys[i]); });
+			vector<uint64_t> distinct = keys;
+			sort(distinct.begin(), distinct.end());
+			if (tree.size() != unique(distinct.begin(), distinct.end()) - distinct.begin())
+				error = "tree holds " + to_string(tree.size()) + " keys";
+		}
+		else
+		{
+			for (uint64_t k : keys)
+				tree.insert(k);
+			if (op == "find")
+			{
+				size_t hits = 0;
+				t = timeOps(q, [&](size_t i) { hits += tree.find(probes[i]) != NULL; });
+				if (hits != q)
+					error = "found " + to_string(hits) + " of " + to_string(q) + " present keys";
+			}
+			else if (op == "range")
+			{
+				uint64_t width = (dist == "sequential") ? 100 : ~uint64_t(0) / max<size_t>(n, 1) * 100;
+				uint64_t counted = 0;
+				t = timeOps(q, [&](size_t i) { counted += tree.range(probes[i], probes[i] + min(width, ~probes[i])); });
+				if (counted < q)
+					error = "ranges counted " + to_string(counted) + " keys";
+				sink = sink + counted;
+			}
+			else if (op == "print")
+			{
+				size_t bytes = 0;
+				t = timeBulk(tree.size(), [&]() { tree.dump([&](string_view s) { bytes += s.size(); }); });
+				if (bytes == 0)
+					error = "dump wrote nothing";
+				sink = sink + bytes;
+			}
+			else
+				note = "not supported";
+		}
+	}
+	else if (structure == "unrolled")
+	{
+		UnrolledLinkedList list;
+		runList(list, op, keys, probes, q, t, error, note);
+	}
+	else
+	{
+		LinkedList list;
+		runList(list, op, keys, probes, q, t, error, note);
+	}
+
+	ostringstream rec;
+	rec.precision(6);
+	rec << "{\"structure\": \"" << structure << "\", \"op\": \"" << op << "\", \"dist\": \"" << dist << "\", \"n\": " << n;
+	if (t.ops > 0)
+	{
+		rec << ", \"ops\": " << t.ops << ", \"seconds\": " << t.seconds << ", \"opsPerSec\": " << t.ops / t.seconds
+			<< ", \"nsPerOp\": {\"mean\": " << t.seconds * 1e9 / t.ops;
+		if (!t.samples.empty())
+		{
+			sort(t.samples.begin(), t.samples.end());
+			auto pct = [&](double p) { return t.samples[min(t.samples.size() - 1, (size_t) (p * t.samples.size()))]; };
+			rec << ", \"p50\": " << pct(0.50) << ", \"p90\": " << pct(0.90) << ", \"p99\": " << pct(0.99) << ", \"p999\": " << pct(0.999);
+		}
+		rec << "}";
+	}
+	rec << ", \"peakRssKb\": " << peakRssKb();
+	if (!note.empty())
+		rec << ", \"note\": \"" << note << "\"";
+	if (!error.empty())
+		rec << ", \"error\": \"" << error << "\"";
+	rec << "}";
+	return rec.str();
+}
+
+// Splits a comma-separated list.
+static vector<string> splitList(const string& s)
+{
+	vector<string> out;
+	stringstream in(s);
+	for (string item; getline(in, item, ','); )
+		if (!item.empty())
+			out.push_back(item);
+	return out;
+}
+
+int main(int argc, char** argv)
+{
+	vector<size_t> sizes = {1000, 10000, 100000, 1000000, 10000000, 100000000};
+	size_t q = 1000000;
+	vector<string> structures = {"avl", "list", "unrolled"};
+	vector<string> ops = {"insert", "find", "range", "sort", "radixsort", "parallelsort", "print"};
+	vector<string> dists = {"sequential", "random", "zipf", "sorted"};
+	string outPath;
+	for (int i = 1; i < argc; i++)
+	{
+		string a = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (a == "--smoke")
+		{
+			sizes = {1000, 10000};
+			q = 1000;
+		}
+		else if (a == "--sizes" && hasValue)
+		{
+			sizes.clear();
+			for (const string& s : splitList(argv[++i]))
+				sizes.push_back(strtoull(s.c_str(), NULL, 10));
+		}
+		else if (a == "--queries" && hasValue)
+			q = strtoull(argv[++i], NULL, 10);
+		else if (a == "--structures" && hasValue)
+			structures = splitList(argv[++i]);
+		else if (a == "--ops" && hasValue)
+			ops = splitList(argv[++i]);
+		else if (a == "--dists" && hasValue)
+			dists = splitList(argv[++i]);
+		else if (a == "--out" && hasValue)
+			outPath = argv[++i];
+		else
+		{
+			fprintf(stderr, "usage: %s [--smoke] [--sizes a,b,...] [--queries N] [--structures ...] [--ops ...] [--dists ...] [--out file]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	FILE* out = outPath.empty() ? stdout : fopen(outPath.c_str(), "w");
+	if (out == NULL)
+	{
+		perror(outPath.c_str());
+		return 2;
+	}
+	fprintf(out, "{\"suite\": \"ds-cpp\", \"compiler\": \"%s\", \"stats\": %s, \"queries\": %zu, \"results\": [", __VERSION__, STATS_ENABLED ? "true" : "false", q);
+	fflush(out);
+
+	int failures = 0;
+	bool first = true;
+	for (size_t n : sizes)
+		for (const string& structure : structures)
+			for (const string& op : ops)
+				for (const string& dist : dists)
+				{
+					if (structure == "avl" && op.ends_with("sort")) // The tree is always sorted
+						continue;
+					if (structure != "avl" && op == "range") // The lists have no range queries
+						continue;
+					if (structure == "unrolled" && (op == "radixsort" || op == "parallelsort"))
+						continue;
+					fprintf(stderr, "%-8s %-12s %-11s %10zu ... ", structure.c_str(), op.c_str(), dist.c_str(), n);
+					int fds[2];
+					if (pipe(fds) != 0)
+					{
+						perror("pipe");
+						return 2;
+					}
+					pid_t pid = fork();
+					if (pid == 0)
+					{
+						close(fds[0]);
+						string rec = runCase(structure, op, dist, n, q);
+						if (write(fds[1], rec.data(), rec.size()) != (ssize_t) rec.size())
+							_exit(3);
+						_exit(rec.find("\"error\"") == string::npos ? 0 : 1);
+					}
+					close(fds[1]);
+					string rec;
+					char buf[4096];
+					for (ssize_t got; (got = read(fds[0], buf, sizeof(buf))) > 0; )
+						rec.append(buf, got);
+					close(fds[0]);
+					int status = 0;
+					waitpid(pid, &status, 0);
+					bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+					if (rec.empty()) // The child died before reporting, e.g. out of memory
+						rec = "{\"structure\": \"" + structure + "\", \"op\": \"" + op + "\", \"dist\": \"" + dist + "\", \"n\": " + to_string(n) + ", \"error\": \"case exited with status " + to_string(status) + "\"}";
+					failures += !ok;
+					fprintf(stderr, "%s\n", ok ? "ok" : "error");
+					fprintf(out, "%s\n  %s", first ? "" : ",", rec.c_str());
+					fflush(out);
+					first = false;
+				}
+	fprintf(out, "\n]}\n");
+	if (out != stdout)
+		fclose(out);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+/*
+	Stress test and throughput benchmark for ConcurrentAVL.
+
+	The stress phase runs writer threads that insert interleaved key stripes (plus a shared
+	stripe they all race on) while reader threads check that every key a writer has published
+	is found and that keys nobody inserts are never found. Afterwards it checks the tree's
+	invariants, size and range counts. Any failure makes the program exit with status 1.
+
+	The throughput phase prefills a tree and runs a mixed workload (lookups, range counts and
+	inserts) from 1 up to N threads, comparing ConcurrentAVL with an AVL behind one mutex.
+
+	Build :  g++ -O2 -std=c++20 -pthread ConcurrentBench.cpp -o concurrent_bench
+	Usage :  ./concurrent_bench [max threads] [prefill keys] [write percent] [milliseconds per run]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../avl/AVL.h"
+#include "../avl/ConcurrentAVL.h"
+#include "MixedWorkload.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/* STRESS TEST */
+// Runs concurrent writers and validating readers, then checks the final tree.
+// Input: Unsigned - Writer threads, Unsigned - Reader threads, Int - Keys per writer
+// Output: Bool - True if no violation was observed
+static bool stress(unsigned writers, unsigned readers, int perWriter)
+{
+	ConcurrentAVL<uint64_t> tree;
+	vector<atomic<int>> published(writers); // Number of keys each writer has finished inserting
+	for (atomic<int>& p : published)
+		p.store(0);
+	atomic<bool> done(false);
+	atomic<long> violations(0);
+	int expected = perWriter * writers + perWriter;
+
+	// Writer w owns keys 4 * (i * writers + w) and also races on the shared keys 4 * i + 2.
+	// Keys that are 1 or 3 mod 4 are never inserted.
+	vector<thread> threads;
+	for (unsigned w = 0; w < writers; w++)
+		threads.emplace_back([&, w]() {
+			for (int i = 0; i < perWriter; i++)
+			{
+				if (!tree.insert(4 * ((uint64_t) i * writers + w)))
+					violations++; // Stripes are disjoint, so this key cannot already be there
+				tree.insert(4 * (uint64_t) i + 2);
+				published[w].store(i + 1, memory_order_release);
+			}
+		});
+	for (unsigned r = 0; r < readers; r++)
+		threads.emplace_back([&, r]() {
+			mt19937_64 rng(r + 1);
+			while (!done.load(memory_order_acquire))
+			{
+				unsigned w = rng() % writers;
+				int count = published[w].load(memory_order_acquire);
+				if (count > 0)
+				{
+					uint64_t k = 4 * ((rng() % count) * writers + w);
+					if (!tree.contains(k))
+						violations++;
+				}
+				if (tree.contains(4 * (rng() % (perWriter * (uint64_t) writers)) + 1 + 2 * (rng() % 2)))
+					violations++;
+				int counted = tree.range(0, ~(uint64_t) 0); // Counts may lag behind, but never exceed what is inserted
+				if (counted < 0 || counted > expected)
+					violations++;
+			}
+		});
+	for (unsigned w = 0; w < writers; w++)
+		threads[w].join();
+	done.store(true);
+	for (size_t i = writers; i < threads.size(); i++)
+		threads[i].join();
+
+	bool ok = violations.load() == 0 && tree.checkInvariants() && tree.size() == expected;
+	for (uint64_t i = 0; ok && i < (uint64_t) perWriter * writers; i++)
+		ok = tree.contains(4 * i) && (i >= (uint64_t) perWriter || tree.contains(4 * i + 2));
+	ok = ok && tree.range(0, 4 * (uint64_t) perWriter) == 2 * perWriter + 1;
+	printf("stress: %u writers, %u readers, %d keys/writer: %s (%ld violations)\n", writers, readers, perWriter,
+		ok ? "ok" : "FAILED", violations.load());
+	return ok;
+}
+
+/* THROUGHPUT */
+// AVL behind one mutex, with the insert/contains/range interface of ConcurrentAVL.
+struct LockedAVL
+{
+	AVL<uint64_t> tree;
+	mutex lock;
+
+	bool insert(uint64_t k) { lock_guard<mutex> g(lock); int before = tree.size(); tree.insert(k); return tree.size() != before; }
+	bool contains(uint64_t k) { lock_guard<mutex> g(lock); return tree.find(k) != NULL; }
+	int range(uint64_t a, uint64_t b) { lock_guard<mutex> g(lock); return tree.range(a, b); }
+};
+
+int main(int argc, char** argv)
+{
+	unsigned maxThreads = argc > 1 ? strtoul(argv[1], NULL, 10) : thread::hardware_concurrency();
+	size_t prefill = argc > 2 ? strtoull(argv[2], NULL, 10) : 1000000;
+	int writePercent = argc > 3 ? atoi(argv[3]) : 10;
+	int millis = argc > 4 ? atoi(argv[4]) : 1000;
+	if (maxThreads == 0)
+		maxThreads = 1;
+
+	bool ok = stress(2, 2, 20000);
+	ok = stress(max(2u, maxThreads), max(2u, maxThreads), 20000) && ok;
+
+	uint64_t keySpace = 4 * prefill;
+	// Inserts, then range counts over a thousandth of the key space for a fifth of the reads, then lookups
+	auto mix = [writePercent, keySpace](auto& tree, int dice, uint64_t k) -> uint64_t {
+		if (dice < writePercent)
+			return tree.insert(k);
+		if (dice < writePercent + (100 - writePercent) / 5)
+			return tree.range(k, k + keySpace / 1000);
+		return tree.contains(k);
+	};
+	printf("\nprefill = %zu, writes = %d%%, %d ms per run\n", prefill, writePercent, millis);
+	compareScaling<ConcurrentAVL<uint64_t>, LockedAVL>(maxThreads, prefill, keySpace, millis, mix, "ConcurrentAVL", "locked AVL");
+	return ok ? 0 : 1;
+}
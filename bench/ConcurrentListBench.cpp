@@ -0,0 +1,177 @@
+/*
+	Stress test and throughput benchmark for ConcurrentLinkedList.
+
+	The stress phases check the outcomes every linearizable history must produce:
+	  - owners: each thread inserts, removes and finds values from a stripe of its own, and
+	    every result must match the thread's private count of those values, since nobody else
+	    touches them. All threads also look for values inserted up front and never removed,
+	    which must always be found however the list changes around them, and for values nobody
+	    inserts, which must never be found. Afterwards the list must hold exactly the values
+	    the counts say.
+	  - race: every thread tries to remove every one of a set of values, each in its own order.
+	    Each value must be removed by exactly one thread, and the list must end up empty.
+	Any failure makes the program exit with status 1. Build with -fsanitize=address (or thread)
+	to also check that no removed node is freed while another thread can still reach it.
+
+	The throughput phase prefills a list and runs a mixed workload (finds, and inserts and
+	removes in equal numbers) from 1 up to N threads, comparing ConcurrentLinkedList with a
+	LinkedList behind one mutex.
+
+	Build :  g++ -O2 -std=c++20 -pthread ConcurrentListBench.cpp ../linkedlist/LinkedList.cpp ../linkedlist/ConcurrentLinkedList.cpp -o concurrent_list_bench
+	Usage :  ./concurrent_list_bench [max threads] [prefill values] [write percent] [milliseconds per run]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../linkedlist/ConcurrentLinkedList.h"
+#include "../linkedlist/LinkedList.h"
+#include "MixedWorkload.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/* STRESS TEST */
+// Runs threads on disjoint stripes of values next to a set of values that never change, then
+// checks the final list against the threads' own counts.
+// Input: Unsigned - Threads, Int - Values per stripe, Int - Operations per thread
+// Output: Bool - True if no violation was observed
+static bool stressOwners(unsigned threads, int stripe, int ops)
+{
+	ConcurrentLinkedList list;
+	const int fixed = 64; // Values -1 to -fixed are present throughout
+	for (int i = 1; i <= fixed; i++)
+		list.insert(-i);
+	vector<vector<int>> counts(threads, vector<int>(stripe, 0)); // counts[t][i]: copies of value i * threads + t in the list
+	atomic<long> violations(0);
+
+	vector<thread> pool;
+	for (unsigned t = 0; t < threads; t++)
+		pool.emplace_back([&, t]() {
+			mt19937 rng(t + 1);
+			vector<int>& mine = counts[t];
+			for (int op = 0; op < ops; op++)
+			{
+				int i = rng() % stripe;
+				int x = i * (int) threads + (int) t;
+				switch (rng() % 4)
+				{
+					case 0:
+						list.insert(x);
+						mine[i]++;
+						break;
+					case 1:
+						if (list.remove(x) != (mine[i] > 0))
+							violations++;
+						mine[i] -= mine[i] > 0;
+						break;
+					case 2:
+						if (list.find(x) != (mine[i] > 0))
+							violations++;
+						break;
+					default:
+						if (!list.find(-1 - (int) (rng() % fixed)))
+							violations++; // Never removed, so always reachable
+						if (list.find(stripe * (int) threads + (int) (rng() % 1000)))
+							violations++; // Never inserted
+				}
+			}
+		});
+	for (thread& th : pool)
+		th.join();
+
+	long expected = fixed;
+	bool ok = violations.load() == 0;
+	for (unsigned t = 0; t < threads; t++)
+		for (int i = 0; i < stripe; i++)
+		{
+			expected += counts[t][i];
+			ok = ok && list.find(i * (int) threads + (int) t) == (counts[t][i] > 0);
+		}
+	ok = ok && list.length() == expected;
+	printf("stress (owners): %u threads, %d ops each: %s (%ld violations)\n", threads, ops, ok ? "ok" : "FAILED", violations.load());
+	return ok;
+}
+
+// Has every thread try to remove every value of a set, each in its own order.
+// Input: Unsigned - Threads, Int - Values
+// Output: Bool - True if each value was removed exactly once
+static bool stressRace(unsigned threads, int values)
+{
+	ConcurrentLinkedList list;
+	for (int x = 0; x < values; x++)
+		list.insert(x);
+	vector<atomic<int>> removed(values);
+	for (atomic<int>& r : removed)
+		r.store(0);
+
+	vector<thread> pool;
+	for (unsigned t = 0; t < threads; t++)
+		pool.emplace_back([&, t]() {
+			vector<int> order(values);
+			for (int x = 0; x < values; x++)
+				order[x] = x;
+			shuffle(order.begin(), order.end(), mt19937(t + 1));
+			for (int x : order)
+				if (list.remove(x))
+					removed[x]++;
+		});
+	for (thread& th : pool)
+		th.join();
+
+	int wrong = 0;
+	for (atomic<int>& r : removed)
+		wrong += r.load() != 1;
+	bool ok = wrong == 0 && list.length() == 0 && list.print().empty();
+	printf("stress (race): %u threads, %d values: %s (%d values not removed exactly once)\n", threads, values, ok ? "ok" : "FAILED", wrong);
+	return ok;
+}
+
+/* THROUGHPUT */
+// LinkedList behind one mutex, answering find() with a bool as ConcurrentLinkedList does.
+struct LockedList
+{
+	LinkedList list;
+	mutex lock;
+
+	void insert(int x) { lock_guard<mutex> g(lock); list.insert(x); }
+	bool remove(int x) { lock_guard<mutex> g(lock); return list.remove(x); }
+	bool find(int x) { lock_guard<mutex> g(lock); return list.find(x) != NULL; }
+};
+
+int main(int argc, char** argv)
+{
+	unsigned maxThreads = argc > 1 ? strtoul(argv[1], NULL, 10) : thread::hardware_concurrency();
+	int prefill = argc > 2 ? atoi(argv[2]) : 1000;
+	int writePercent = argc > 3 ? atoi(argv[3]) : 10;
+	int millis = argc > 4 ? atoi(argv[4]) : 500;
+	if (maxThreads == 0)
+		maxThreads = 1;
+
+	bool ok = stressOwners(2, 200, 100000);
+	ok = stressOwners(max(4u, maxThreads), 200, 50000) && ok;
+	ok = stressRace(max(4u, maxThreads), 5000) && ok;
+
+	int space = 2 * max(prefill, 1);
+	// Inserts and removes in equal numbers, then lookups
+	auto mix = [writePercent](auto& list, int dice, uint64_t k) -> uint64_t {
+		int x = (int) k;
+		if (dice < writePercent / 2)
+		{
+			list.insert(x);
+			return 0;
+		}
+		if (dice < writePercent)
+			return list.remove(x);
+		return list.find(x);
+	};
+	printf("\nprefill = %d, updates = %d%%, %d ms per run\n", prefill, writePercent, millis);
+	compareScaling<ConcurrentLinkedList, LockedList>(maxThreads, prefill, space, millis, mix, "ConcurrentLinkedList", "locked list");
+	return ok ? 0 : 1;
+}
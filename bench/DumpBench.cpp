@@ -0,0 +1,199 @@
+/*
+	Benchmark for the AVL traversal engine. Dumps a tree of random 64-bit keys in each
+	traversal order to an ostream that discards its input, and builds the printPreOrder()
+	string, reporting nodes written per second. Output grows linearly with the tree, so the
+	rates should stay flat as the tree grows. First it checks, on a small tree, every order of
+	traverse() and dump() against a recursive walk (from the root and from nodes inside the
+	tree), that the in-order walk is sorted, and that printPreOrder() still writes the text it
+	always has. A failed check makes the program exit with status 1.
+
+	Build :  g++ -O2 -std=c++20 DumpBench.cpp -o dump_bench
+	Usage :  ./dump_bench [tree sizes...]   (sizes default to 100K, 1M and 10M keys)
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../avl/AVL.h"
+#include <chrono>
+#include <deque>
+#include <cstdio>
+#include <cstdlib>
+#include <ostream>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Stream buffer that counts and drops everything written to it.
+class NullBuffer : public streambuf
+{
+	public:
+		size_t written = 0;
+
+	protected:
+		streamsize xsputn(const char*, streamsize n) override { written += n; return n; }
+		int overflow(int c) override { written++; return c; }
+};
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+typedef AVL<uint64_t>::Order Order;
+
+// Appends the nodes of a subtree to a list in a given order, recursively.
+// Input: AVL - Tree, NodeId - Root of the subtree, Order - Pre, In or Post, Vector reference - List to extend
+// Output: None
+static void reference(AVL<uint64_t>& tree, NodeId n, Order order, vector<NodeId>& out)
+{
+	if (n == NIL)
+		return;
+	if (order == Order::Pre)
+		out.push_back(n);
+	reference(tree, tree.at(n).left, order, out);
+	if (order == Order::In)
+		out.push_back(n);
+	reference(tree, tree.at(n).right, order, out);
+	if (order == Order::Post)
+		out.push_back(n);
+}
+
+// Lists the nodes of a subtree in a given order with the reference walks: recursion, or a queue for level order.
+// Input: AVL - Tree, NodeId - Root of the subtree, Order - Traversal order
+// Output: Vector - Nodes in order
+static vector<NodeId> referenceOrder(AVL<uint64_t>& tree, NodeId start, Order order)
+{
+	vector<NodeId> out;
+	if (order != Order::Level)
+	{
+		reference(tree, start, order, out);
+		return out;
+	}
+	deque<NodeId> queue;
+	if (start != NIL)
+		queue.push_back(start);
+	while (!queue.empty())
+	{
+		NodeId n = queue.front();
+		queue.pop_front();
+		out.push_back(n);
+		if (tree.at(n).left != NIL)
+			queue.push_back(tree.at(n).left);
+		if (tree.at(n).right != NIL)
+			queue.push_back(tree.at(n).right);
+	}
+	return out;
+}
+
+// Formats nodes the way printPreOrder() always has: <KEY>(h = <HEIGHT>, s = <SUBSIZE>), one after another.
+// Input: AVL - Tree, Vector - Nodes to format
+// Output: String - The formatted nodes
+static string referenceText(AVL<uint64_t>& tree, const vector<NodeId>& nodes)
+{
+	string out;
+	for (NodeId n : nodes)
+		out += to_string(tree.at(n).key) + "(h = " + to_string(tree.getHeight(n)) + ", s = " + to_string(tree.getSubsize(n)) + ")";
+	return out;
+}
+
+// Checks traverse(), dump() and printPreOrder() on a tree against the reference walks.
+// Input: AVL - Tree to check, Array - Orders and their names
+// Output: Bool - True if every check passed
+static bool checkOrders(AVL<uint64_t>& tree, const pair<Order, const char*> (&orders)[4])
+{
+	bool ok = true;
+	vector<NodeId> starts = {tree.getRoot()}; // The root, then nodes down its left and right spines
+	for (NodeId n = tree.at(tree.getRoot()).left; n != NIL; n = tree.at(n).left)
+		starts.push_back(n);
+	for (NodeId n = tree.at(tree.getRoot()).right; n != NIL; n = tree.at(n).right)
+		starts.push_back(n);
+	for (NodeId start : starts)
+		for (const pair<Order, const char*>& o : orders)
+		{
+			vector<NodeId> got;
+			tree.traverse(start, o.first, [&](NodeId n) { got.push_back(n); });
+			if (got != referenceOrder(tree, start, o.first))
+			{
+				printf("error: traverse(%s) from node %u differs from the reference walk\n", o.second, start);
+				ok = false;
+			}
+		}
+
+	vector<NodeId> in = referenceOrder(tree, tree.getRoot(), Order::In);
+	for (size_t i = 1; i < in.size(); i++)
+		if (tree.at(in[i - 1]).key >= tree.at(in[i]).key)
+		{
+			printf("error: in-order walk is not sorted\n");
+			ok = false;
+			break;
+		}
+
+	for (const pair<Order, const char*>& o : orders)
+	{
+		string got;
+		tree.dump([&](string_view piece) { got.append(piece); }, o.first);
+		if (got != referenceText(tree, referenceOrder(tree, tree.getRoot(), o.first)))
+		{
+			printf("error: dump(%s) differs from the reference text\n", o.second);
+			ok = false;
+		}
+	}
+	string pre;
+	tree.dump([&](string_view piece) { pre.append(piece); }, Order::Pre);
+	if (tree.printPreOrder() != pre || tree.printPreOrder() != referenceText(tree, referenceOrder(tree, tree.getRoot(), Order::Pre)))
+	{
+		printf("error: printPreOrder() differs from dump(pre) or from its original format\n");
+		ok = false;
+	}
+	NodeId inner = starts.back();
+	if (tree.printPreOrder(inner) != referenceText(tree, referenceOrder(tree, inner, Order::Pre)))
+	{
+		printf("error: printPreOrder() from node %u differs from the reference text\n", inner);
+		ok = false;
+	}
+	return ok;
+}
+
+int main(int argc, char** argv)
+{
+	vector<size_t> sizes;
+	for (int i = 1; i < argc; i++)
+		sizes.push_back(strtoull(argv[i], NULL, 10));
+	if (sizes.empty())
+		sizes = {100000, 1000000, 10000000};
+
+	const pair<Order, const char*> orders[] = {{Order::Pre, "pre"}, {Order::In, "in"}, {Order::Post, "post"}, {Order::Level, "level"}};
+	AVL<uint64_t> small;
+	mt19937_64 keys(5);
+	for (int i = 0; i < 1000; i++)
+		small.insert(keys() % 100000);
+	bool ok = checkOrders(small, orders);
+
+	printf("%12s %-16s %14s %12s\n", "keys", "method", "nodes/sec", "MB written");
+	for (size_t n : sizes)
+	{
+		mt19937_64 rng(23);
+		AVL<uint64_t> tree;
+		for (size_t i = 0; i < n; i++)
+			tree.insert(rng());
+
+		for (const pair<Order, const char*>& o : orders)
+		{
+			NullBuffer buffer;
+			ostream out(&buffer);
+			auto t = chrono::steady_clock::now();
+			tree.dump(out, o.first);
+			double rate = tree.size() / secondsSince(t);
+			printf("%12zu dump %-11s %14.0f %12.1f\n", n, o.second, rate, buffer.written / 1e6);
+		}
+		auto t = chrono::steady_clock::now();
+		string s = tree.printPreOrder();
+		double rate = tree.size() / secondsSince(t);
+		printf("%12zu %-16s %14.0f %12.1f\n", n, "printPreOrder", rate, s.size() / 1e6);
+	}
+	return ok ? 0 : 1;
+}
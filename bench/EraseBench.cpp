@@ -0,0 +1,135 @@
+/*
+	Benchmark for AVL deletion. Times erase() one key at a time against eraseRange() cutting
+	out the same keys in blocks, then runs a tree with a capacity as a sliding window under
+	steady ingest, for 64-bit and string keys, reporting throughput and the memory held. After
+	each step the tree must hold exactly the keys expected (for the window, the newest or oldest
+	keys, depending on the end it evicts from) and pass checkInvariants(); a failed check makes
+	the program exit with status 1.
+
+	Build :  g++ -O2 -std=c++20 EraseBench.cpp -o erase_bench
+	Usage :  ./erase_bench [keys] [window]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../avl/AVL.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+// Checks that a tree holds exactly the given keys and is a valid AVL tree, printing an error if not.
+// Input: AVL - Tree to check, Vector - Expected keys in increasing order, String - Step being checked
+// Output: Bool - True if the tree matched
+template <class Key>
+static bool matches(AVL<Key>& tree, const vector<Key>& expected, const char* step)
+{
+	if (!tree.checkInvariants())
+	{
+		printf("  error: tree breaks the AVL invariants after %s\n", step);
+		return false;
+	}
+	if ((size_t) tree.size() != expected.size() || !equal(tree.begin(), tree.end(), expected.begin()))
+	{
+		printf("  error: tree holds %d keys after %s, not the %zu expected\n", tree.size(), step, expected.size());
+		return false;
+	}
+	return true;
+}
+
+// Times erasing and windowed ingest over one key type, checking what is left after each step.
+// Input: Vector - Distinct keys in increasing order, Size - Window capacity, String - Label
+// Output: Bool - True if every check passed
+template <class Key>
+static bool run(const vector<Key>& keys, size_t window, const char* label)
+{
+	size_t n = keys.size();
+	bool ok = true;
+	printf("\n%s: %zu keys\n", label, n);
+	printf("%-28s %14s %14s\n", "operation", "keys/sec", "MB held");
+
+	AVL<Key> tree(keys.begin(), keys.end());
+	auto t = chrono::steady_clock::now();
+	for (size_t i = 0; i < n; i += 2) // Every other key, so each erase rebalances a full tree
+		tree.erase(keys[i]);
+	printf("%-28s %14.0f %14.1f\n", "erase one at a time", (n / 2) / secondsSince(t), tree.bytesReserved() / 1e6);
+	vector<Key> expected;
+	for (size_t i = 1; i < n; i += 2)
+		expected.push_back(keys[i]);
+	ok = matches(tree, expected, "erase") && ok;
+
+	tree.assign(keys.begin(), keys.end());
+	size_t removed = 0;
+	t = chrono::steady_clock::now();
+	for (size_t i = 0; i + 1000 <= n; i += 2000) // Blocks of 1000 keys, leaving a block between each
+		removed += tree.eraseRange(keys[i], keys[i + 999]);
+	printf("%-28s %14.0f %14.1f\n", "eraseRange, 1000-key blocks", removed / secondsSince(t), tree.bytesReserved() / 1e6);
+	expected.clear();
+	for (size_t i = 0; i < n; i++)
+		if (i % 2000 >= 1000 || i - i % 2000 + 1000 > n) // Outside every erased block
+			expected.push_back(keys[i]);
+	if (removed + expected.size() != n)
+	{
+		printf("  error: eraseRange removed %zu keys, expected %zu\n", removed, n - expected.size());
+		ok = false;
+	}
+	ok = matches(tree, expected, "eraseRange") && ok;
+
+	// Keys arrive in increasing order, so evicting the low end keeps the last keys inserted and
+	// evicting the high end keeps the first.
+	for (typename AVL<Key>::Evict end : {AVL<Key>::Evict::Low, AVL<Key>::Evict::High})
+	{
+		bool low = end == AVL<Key>::Evict::Low;
+		AVL<Key> sliding;
+		sliding.setCapacity((int) window, end);
+		size_t peak = 0;
+		t = chrono::steady_clock::now();
+		for (size_t i = 0; i < n; i++)
+		{
+			sliding.insert(keys[i]);
+			if ((i & 4095) == 0)
+				peak = max(peak, sliding.bytesReserved());
+		}
+		double rate = n / secondsSince(t);
+		printf("%-28s %14.0f %14.1f\n", low ? "insert with capacity, low" : "insert with capacity, high", rate, peak / 1e6);
+		size_t kept = min(n, window);
+		expected.assign(low ? keys.end() - kept : keys.begin(), low ? keys.end() : keys.begin() + kept);
+		ok = matches(sliding, expected, low ? "windowed ingest evicting low" : "windowed ingest evicting high") && ok;
+	}
+	return ok;
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 2000000;
+	size_t window = argc > 2 ? strtoull(argv[2], NULL, 10) : 100000;
+	bool ok = true;
+	printf("window = %zu keys\n", window);
+	{
+		vector<uint64_t> keys(n);
+		for (size_t i = 0; i < n; i++)
+			keys[i] = i * 16;
+		ok = run(keys, window, "uint64_t keys") && ok;
+	}
+	{
+		vector<string> keys(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			char buf[32];
+			snprintf(buf, sizeof(buf), "event/%012zu", i);
+			keys[i] = buf;
+		}
+		ok = run(keys, window, "string keys") && ok;
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+/*
+	Benchmark comparing lookups in a live AVL tree against the FrozenAVL compiled from it by
+	freeze(). For each tree size it times find/contains and range counts on random 64-bit keys
+	(half of the probes present, half absent), plus FrozenAVL::findBatch over the same probes,
+	and reports the memory each structure holds.
+
+	Build :  g++ -O2 -std=c++20 -march=native FrozenBench.cpp -o frozen_bench
+	Usage :  ./frozen_bench [lookups] [tree sizes...]   (sizes default to 1M, 10M and 100M keys)
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../avl/AVL.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+using namespace std;
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+// Scrambles an index into a well-spread key, so keys can be regenerated instead of stored.
+static uint64_t keyOf(uint64_t i)
+{
+	uint64_t z = (i + 1) * 0x9e3779b97f4a7c15ULL;
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+int main(int argc, char** argv)
+{
+	size_t lookups = argc > 1 ? strtoull(argv[1], NULL, 10) : 4000000;
+	vector<size_t> sizes;
+	for (int i = 2; i < argc; i++)
+		sizes.push_back(strtoull(argv[i], NULL, 10));
+	if (sizes.empty())
+		sizes = {1000000, 10000000, 100000000};
+
+	printf("lookups = %zu\n", lookups);
+	printf("%12s %-10s %12s %14s %14s %14s %12s\n", "keys", "structure", "bytes/key", "finds/sec", "batch/sec", "ranges/sec", "build sec");
+	for (size_t n : sizes)
+	{
+		mt19937_64 rng(11);
+		vector<uint64_t> probes(lookups);
+		for (uint64_t& p : probes)
+			p = (rng() & 1) ? keyOf(rng() % n) : rng();
+
+		auto t = chrono::steady_clock::now();
+		AVL<uint64_t> live;
+		for (size_t i = 0; i < n; i++)
+			live.insert(keyOf(i));
+		double liveBuild = secondsSince(t);
+
+		t = chrono::steady_clock::now();
+		FrozenAVL<uint64_t> frozen = live.freeze();
+		double frozenBuild = secondsSince(t);
+
+		long hits = 0, frozenHits = 0, count = 0, frozenCount = 0;
+		t = chrono::steady_clock::now();
+		for (uint64_t p : probes)
+			hits += live.find(p) != NULL;
+		double liveFind = lookups / secondsSince(t);
+		t = chrono::steady_clock::now();
+		for (uint64_t p : probes)
+			frozenHits += frozen.contains(p);
+		double frozenFind = lookups / secondsSince(t);
+		vector<int> found(lookups);
+		t = chrono::steady_clock::now();
+		frozen.findBatch(probes.begin(), probes.end(), found.begin());
+		double frozenBatch = lookups / secondsSince(t);
+		long batchHits = 0;
+		for (int r : found)
+			batchHits += r >= 0;
+
+		uint64_t width = ~uint64_t(0) / n * 64; // About 64 keys per range
+		t = chrono::steady_clock::now();
+		for (uint64_t p : probes)
+			count += live.range(p, p + width);
+		double liveRange = lookups / secondsSince(t);
+		t = chrono::steady_clock::now();
+		for (uint64_t p : probes)
+			frozenCount += frozen.range(p, p + width);
+		double frozenRange = lookups / secondsSince(t);
+
+		printf("%12zu %-10s %12.1f %14.0f %14s %14.0f %12.2f\n", n, "live AVL", (double) live.bytesReserved() / n, liveFind, "-", liveRange, liveBuild);
+		printf("%12zu %-10s %12.1f %14.0f %14.0f %14.0f %12.2f\n", n, "frozen", (double) frozen.bytesReserved() / n, frozenFind, frozenBatch, frozenRange, frozenBuild);
+		if (hits != frozenHits || hits != batchHits || count != frozenCount)
+			printf("  error: frozen index disagrees with the live tree (%ld/%ld hits, %ld/%ld counted)\n", frozenHits, hits, frozenCount, count);
+	}
+	return 0;
+}
@@ -0,0 +1,85 @@
+/*
+	Benchmark for HashedAVL point lookups. For each target load factor of the hash index it
+	fills a HashedAVL and a plain AVL with the same keys, then times find() on both over the
+	same probes (half of them present, half absent), for 64-bit keys and URL-like string keys.
+	The index is sized to a fixed number of slots up front, so the number of keys sets the load.
+
+	Build :  g++ -O2 -std=c++20 HashBench.cpp -o hash_bench
+	Usage :  ./hash_bench [index slots, rounded up to a power of two] [lookups]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../avl/HashedAVL.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+// Times find() on a plain tree and on a hashed one holding the same keys, at several loads.
+// Input: Size - Index slots, Function - Makes the key with a given number, Size - Lookups, String - Label
+// Output: None
+template <class Key, class MakeKey>
+static void run(size_t slots, MakeKey makeKey, size_t lookups, const char* label)
+{
+	printf("\n%s: %zu index slots, %zu lookups\n", label, slots, lookups);
+	printf("%10s %10s %14s %14s %10s %12s\n", "load", "keys", "AVL finds/s", "hashed/s", "speedup", "index MB");
+	for (double load : {0.25, 0.5, 0.75, 0.875})
+	{
+		size_t n = (size_t) (load * slots);
+		vector<Key> keys(n), probes(lookups);
+		for (size_t i = 0; i < n; i++)
+			keys[i] = makeKey(2 * i); // Even numbers are present, odd ones absent
+		mt19937_64 rng(7);
+		for (Key& p : probes)
+			p = makeKey(rng() % (2 * n));
+
+		AVL<Key> plain;
+		HashedAVL<Key> hashed;
+		hashed.reserve(slots - slots / 8);
+		for (const Key& k : keys)
+		{
+			plain.insert(k);
+			hashed.insert(k);
+		}
+
+		long hits = 0, hashedHits = 0;
+		auto t = chrono::steady_clock::now();
+		for (const Key& p : probes)
+			hits += plain.find(p) != NULL;
+		double plainRate = lookups / secondsSince(t);
+		t = chrono::steady_clock::now();
+		for (const Key& p : probes)
+			hashedHits += hashed.find(p) != NULL;
+		double hashedRate = lookups / secondsSince(t);
+
+		size_t indexBytes = hashed.bytesReserved() - plain.bytesReserved();
+		printf("%10.3f %10zu %14.0f %14.0f %9.1fx %12.1f\n", hashed.loadFactor(), n, plainRate, hashedRate, hashedRate / plainRate, indexBytes / 1e6);
+		if (hits != hashedHits)
+			printf("  error: hashed lookups found %ld keys, the tree %ld\n", hashedHits, hits);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	size_t slots = argc > 1 ? strtoull(argv[1], NULL, 10) : (1 << 22);
+	size_t lookups = argc > 2 ? strtoull(argv[2], NULL, 10) : 2000000;
+	size_t c = 16;
+	while (c < slots)
+		c *= 2;
+	slots = c;
+
+	run<uint64_t>(slots, [](uint64_t i) { return i * 0x9e3779b97f4a7c15ULL; }, lookups, "uint64_t keys");
+	run<string>(slots / 4, [](uint64_t i) { return to_string(i * 2654435761ULL % 1000000007ULL) + "-" + to_string(i) + ".example.com/item"; }, lookups / 4, "string keys");
+	return 0;
+}
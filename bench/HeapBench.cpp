@@ -0,0 +1,280 @@
+/*
+	Benchmark comparing DaryHeap with an AVL tree used as a priority queue, the way pending jobs
+	keyed by due time are often kept. Every structure runs the same plan on unique 64-bit keys
+	(a 40-bit priority over a 24-bit job id):
+	  - build: load n keys (DaryHeap heapifies in O(n); the tree bulk-loads them), plus n
+	    single pushes for the heaps;
+	  - decrease: lower the priority of random jobs (decreaseKey by handle for the heaps, erase
+	    and reinsert for the trees);
+	  - hold: pop the first job and push a follow-up due a little later, the steady state of a
+	    scheduler;
+	  - drain: pop everything.
+	The trees run as AVL<uint64_t> and as AVL<string> holding the keys as zero-padded decimal,
+	which is what string-keyed job queues pay. Every structure must pop the same sequence, in
+	order, or the run reports an error.
+
+	Build :  g++ -O2 -std=c++20 HeapBench.cpp -o heap_bench
+	Usage :  ./heap_bench [keys] [decreases] [holds]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../avl/AVL.h"
+#include "../heap/DaryHeap.h"
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+static const int ID_BITS = 24; // Low bits of a key holding the job id, which keeps keys unique
+
+// Random draws shared by every structure, so they all run the same operations
+struct Plan
+{
+	vector<uint64_t> keys; // Initial keys; the job id of keys[i] is i
+	vector<uint32_t> decIds; // Job whose priority each decrease lowers
+	vector<uint64_t> decBy; // Amount each decrease lowers the priority by (at most the priority)
+	vector<uint64_t> holdGaps; // Delay of each follow-up job after the job popped before it
+};
+
+// Outcome of one run
+struct Result
+{
+	double build = 0, pushes = -1, decrease = 0, hold = 0, drain = 0; // Seconds per phase (pushes is -1 where not run)
+	size_t bytes = 0; // Memory held once built
+	uint64_t digest = 0; // Hash of the popped sequence
+	bool ordered = true; // Whether the drain came out in order
+};
+
+// Priority queue over a DaryHeap of arity D. Handles double as job ids, since assign() gives
+// the key at offset i handle i.
+template <unsigned D>
+struct HeapQueue
+{
+	DaryHeap<uint64_t, less<uint64_t>, D> heap;
+
+	void build(const vector<uint64_t>& keys) { heap.assign(keys.begin(), keys.end()); }
+	static const bool PUSHES = true; // Whether to time n single pushes
+	void pushAll(const vector<uint64_t>& keys) { heap.clear(); for (uint64_t k : keys) heap.push(k); }
+	void decrease(uint32_t id, uint64_t, uint64_t k) { heap.decreaseKey(id, k); }
+	uint64_t pop() { return heap.pop(); }
+	void push(uint64_t k) { heap.push(k); }
+	bool empty() { return heap.empty(); }
+	size_t bytes() { return heap.bytesReserved(); }
+	bool consistent() { return heap.isHeap(); }
+};
+
+// Priority queue over an AVL tree, keyed by the integers themselves or by their decimal strings
+template <class Key>
+struct TreeQueue
+{
+	AVL<Key> tree;
+
+	static Key wrap(uint64_t k)
+	{
+		if constexpr (is_same_v<Key, string>)
+		{
+			char buf[21];
+			snprintf(buf, sizeof(buf), "%020llu", (unsigned long long) k);
+			return string(buf, 20);
+		}
+		else
+			return k;
+	}
+	static uint64_t unwrap(typename AVL<Key>::KeyArg k)
+	{
+		if constexpr (is_same_v<Key, string>)
+		{
+			uint64_t x = 0;
+			from_chars(k.data(), k.data() + k.size(), x);
+			return x;
+		}
+		else
+			return k;
+	}
+
+	void build(const vector<uint64_t>& keys)
+	{
+		vector<Key> wrapped;
+		wrapped.reserve(keys.size());
+		for (uint64_t k : keys)
+			wrapped.push_back(wrap(k));
+		tree.assign(wrapped.begin(), wrapped.end());
+	}
+	static const bool PUSHES = false;
+	void pushAll(const vector<uint64_t>&) {}
+	void decrease(uint32_t, uint64_t old, uint64_t k) { tree.erase(wrap(old)); tree.insert(wrap(k)); }
+	uint64_t pop()
+	{
+		Key k = Key(*tree.begin());
+		tree.erase(k);
+		return unwrap(k);
+	}
+	void push(uint64_t k) { tree.insert(wrap(k)); }
+	bool empty() { return tree.size() == 0; }
+	size_t bytes() { return tree.bytesReserved(); }
+	bool consistent() { return true; }
+};
+
+// Runs the plan on one structure.
+// Input: Queue - Structure under test, Plan - Operations to run
+// Output: Result - Timings, memory and what was popped
+template <class Queue>
+static Result run(Queue& q, const Plan& plan)
+{
+	Result r;
+	size_t n = plan.keys.size();
+	auto t = chrono::steady_clock::now();
+	if (Queue::PUSHES)
+	{
+		q.pushAll(plan.keys);
+		r.pushes = secondsSince(t);
+	}
+
+	t = chrono::steady_clock::now();
+	q.build(plan.keys);
+	r.build = secondsSince(t);
+	r.bytes = q.bytes();
+
+	vector<uint64_t> current = plan.keys; // Key of each job, for the trees' erases
+	t = chrono::steady_clock::now();
+	for (size_t i = 0; i < plan.decIds.size(); i++)
+	{
+		uint32_t id = plan.decIds[i];
+		uint64_t k = current[id] - (plan.decBy[i] << ID_BITS);
+		if (k != current[id])
+			q.decrease(id, current[id], k);
+		current[id] = k;
+	}
+	r.decrease = secondsSince(t);
+
+	auto mix = [&r](uint64_t k) { r.digest = (r.digest ^ k) * 0x100000001b3ULL; };
+	t = chrono::steady_clock::now();
+	for (size_t i = 0; i < plan.holdGaps.size() && !q.empty(); i++)
+	{
+		uint64_t k = q.pop();
+		mix(k);
+		uint64_t id = (n + i) & ((uint64_t(1) << ID_BITS) - 1);
+		q.push((((k >> ID_BITS) + plan.holdGaps[i]) << ID_BITS) | id);
+	}
+	r.hold = secondsSince(t);
+	r.ordered = q.consistent();
+
+	uint64_t last = 0;
+	t = chrono::steady_clock::now();
+	while (!q.empty())
+	{
+		uint64_t k = q.pop();
+		r.ordered = r.ordered && k >= last;
+		last = k;
+		mix(k);
+	}
+	r.drain = secondsSince(t);
+	return r;
+}
+
+// Prints one row of the table.
+static void report(const char* name, const Result& r, const Plan& plan)
+{
+	size_t n = plan.keys.size();
+	auto per = [](double s, size_t ops) { return ops == 0 ? 0.0 : s / ops * 1e9; };
+	char pushes[16] = "-";
+	if (r.pushes >= 0)
+		snprintf(pushes, sizeof(pushes), "%.0f", per(r.pushes, n));
+	printf("%-16s %10.0f %10s %10.0f %10.0f %10.0f %8.1f\n", name, per(r.build, n), pushes, per(r.decrease, plan.decIds.size()),
+		per(r.hold, plan.holdGaps.size()), per(r.drain, n), n == 0 ? 0.0 : (double) r.bytes / n);
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+	size_t decreases = argc > 2 ? strtoull(argv[2], NULL, 10) : n;
+	size_t holds = argc > 3 ? strtoull(argv[3], NULL, 10) : n;
+	if (n + holds > (size_t(1) << ID_BITS))
+	{
+		printf("error: keys plus holds must stay below %zu so job ids stay unique\n", size_t(1) << ID_BITS);
+		return 1;
+	}
+
+	Plan plan;
+	mt19937_64 rng(5);
+	const uint64_t PRIORITIES = uint64_t(1) << 32;
+	for (size_t i = 0; i < n; i++)
+		plan.keys.push_back(((rng() % PRIORITIES) << ID_BITS) | i);
+	for (size_t i = 0; i < decreases && n > 0; i++)
+	{
+		plan.decIds.push_back((uint32_t) (rng() % n));
+		plan.decBy.push_back(rng() % (PRIORITIES / 64));
+	}
+	vector<uint64_t> priority(n); // Track priorities so no decrease goes below zero
+	for (size_t i = 0; i < n; i++)
+		priority[i] = plan.keys[i] >> ID_BITS;
+	for (size_t i = 0; i < plan.decIds.size(); i++)
+	{
+		plan.decBy[i] = min(plan.decBy[i], priority[plan.decIds[i]]);
+		priority[plan.decIds[i]] -= plan.decBy[i];
+	}
+	for (size_t i = 0; i < holds; i++)
+		plan.holdGaps.push_back(1 + rng() % (PRIORITIES / 16));
+
+	printf("%zu keys, %zu decreases, %zu holds (ns/op, bytes/key)\n", n, decreases, holds);
+	printf("%-16s %10s %10s %10s %10s %10s %8s\n", "structure", "build", "pushes", "decrease", "hold", "drain", "memory");
+	vector<Result> results;
+	vector<const char*> names;
+	auto add = [&](const char* name, auto& q) {
+		results.push_back(run(q, plan));
+		names.push_back(name);
+		report(name, results.back(), plan);
+	};
+	{ HeapQueue<2> q; add("DaryHeap<2>", q); }
+	{ HeapQueue<4> q; add("DaryHeap<4>", q); }
+	{ HeapQueue<8> q; add("DaryHeap<8>", q); }
+	{ TreeQueue<uint64_t> q; add("AVL<uint64_t>", q); }
+	{ TreeQueue<string> q; add("AVL<string>", q); }
+
+	bool ok = true;
+	for (size_t i = 0; i < results.size(); i++)
+		if (!results[i].ordered || results[i].digest != results.back().digest)
+		{
+			printf("error: %s popped %s\n", names[i], results[i].ordered ? "a different sequence than AVL<string>" : "out of order");
+			ok = false;
+		}
+
+	// Handles: erase and update by handle, and rejection of misuse
+	DaryHeap<int> heap;
+	vector<DaryHeap<int>::Handle> handles;
+	for (int i = 0; i < 1000; i++)
+		handles.push_back(heap.push((int) (rng() % 100000)));
+	for (int i = 0; i < 1000; i += 3)
+		heap.erase(handles[i]);
+	for (int i = 1; i < 1000; i += 3)
+		heap.update(handles[i], (int) (rng() % 100000));
+	int rejected = 0;
+	try { heap.erase(handles[0]); } catch (const runtime_error&) { rejected++; }
+	try { heap.decreaseKey(handles[1], heap.value(handles[1]) + 1); } catch (const runtime_error&) { rejected++; }
+	bool handlesOk = heap.isHeap() && !heap.contains(handles[0]) && heap.contains(handles[1]) && rejected == 2;
+	for (int last = INT32_MIN; !heap.empty(); )
+	{
+		int x = heap.pop();
+		handlesOk = handlesOk && x >= last;
+		last = x;
+	}
+	try { heap.top(); } catch (const runtime_error&) { rejected++; }
+	if (!handlesOk || rejected != 3)
+	{
+		printf("error: erase/update by handle left the heap inconsistent\n");
+		ok = false;
+	}
+	return ok ? 0 : 1;
+}
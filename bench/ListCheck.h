@@ -0,0 +1,63 @@
+/*
+	Checker for printed lists, shared by the list benchmarks. ListCheck is a stream buffer that
+	reads what a list's print() writes ("a -> b -> c") as it is written, so even a list of
+	millions of elements is checked without holding its text. It counts and sums the numbers,
+	notes whether they ever decrease, and, when given the values the list should hold, compares
+	each number with the next one of them.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef LISTCHECK_H
+#define LISTCHECK_H
+#include <cstdint>
+#include <streambuf>
+#include <string>
+#include <vector>
+using namespace std;
+
+class ListCheck : public streambuf
+{
+	private:
+		const vector<int>* expected; // Values the list should hold in order (NULL if unknown)
+		string token; // Characters since the last space
+		long long prev = 0; // Last number read
+
+		void endToken()
+		{
+			if (!token.empty() && token != "->")
+			{
+				long long x = stoll(token);
+				if (expected != NULL)
+					same = same && seen < expected->size() && x == (*expected)[seen];
+				sorted = sorted && (seen == 0 || prev <= x);
+				prev = x;
+				sum += (uint64_t) x;
+				seen++;
+			}
+			token.clear();
+		}
+
+	protected:
+		int overflow(int c) override
+		{
+			if (c == ' ')
+				endToken();
+			else if (c != EOF)
+				token += (char) c;
+			return c;
+		}
+
+	public:
+		size_t seen = 0; // Numbers read
+		uint64_t sum = 0; // Their sum, modulo 2^64
+		bool sorted = true; // Whether they never decreased
+		bool same = true; // Whether every number so far matched the expected values
+
+		ListCheck() : expected(NULL) {}
+		ListCheck(const vector<int>& e) : expected(&e) {}
+		bool finish() { endToken(); return same && (expected == NULL || seen == expected->size()); } // Reads the last number, which no space follows, and returns whether the whole list matched
+};
+
+#endif
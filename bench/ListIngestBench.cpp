@@ -0,0 +1,155 @@
+/*
+	Benchmark for bulk ingest and binary images of LinkedList. Times filling a list one insert()
+	at a time against insertRange() and assign() from an array, clear() followed by a refill
+	into the same slabs, and a save() and load() round trip through an image file (load() maps
+	it) and through an in-memory buffer. After each step the list must print exactly what the
+	array says it should hold, and a damaged image must be rejected.
+
+	Build :  g++ -O2 -std=c++20 ListIngestBench.cpp ../linkedlist/LinkedList.cpp -o list_ingest_bench
+	Usage :  ./list_ingest_bench [elements] [image path]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../linkedlist/LinkedList.h"
+#include "ListCheck.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+// Checks that a list holds exactly the given values in order, printing an error if not.
+// Input: List - List to check, Vector - Expected values, String - Step being checked
+// Output: Bool - True if the list matched
+static bool matches(LinkedList& list, const vector<int>& expected, const char* step)
+{
+	ListCheck check(expected);
+	ostream out(&check);
+	list.print(out);
+	if (check.finish() && list.length() == (int) expected.size())
+		return true;
+	printf("error: list differs from the expected values after %s\n", step);
+	return false;
+}
+
+// Prints one timing line.
+static void report(const char* step, double seconds, size_t n)
+{
+	printf("%-28s %10.3f s %12.1f M elements/s\n", step, seconds, seconds > 0 ? n / seconds / 1e6 : 0.0);
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 10000000;
+	string path = argc > 2 ? argv[2] : "list_ingest.img";
+	bool ok = true;
+
+	mt19937 rng(11);
+	vector<int> values(n);
+	for (int& x : values)
+		x = (int) rng();
+	vector<int> reversed(values.rbegin(), values.rend()); // Order left by inserting at the head
+	printf("%zu elements\n", n);
+
+	auto t = chrono::steady_clock::now();
+	{
+		LinkedList list;
+		for (int x : values)
+			list.insert(x);
+		report("insert() one by one", secondsSince(t), n);
+		ok = matches(list, reversed, "insert()") && ok;
+	}
+
+	LinkedList list;
+	t = chrono::steady_clock::now();
+	list.insertRange(values);
+	report("insertRange()", secondsSince(t), n);
+	ok = matches(list, reversed, "insertRange()") && ok;
+	size_t reserved = list.bytesReserved();
+	printf("%-28s %10.1f bytes/element\n", "slab memory", n == 0 ? 0.0 : (double) reserved / n);
+
+	t = chrono::steady_clock::now();
+	list.clear();
+	double clearSeconds = secondsSince(t);
+	printf("%-28s %10.3f ms\n", "clear()", clearSeconds * 1e3);
+	if (list.length() != 0 || !list.print().empty())
+	{
+		printf("error: list is not empty after clear()\n");
+		ok = false;
+	}
+
+	t = chrono::steady_clock::now();
+	list.assign(values);
+	report("assign() after clear()", secondsSince(t), n);
+	ok = matches(list, values, "assign()") && ok;
+	if (list.bytesReserved() != reserved)
+	{
+		printf("error: refilling after clear() grew the slabs from %zu to %zu bytes\n", reserved, list.bytesReserved());
+		ok = false;
+	}
+
+	t = chrono::steady_clock::now();
+	list.save(path);
+	report("save() to file", secondsSince(t), n);
+	LinkedList loaded;
+	t = chrono::steady_clock::now();
+	loaded.load(path);
+	report("load() from mapped file", secondsSince(t), n);
+	ok = matches(loaded, values, "load() from a file") && ok;
+
+	ostringstream image;
+	list.save(image);
+	string buffer = image.str();
+	t = chrono::steady_clock::now();
+	loaded.load(buffer.data(), buffer.size());
+	report("load() from buffer", secondsSince(t), n);
+	ok = matches(loaded, values, "load() from a buffer") && ok;
+
+	// A truncated image and one with a bad magic number must both be rejected, leaving the list as it was
+	int rejected = 0;
+	try { loaded.load(buffer.data(), buffer.size() - (n > 0 ? 1 : buffer.size())); } catch (const runtime_error&) { rejected++; }
+	buffer[0] = 'X';
+	try { loaded.load(buffer.data(), buffer.size()); } catch (const runtime_error&) { rejected++; }
+	if (rejected != 2)
+	{
+		printf("error: %d of 2 damaged images were rejected\n", rejected);
+		ok = false;
+	}
+	ok = matches(loaded, values, "rejected loads") && ok;
+
+	// Sorted mode keeps bulk ingest in order
+	vector<int> extra(n / 4 + 1);
+	for (int& x : extra)
+		x = (int) rng();
+	loaded.setSorted(true);
+	t = chrono::steady_clock::now();
+	loaded.insertRange(extra);
+	report("sorted insertRange()", secondsSince(t), extra.size());
+	vector<int> all = values;
+	all.insert(all.end(), extra.begin(), extra.end());
+	sort(all.begin(), all.end());
+	ok = matches(loaded, all, "sorted insertRange()") && ok;
+	for (size_t i = 0; i < extra.size() && ok; i += max<size_t>(1, extra.size() / 100))
+		if (loaded.find(extra[i]) == NULL)
+		{
+			printf("error: sorted find() misses a value added by insertRange()\n");
+			ok = false;
+		}
+
+	remove(path.c_str());
+	return ok ? 0 : 1;
+}
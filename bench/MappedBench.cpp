@@ -0,0 +1,227 @@
+/*
+	Benchmark for restarting from an on-disk AVL image. Times rebuilding a tree by replaying
+	insert() against saving it once and reopening the image with MappedAVL (with and without
+	checksum verification), then compares find and range throughput on the mapped image with
+	the live tree. Then checks a round trip of AVL<string> keys (a quarter as many) against the
+	live tree, and that an image with one byte flipped and one cut short are both rejected by
+	the MappedAVL constructor, and that queries on an unverified image stop at records pointing
+	outside it. A failed check makes the program exit with status 1.
+
+	Build :  g++ -O2 -std=c++20 MappedBench.cpp -o mapped_bench
+	Usage :  ./mapped_bench [keys] [lookups] [image path]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../avl/AVL.h"
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+// Reads a whole file into a string (empty if it cannot be read).
+static string readFile(const string& path)
+{
+	string bytes;
+	FILE* f = fopen(path.c_str(), "rb");
+	if (f == NULL)
+		return bytes;
+	char buf[1 << 16];
+	size_t got;
+	while ((got = fread(buf, 1, sizeof(buf), f)) > 0)
+		bytes.append(buf, got);
+	fclose(f);
+	return bytes;
+}
+
+// Writes a string to a file, replacing it.
+static void writeFile(const string& path, const string& bytes)
+{
+	FILE* f = fopen(path.c_str(), "wb");
+	if (f == NULL)
+		return;
+	fwrite(bytes.data(), 1, bytes.size(), f);
+	fclose(f);
+}
+
+// Returns whether an AVL<string> image is rejected: by the constructor, or, when the checksum is
+// not verified, by a query that reaches a damaged record. A count of every key passes the root
+// and its children; a find of the root's key reads the root's key bytes.
+// Input: String - Path of the image, Bool - Whether to verify the checksum, String - Key of the root
+// Output: Bool - True if the image was rejected
+static bool rejected(const string& path, bool verify = true, const string& rootKey = "")
+{
+	try
+	{
+		MappedAVL<string> m(path, verify);
+		m.range("", "\x7f");
+		m.find(rootKey);
+	}
+	catch (const runtime_error&)
+	{
+		return true;
+	}
+	return false;
+}
+
+// Saves a tree of string keys, maps the image and checks it against the live tree, then checks
+// that a copy with one byte flipped and a copy cut short are both rejected, and that queries
+// stop at records pointing outside the image when the checksum is not verified.
+// Input: Size - Keys, Size - Probes, String - Path of the image
+// Output: Bool - True if every check passed
+static bool checkStrings(size_t n, size_t lookups, const string& path)
+{
+	mt19937_64 rng(19);
+	auto keyOf = [](uint64_t x) { return "key-" + to_string(x) + string(x % 24, 'x'); }; // Some short enough to inline, some not
+	AVL<string> live;
+	for (size_t i = 0; i < n; i++)
+		live.insert(keyOf(rng() % (4 * n + 4)));
+	live.save(path);
+
+	bool ok = true;
+	string rootKey;
+	{
+		MappedAVL<string> mapped(path);
+		rootKey = mapped.keyAt(mapped.getRoot());
+		long wrong = mapped.size() != live.size();
+		for (size_t i = 0; i < lookups; i++)
+		{
+			string a = keyOf(rng() % (4 * n + 4)), b = keyOf(rng() % (4 * n + 4));
+			if (b < a)
+				swap(a, b);
+			wrong += mapped.contains(a) != (live.find(a) != NULL);
+			wrong += mapped.range(a, b) != live.range(a, b);
+			wrong += mapped.rank(a) != live.rank(a);
+		}
+		printf("\n%-28s %10d keys, %ld mismatches\n", "string image round trip", mapped.size(), wrong);
+		if (wrong != 0)
+		{
+			printf("error: mapped string image disagrees with the live tree in %ld checks\n", wrong);
+			ok = false;
+		}
+	}
+
+	string image = readFile(path);
+	string damaged = image;
+	damaged[damaged.size() / 2] ^= 0x10;
+	writeFile(path, damaged);
+	if (!rejected(path))
+	{
+		printf("error: an image with a flipped byte was accepted\n");
+		ok = false;
+	}
+	writeFile(path, image.substr(0, image.size() - image.size() / 3));
+	if (!rejected(path))
+	{
+		printf("error: a truncated image was accepted\n");
+		ok = false;
+	}
+	typedef ImageNode<string, true> Record;
+	typedef ImageKey<string, true> RecordKey;
+	size_t root = sizeof(ImageHeader) + sizeof(Record); // Record 1 is the root
+	NodeId far = (NodeId) live.size() + 1;
+	damaged = image;
+	memcpy(&damaged[root + offsetof(Record, right)], &far, sizeof(far));
+	writeFile(path, damaged);
+	if (!rejected(path, false))
+	{
+		printf("error: an unverified image with a child index past the records was accepted\n");
+		ok = false;
+	}
+	uint64_t beyond = image.size();
+	damaged = image;
+	memcpy(&damaged[root + offsetof(Record, key) + offsetof(RecordKey, offset)], &beyond, sizeof(beyond));
+	writeFile(path, damaged);
+	if (!rejected(path, false, rootKey))
+	{
+		printf("error: an unverified image with a key past the blob was accepted\n");
+		ok = false;
+	}
+	remove(path.c_str());
+	return ok;
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 10000000;
+	size_t lookups = argc > 2 ? strtoull(argv[2], NULL, 10) : 1000000;
+	string path = argc > 3 ? argv[3] : "mapped_bench.img";
+
+	mt19937_64 rng(17);
+	vector<uint64_t> keys(n), probes(lookups);
+	for (uint64_t& k : keys)
+		k = rng() % (4 * n);
+	for (uint64_t& p : probes)
+		p = rng() % (4 * n);
+
+	auto t = chrono::steady_clock::now();
+	AVL<uint64_t> live;
+	for (uint64_t k : keys)
+		live.insert(k);
+	double replay = secondsSince(t);
+
+	t = chrono::steady_clock::now();
+	live.save(path);
+	double save = secondsSince(t);
+
+	t = chrono::steady_clock::now();
+	{
+		MappedAVL<uint64_t> verified(path);
+	}
+	double openVerified = secondsSince(t);
+
+	t = chrono::steady_clock::now();
+	MappedAVL<uint64_t> mapped(path, false);
+	double openUnverified = secondsSince(t);
+
+	printf("%zu keys (%d distinct), image %.1f MB\n", n, live.size(), mapped.bytesMapped() / 1e6);
+	printf("%-28s %10.3f sec\n", "rebuild by replaying insert", replay);
+	printf("%-28s %10.3f sec\n", "save image", save);
+	printf("%-28s %10.3f sec\n", "open image, verified", openVerified);
+	printf("%-28s %10.3f sec\n", "open image, unverified", openUnverified);
+
+	long hits = 0, mappedHits = 0, count = 0, mappedCount = 0;
+	t = chrono::steady_clock::now();
+	for (uint64_t p : probes)
+		hits += live.find(p) != NULL;
+	double liveFind = lookups / secondsSince(t);
+	t = chrono::steady_clock::now();
+	for (uint64_t p : probes)
+		mappedHits += mapped.contains(p);
+	double mappedFind = lookups / secondsSince(t);
+	t = chrono::steady_clock::now();
+	for (uint64_t p : probes)
+		count += live.range(p, p + 1000);
+	double liveRange = lookups / secondsSince(t);
+	t = chrono::steady_clock::now();
+	for (uint64_t p : probes)
+		mappedCount += mapped.range(p, p + 1000);
+	double mappedRange = lookups / secondsSince(t);
+
+	printf("\n%-12s %14s %14s\n", "structure", "finds/sec", "ranges/sec");
+	printf("%-12s %14.0f %14.0f\n", "live AVL", liveFind, liveRange);
+	printf("%-12s %14.0f %14.0f\n", "mapped", mappedFind, mappedRange);
+	bool ok = true;
+	if (hits != mappedHits || count != mappedCount)
+	{
+		printf("  error: mapped image disagrees with the live tree (%ld/%ld hits, %ld/%ld counted)\n", mappedHits, hits, mappedCount, count);
+		ok = false;
+	}
+	remove(path.c_str());
+
+	ok = checkStrings(n / 4, lookups, path) && ok;
+	return ok ? 0 : 1;
+}
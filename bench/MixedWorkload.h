@@ -0,0 +1,91 @@
+/*
+	Timed mixed workload shared by the concurrent benchmarks. A run starts a number of threads
+	that each draw a random key and a die roll per step and hand both to an operation mix, which
+	picks one operation on the structure under test (a lookup, an insert, a range count, ...)
+	from the roll. After a fixed time the threads stop and the run reports operations per second.
+
+	compareScaling() prefills a concurrent structure and a sequential one behind a mutex with the
+	same keys, then times the same mix on both from 1 thread up to a maximum, doubling each time.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef MIXEDWORKLOAD_H
+#define MIXEDWORKLOAD_H
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Runs an operation mix on a structure for a fixed time with a given number of threads.
+// Input: Structure - Structure under test, Mix - Callable (structure, roll in [0, 100), key)
+//        performing one operation and returning its result, Unsigned - Threads,
+//        Int - Milliseconds to run, uint64_t - Key space
+// Output: Double - Operations per second
+template <class Structure, class Mix>
+double throughput(Structure& s, Mix mix, unsigned threads, int millis, uint64_t keySpace)
+{
+	atomic<bool> stop(false);
+	atomic<long> ops(0);
+	atomic<uint64_t> results(0); // Keeps the compiler from discarding the lookups
+	vector<thread> pool;
+	auto start = chrono::steady_clock::now();
+	for (unsigned t = 0; t < threads; t++)
+		pool.emplace_back([&, t]() {
+			mt19937_64 rng(1000 + t);
+			long local = 0;
+			uint64_t sink = 0;
+			while (!stop.load(memory_order_relaxed))
+			{
+				int dice = rng() % 100;
+				sink += mix(s, dice, rng() % keySpace);
+				local++;
+			}
+			ops += local;
+			results += sink;
+		});
+	this_thread::sleep_for(chrono::milliseconds(millis));
+	stop.store(true);
+	for (thread& th : pool)
+		th.join();
+	return ops.load() / chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Times a mix on a concurrent structure and on its locked counterpart, both prefilled with the
+// same random keys, for 1, 2, 4, ... up to maxThreads threads, and prints one row per count.
+// Both structures are rebuilt for every row so that earlier runs do not grow them.
+// Input: Unsigned - Maximum threads, Size - Keys to prefill, uint64_t - Key space,
+//        Int - Milliseconds per run, Mix - Operation mix (see throughput()),
+//        Strings - Names of the concurrent and the locked structure
+// Output: None
+template <class Concurrent, class Locked, class Mix>
+void compareScaling(unsigned maxThreads, size_t prefill, uint64_t keySpace, int millis, Mix mix,
+	const char* concurrentName, const char* lockedName)
+{
+	int cw = max<int>(18, strlen(concurrentName) + 5), lw = max<int>(18, strlen(lockedName) + 5);
+	printf("%8s %*s op/s %*s op/s\n", "threads", cw - 5, concurrentName, lw - 5, lockedName);
+	for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		mt19937_64 rng(99);
+		Concurrent concurrent;
+		Locked locked;
+		for (size_t i = 0; i < prefill; i++)
+		{
+			uint64_t k = rng() % keySpace;
+			concurrent.insert(k);
+			locked.insert(k);
+		}
+		double c = throughput(concurrent, mix, threads, millis, keySpace);
+		double l = throughput(locked, mix, threads, millis, keySpace);
+		printf("%8u %*.0f %*.0f\n", threads, cw, c, lw, l);
+	}
+}
+
+#endif
@@ -0,0 +1,182 @@
+/*
+	Benchmark and check of the ordered access methods of AVL: iterators, lowerBound/upperBound,
+	rank/select and both scan() overloads. Builds AVL<uint64_t> and AVL<string> trees from the
+	same random keys next to a std::set, checks every method against the set on present and
+	absent keys, in-range and out-of-range ranks, reversed intervals and pages past the end of
+	an interval, then times deep pages read with scan(k1, k2, offset, limit) against walking an
+	iterator past the skipped keys.
+
+	Build :  g++ -O2 -std=c++20 OrderedBench.cpp -o ordered_bench
+	Usage :  ./ordered_bench [keys] [queries]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../avl/AVL.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+// Turns a number into a key of the tree's type (strings are zero-padded, so they sort alike).
+template <class Key>
+static Key keyOf(uint64_t x)
+{
+	if constexpr (is_same_v<Key, string>)
+	{
+		char buf[21];
+		snprintf(buf, sizeof(buf), "%020llu", (unsigned long long) x);
+		return string(buf, 20);
+	}
+	else
+		return x;
+}
+
+// Returns whether an iterator range holds exactly the keys of a set range, in order.
+template <class Range, class SetIt>
+static bool sameKeys(const Range& r, SetIt first, SetIt last)
+{
+	auto it = r.begin();
+	for (; first != last; ++first, ++it)
+		if (it == r.end() || *it != *first)
+			return false;
+	return it == r.end();
+}
+
+// Checks one tree against a std::set holding the same keys, printing an error per failed check.
+// Input: String - Name of the tree, Size - Keys, Size - Queries, Unsigned - Seed
+// Output: Bool - True if every check passed
+template <class Key>
+static bool check(const char* name, size_t n, size_t queries, unsigned seed)
+{
+	mt19937_64 rng(seed);
+	uint64_t space = 4 * n + 4; // Three quarters of the probes in the key space are absent
+	AVL<Key> tree;
+	set<Key> model;
+	for (size_t i = 0; i < n; i++)
+	{
+		Key k = keyOf<Key>(rng() % space);
+		tree.insert(k);
+		model.insert(k);
+	}
+	vector<Key> sorted(model.begin(), model.end());
+	int size = (int) sorted.size();
+	long wrong[6] = {}; // select, rank, lowerBound, upperBound, reverse, scan
+
+	// select() for every rank and just outside the range
+	for (int i = 0; i < size; i++)
+		wrong[0] += tree.select(i) == tree.end() || *tree.select(i) != sorted[i];
+	wrong[0] += tree.select(-1) != tree.end();
+	wrong[0] += tree.select(size) != tree.end();
+	wrong[0] += tree.select(size + 100) != tree.end();
+
+	// rank(), lowerBound() and upperBound() on random probes (mostly absent) and on every fourth key
+	vector<Key> probes;
+	for (size_t i = 0; i < queries; i++)
+		probes.push_back(keyOf<Key>(rng() % (space + 2)));
+	for (int i = 0; i < size; i += 4)
+		probes.push_back(sorted[i]);
+	for (const Key& k : probes)
+	{
+		auto lo = model.lower_bound(k);
+		auto hi = model.upper_bound(k);
+		wrong[1] += tree.rank(k) != (int) (lower_bound(sorted.begin(), sorted.end(), k) - sorted.begin());
+		auto tlo = tree.lowerBound(k);
+		auto thi = tree.upperBound(k);
+		wrong[2] += (tlo == tree.end()) != (lo == model.end()) || (lo != model.end() && *tlo != *lo);
+		wrong[3] += (thi == tree.end()) != (hi == model.end()) || (hi != model.end() && *thi != *hi);
+	}
+
+	// Reverse iteration from end() visits every key, largest first
+	auto it = tree.end();
+	for (auto mit = model.rbegin(); mit != model.rend(); ++mit)
+	{
+		--it;
+		wrong[4] += *it != *mit;
+	}
+	wrong[4] += it != tree.begin();
+
+	// scan(k1, k2) and scan(k1, k2, offset, limit), including reversed intervals and pages past the end
+	for (size_t q = 0; q < queries; q++)
+	{
+		uint64_t x1 = rng() % space;
+		uint64_t x2 = q < 4 ? rng() % space : x1 + rng() % 256; // A few wide intervals, the rest about 64 keys
+		Key k1 = keyOf<Key>(x1), k2 = keyOf<Key>(x2);
+		if (q % 8 == 0)
+			swap(k1, k2); // Reversed, unless the two are equal
+		auto lo = lower_bound(sorted.begin(), sorted.end(), k1); // Positions come from the set's contents in order
+		auto hi = k1 <= k2 ? upper_bound(sorted.begin(), sorted.end(), k2) : lo; // A reversed interval is empty
+		int inside = (int) (hi - lo);
+		wrong[5] += !sameKeys(tree.scan(k1, k2), lo, hi);
+		int offset = (int) (rng() % (inside + 3)); // Sometimes at or past the end of the interval
+		int limit = (int) (rng() % 8);
+		auto first = lo + min(offset, inside);
+		auto last = first + min(limit, (int) (hi - first));
+		wrong[5] += !sameKeys(tree.scan(k1, k2, offset, limit), first, last);
+	}
+	wrong[5] += !tree.scan(keyOf<Key>(space), keyOf<Key>(space + 1)).empty(); // Above every key
+
+	const char* what[6] = {"select", "rank", "lowerBound", "upperBound", "reverse iteration", "scan"};
+	bool ok = true;
+	for (int i = 0; i < 6; i++)
+		if (wrong[i] != 0)
+		{
+			printf("error: %s: %ld %s results differ from std::set\n", name, wrong[i], what[i]);
+			ok = false;
+		}
+	printf("%-16s %8d keys: %s\n", name, size, ok ? "ok" : "FAILED");
+	return ok;
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+	size_t queries = argc > 2 ? strtoull(argv[2], NULL, 10) : 20000;
+
+	bool ok = check<uint64_t>("AVL<uint64_t>", n, queries, 3);
+	ok = check<string>("AVL<string>", n, queries, 4) && ok;
+	ok = check<uint64_t>("empty", 0, 100, 5) && ok;
+
+	// Deep pages: scan(k1, k2, offset, limit) finds both ends with select(), an iterator walks there
+	AVL<uint64_t> tree;
+	for (uint64_t i = 0; i < n; i++)
+		tree.insert(i);
+	const int PAGE = 20;
+	uint64_t sink = 0;
+	mt19937 rng(6);
+	auto t = chrono::steady_clock::now();
+	for (size_t q = 0; q < queries; q++)
+		for (uint64_t k : tree.scan(0, n, (int) (rng() % (n + 1)), PAGE))
+			sink += k;
+	double paged = secondsSince(t);
+	size_t walks = max<size_t>(1, queries / 1000); // Walking is slow, so time fewer
+	rng.seed(6);
+	uint64_t walked = 0;
+	t = chrono::steady_clock::now();
+	for (size_t q = 0; q < walks; q++)
+	{
+		auto it = tree.begin();
+		for (int skip = (int) (rng() % (n + 1)); skip > 0 && it != tree.end(); skip--)
+			++it;
+		for (int i = 0; i < PAGE && it != tree.end(); i++, ++it)
+			walked += *it;
+	}
+	double walking = secondsSince(t);
+	printf("page of %d at a random offset: %.2f us with scan(offset, limit), %.2f us walking an iterator\n",
+		PAGE, paged / max<size_t>(1, queries) * 1e6, walking / walks * 1e6);
+	printf("(checksum %llu)\n", (unsigned long long) (sink + walked));
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+/*
+	Stress test and benchmark for PersistentAVL: snapshots taken while several threads insert,
+	and reclamation of versions once nothing references them.
+
+	Each writer inserts its own keys (w, w + W, w + 2W, ...) in a shuffled order it publishes as
+	it goes. The main thread meanwhile takes snapshots, reading every writer's progress just
+	before and just after each one. A consistent snapshot holds, for every writer, exactly a
+	prefix of that writer's order whose length lies between the two readings (plus one, for an
+	insert published but not yet counted). Once the writers are done, each snapshot is checked
+	against the model frozen at that moment: which prefix it holds, its size(), and contains(),
+	range() and select() on random probes.
+
+	Keys count their live instances, and every node holds exactly one, so the count is the
+	number of nodes alive. With snapshots held it exceeds the size of the final tree (old paths
+	are still reachable); once they are dropped it must fall to exactly that size, and to zero
+	when the tree itself is destroyed. Any failed check makes the program exit with status 1.
+
+	Build :  g++ -O2 -std=c++20 -pthread PersistentBench.cpp -o persistent_bench
+	Usage :  ./persistent_bench [writers] [keys per writer] [snapshots] [probes per snapshot]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../avl/PersistentAVL.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+// Integer key that counts how many copies of it are alive, so the nodes holding them can be counted
+struct CountedKey
+{
+	static atomic<long> live;
+	uint64_t v;
+
+	CountedKey(uint64_t x = 0) : v(x) { live++; }
+	CountedKey(const CountedKey& o) : v(o.v) { live++; }
+	CountedKey& operator=(const CountedKey& o) { v = o.v; return *this; }
+	~CountedKey() { live--; }
+	bool operator<(const CountedKey& o) const { return v < o.v; }
+};
+atomic<long> CountedKey::live(0);
+
+typedef PersistentAVL<CountedKey> Tree;
+
+// A snapshot and every writer's progress read around it
+struct Taken
+{
+	Tree::Snapshot snap;
+	vector<size_t> before, after; // Keys each writer had finished inserting just before and after (one more may be published but not yet counted)
+};
+
+// Checks one snapshot against the writers' orders and the progress read around it.
+// Input: Taken - Snapshot and progress, Vector - Each writer's insert order, Size - Probes, Unsigned - Seed
+// Output: Bool - True if the snapshot matches a model within the progress bounds
+static bool checkSnapshot(const Taken& t, const vector<vector<uint64_t>>& orders, size_t probes, unsigned seed)
+{
+	size_t writers = orders.size();
+	vector<uint64_t> model; // Keys the snapshot must hold
+	for (size_t w = 0; w < writers; w++)
+	{
+		size_t held = 0;
+		while (held < orders[w].size() && t.snap.contains(CountedKey(orders[w][held])))
+			held++;
+		if (held < t.before[w] || held > t.after[w] + 1)
+			return false; // Missing a key inserted before the snapshot, or holding one begun after it
+		for (size_t i = held; i < orders[w].size(); i++)
+			if (t.snap.contains(CountedKey(orders[w][i])))
+				return false; // Not a prefix: a later key is in without an earlier one
+		model.insert(model.end(), orders[w].begin(), orders[w].begin() + held);
+	}
+	sort(model.begin(), model.end());
+	if (t.snap.size() != (int) model.size())
+		return false;
+
+	mt19937_64 rng(seed);
+	uint64_t space = 0;
+	for (const vector<uint64_t>& o : orders)
+		space += o.size();
+	space += 2;
+	for (size_t i = 0; i < probes; i++)
+	{
+		uint64_t a = rng() % space, b = rng() % space;
+		if (a > b)
+			swap(a, b);
+		int inside = (int) (upper_bound(model.begin(), model.end(), b) - lower_bound(model.begin(), model.end(), a));
+		if (t.snap.range(CountedKey(a), CountedKey(b)) != inside)
+			return false;
+		if (t.snap.contains(CountedKey(a)) != binary_search(model.begin(), model.end(), a))
+			return false;
+		if (!model.empty())
+		{
+			size_t r = rng() % model.size();
+			const CountedKey* k = t.snap.select((int) r);
+			if (k == NULL || k->v != model[r])
+				return false;
+		}
+	}
+	return t.snap.select((int) model.size()) == NULL && t.snap.select(-1) == NULL;
+}
+
+int main(int argc, char** argv)
+{
+	size_t writers = argc > 1 ? strtoull(argv[1], NULL, 10) : 4;
+	size_t perWriter = argc > 2 ? strtoull(argv[2], NULL, 10) : 100000;
+	size_t snapshots = argc > 3 ? strtoull(argv[3], NULL, 10) : 50;
+	size_t probes = argc > 4 ? strtoull(argv[4], NULL, 10) : 2000;
+	writers = max<size_t>(1, writers);
+	bool ok = true;
+
+	vector<vector<uint64_t>> orders(writers);
+	for (size_t w = 0; w < writers; w++)
+	{
+		for (size_t i = 0; i < perWriter; i++)
+			orders[w].push_back(i * writers + w);
+		shuffle(orders[w].begin(), orders[w].end(), mt19937_64(w + 1));
+	}
+
+	vector<Taken> taken;
+	long peakNodes = 0;
+	{
+		Tree tree;
+		vector<atomic<size_t>> progress(writers);
+		for (atomic<size_t>& p : progress)
+			p.store(0);
+		atomic<size_t> finished(0);
+
+		auto start = chrono::steady_clock::now();
+		vector<thread> pool;
+		for (size_t w = 0; w < writers; w++)
+			pool.emplace_back([&, w]() {
+				for (uint64_t k : orders[w])
+				{
+					tree.insert(CountedKey(k));
+					progress[w].fetch_add(1, memory_order_release);
+				}
+				finished++;
+			});
+
+		// Spread the snapshots over the inserts, taking the rest once the writers are done
+		size_t total = writers * perWriter;
+		for (size_t s = 0; s < snapshots; s++)
+		{
+			size_t target = total * s / max<size_t>(1, snapshots);
+			while (finished.load() < writers)
+			{
+				size_t done = 0;
+				for (atomic<size_t>& p : progress)
+					done += p.load(memory_order_acquire);
+				if (done >= target)
+					break;
+				this_thread::yield();
+			}
+			Taken t;
+			for (atomic<size_t>& p : progress)
+				t.before.push_back(p.load(memory_order_acquire));
+			t.snap = tree.snapshot();
+			for (atomic<size_t>& p : progress)
+				t.after.push_back(p.load(memory_order_acquire));
+			taken.push_back(move(t));
+		}
+		for (thread& th : pool)
+			th.join();
+		double seconds = secondsSince(start);
+		printf("%zu writers inserted %zu keys in %.3f s (%.0f inserts/s) with %zu snapshots taken\n",
+			writers, total, seconds, seconds > 0 ? total / seconds : 0.0, snapshots);
+
+		start = chrono::steady_clock::now();
+		long wrong = 0;
+		for (size_t s = 0; s < taken.size(); s++)
+			wrong += !checkSnapshot(taken[s], orders, probes, (unsigned) s);
+		printf("%zu snapshots checked against their frozen models in %.3f s: %ld inconsistent\n", taken.size(), secondsSince(start), wrong);
+		if (wrong != 0)
+		{
+			printf("error: %ld snapshots differ from the keys present when they were taken\n", wrong);
+			ok = false;
+		}
+		if (tree.size() != (int) total)
+		{
+			printf("error: the tree holds %d keys, expected %zu\n", tree.size(), total);
+			ok = false;
+		}
+
+		bool partial = false; // Whether some snapshot holds an older version than the final one
+		for (const Taken& t : taken)
+			partial = partial || t.snap.size() < (int) total;
+		peakNodes = CountedKey::live.load();
+		taken.clear();
+		long afterDrop = CountedKey::live.load();
+		printf("nodes alive: %ld with snapshots held, %ld after dropping them (tree holds %d keys)\n", peakNodes, afterDrop, tree.size());
+		if (afterDrop != tree.size() || (partial && peakNodes <= afterDrop))
+		{
+			printf("error: dropping the snapshots left %ld nodes alive for %d keys\n", afterDrop, tree.size());
+			ok = false;
+		}
+	}
+	if (CountedKey::live.load() != 0)
+	{
+		printf("error: %ld nodes still alive after the tree was destroyed\n", CountedKey::live.load());
+		ok = false;
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,245 @@
+/*
+	Throughput and latency benchmark for MPMCQueue, against the mutex-guarded linked list that
+	threads otherwise hand items through (one node allocation and one lock round trip per item).
+
+	Throughput: P producers each push a run of items (their producer number over a sequence
+	number) while P consumers pop them, for P = 1, 2, 4 ... up to the given maximum. Three ways
+	of handing off are compared: the locked list, MPMCQueue one item at a time, and MPMCQueue
+	in batches through tryPushN/tryPopN. Every run checks that each item arrived exactly once
+	(by count and sum) and that each consumer saw each producer's items in the order they were
+	pushed; a failure makes the program exit with status 1.
+
+	Latency: two threads bounce one item back and forth through two queues, and half of each
+	round trip is one handoff. Percentiles are over every round trip.
+
+	Build :  g++ -O2 -std=c++20 -pthread QueueBench.cpp -o queue_bench
+	Usage :  ./queue_bench [max pairs] [items per producer] [batch size] [round trips]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../queue/MPMCQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+static const size_t CAPACITY = 1 << 16; // Items the queues hold
+static const int SEQ_BITS = 40; // Low bits of an item holding its sequence number
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+/* HANDOFFS */
+// The handoff being replaced: a linked list behind one mutex, allocating a node per item.
+struct LockedList
+{
+	list<uint64_t> items;
+	mutex lock;
+
+	size_t push(const uint64_t* xs, size_t n) { for (size_t i = 0; i < n; i++) { lock_guard<mutex> g(lock); items.push_back(xs[i]); } return n; }
+	size_t pop(uint64_t* out, size_t n)
+	{
+		size_t k = 0;
+		for (; k < n; k++)
+		{
+			lock_guard<mutex> g(lock);
+			if (items.empty())
+				break;
+			out[k] = items.front();
+			items.pop_front();
+		}
+		return k;
+	}
+};
+
+// MPMCQueue used one item at a time, the way the list is
+struct SingleQueue
+{
+	MPMCQueue<uint64_t> q{CAPACITY};
+
+	size_t push(const uint64_t* xs, size_t n) { size_t k = 0; while (k < n && q.tryPush(xs[k])) k++; return k; }
+	size_t pop(uint64_t* out, size_t n) { size_t k = 0; while (k < n && q.tryPop(out[k])) k++; return k; }
+};
+
+// MPMCQueue used a batch at a time
+struct BatchQueue
+{
+	MPMCQueue<uint64_t> q{CAPACITY};
+
+	size_t push(const uint64_t* xs, size_t n) { return q.tryPushN(xs, n); }
+	size_t pop(uint64_t* out, size_t n) { return q.tryPopN(out, n); }
+};
+
+/* THROUGHPUT */
+// Runs producers and consumers through a handoff and checks what the consumers received.
+// Input: Handoff - Structure under test, Unsigned - Producer/consumer pairs,
+//        Size - Items per producer, Size - Items per push and pop
+// Output: Double - Items handed off per second (negative if a check failed)
+template <class Handoff>
+static double throughput(Handoff& h, unsigned pairs, size_t items, size_t batch)
+{
+	atomic<size_t> received(0);
+	atomic<uint64_t> sum(0);
+	atomic<long> disorder(0);
+	size_t total = pairs * items;
+	vector<thread> pool;
+	auto start = chrono::steady_clock::now();
+	for (unsigned p = 0; p < pairs; p++)
+		pool.emplace_back([&, p]() {
+			vector<uint64_t> buf(batch);
+			for (size_t i = 0; i < items; )
+			{
+				size_t n = min(batch, items - i);
+				for (size_t j = 0; j < n; j++)
+					buf[j] = (uint64_t(p) << SEQ_BITS) | (i + j);
+				size_t done = 0;
+				while (done < n)
+				{
+					size_t k = h.push(buf.data() + done, n - done);
+					done += k;
+					if (k == 0)
+						this_thread::yield(); // Full
+				}
+				i += n;
+			}
+		});
+	for (unsigned c = 0; c < pairs; c++)
+		pool.emplace_back([&]() {
+			vector<uint64_t> buf(batch);
+			vector<int64_t> last(pairs, -1); // Last sequence number seen from each producer
+			uint64_t localSum = 0;
+			long localDisorder = 0;
+			while (received.load(memory_order_relaxed) < total)
+			{
+				size_t k = h.pop(buf.data(), batch);
+				if (k == 0)
+				{
+					this_thread::yield(); // Empty
+					continue;
+				}
+				for (size_t j = 0; j < k; j++)
+				{
+					uint64_t x = buf[j];
+					size_t p = x >> SEQ_BITS;
+					int64_t seq = (int64_t) (x & ((uint64_t(1) << SEQ_BITS) - 1));
+					localDisorder += p >= pairs || seq <= last[p % pairs];
+					last[p % pairs] = seq;
+					localSum += x;
+				}
+				received += k;
+			}
+			sum += localSum;
+			disorder += localDisorder;
+		});
+	for (thread& th : pool)
+		th.join();
+	double seconds = secondsSince(start);
+
+	uint64_t expected = 0;
+	for (unsigned p = 0; p < pairs; p++)
+		expected += (uint64_t(p) << SEQ_BITS) * items + items * (items - 1) / 2;
+	if (received.load() != total || sum.load() != expected || disorder.load() != 0)
+		return -1;
+	return total / seconds;
+}
+
+/* LATENCY */
+// Bounces an item between two threads through a pair of handoffs and records each round trip.
+// Input: Handoffs - One for each direction, Size - Round trips
+// Output: Vector - Nanoseconds per one-way handoff (half of each round trip), sorted
+template <class Handoff>
+static vector<double> pingPong(Handoff& there, Handoff& back, size_t trips)
+{
+	vector<double> ns(trips);
+	thread echo([&]() {
+		uint64_t x;
+		for (size_t i = 0; i < trips; i++)
+		{
+			while (there.pop(&x, 1) == 0)
+				this_thread::yield();
+			while (back.push(&x, 1) == 0)
+				this_thread::yield();
+		}
+	});
+	for (size_t i = 0; i < trips; i++)
+	{
+		uint64_t x = i;
+		auto t = chrono::steady_clock::now();
+		while (there.push(&x, 1) == 0)
+			this_thread::yield();
+		while (back.pop(&x, 1) == 0)
+			this_thread::yield();
+		ns[i] = secondsSince(t) * 1e9 / 2;
+	}
+	echo.join();
+	sort(ns.begin(), ns.end());
+	return ns;
+}
+
+// Prints the percentiles of one latency run.
+static void reportLatency(const char* name, const vector<double>& ns)
+{
+	auto at = [&](double q) { return ns.empty() ? 0.0 : ns[min(ns.size() - 1, (size_t) (q * ns.size()))]; };
+	printf("%-16s %10.0f %10.0f %10.0f\n", name, at(0.5), at(0.99), at(0.999));
+}
+
+int main(int argc, char** argv)
+{
+	unsigned maxPairs = argc > 1 ? strtoul(argv[1], NULL, 10) : max(1u, thread::hardware_concurrency() / 2);
+	size_t items = argc > 2 ? strtoull(argv[2], NULL, 10) : 2000000;
+	size_t batch = argc > 3 ? strtoull(argv[3], NULL, 10) : 256;
+	size_t trips = argc > 4 ? strtoull(argv[4], NULL, 10) : 100000;
+	maxPairs = max(1u, maxPairs);
+	batch = max<size_t>(1, batch);
+	bool ok = true;
+
+	printf("%zu items per producer, batches of %zu, capacity %zu\n", items, batch, CAPACITY);
+	printf("%6s %16s %16s %16s\n", "pairs", "locked list/s", "MPMC single/s", "MPMC batch/s");
+	for (unsigned pairs = 1; pairs <= maxPairs; pairs *= 2)
+	{
+		double rates[3];
+		{ LockedList h; rates[0] = throughput(h, pairs, items, 1); }
+		{ SingleQueue h; rates[1] = throughput(h, pairs, items, 1); }
+		{ BatchQueue h; rates[2] = throughput(h, pairs, items, batch); }
+		printf("%6u %16.0f %16.0f %16.0f\n", pairs, rates[0], rates[1], rates[2]);
+		for (double r : rates)
+			if (r < 0)
+			{
+				printf("error: items were lost, duplicated or reordered with %u pairs\n", pairs);
+				ok = false;
+				break;
+			}
+	}
+
+	printf("\none-way handoff over %zu round trips (ns)\n", trips);
+	printf("%-16s %10s %10s %10s\n", "handoff", "p50", "p99", "p99.9");
+	{ LockedList a, b; reportLatency("locked list", pingPong(a, b, trips)); }
+	{ SingleQueue a, b; reportLatency("MPMC", pingPong(a, b, trips)); }
+
+	// A full queue takes part of a batch, and an empty one gives nothing
+	MPMCQueue<int> small(5);
+	vector<int> in(10), out(10);
+	for (int i = 0; i < 10; i++)
+		in[i] = i;
+	size_t pushed = small.tryPushN(in.data(), 10);
+	size_t popped = small.tryPopN(out.data(), 10);
+	bool edges = small.capacity() == 8 && pushed == 8 && popped == 8 && equal(out.begin(), out.begin() + 8, in.begin())
+		&& small.tryPopN(out.data(), 10) == 0 && small.sizeApprox() == 0;
+	if (!edges)
+	{
+		printf("error: batch push/pop at the capacity limits (pushed %zu, popped %zu)\n", pushed, popped);
+		ok = false;
+	}
+	return ok ? 0 : 1;
+}
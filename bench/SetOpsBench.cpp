@@ -0,0 +1,113 @@
+/*
+	Benchmark for the join-based AVL set operations. Merges a delta tree into a base tree by
+	re-inserting every key one at a time, then with unionWith() at increasing thread counts, and
+	also times intersectWith() and differenceWith(). Every result is compared with std::set_union,
+	std::set_intersection and std::set_difference over the sorted keys, the delta tree must come
+	out unchanged, and each operation is also checked with a tree as its own operand. A failed
+	check makes the program exit with status 1.
+
+	Build :  g++ -O2 -std=c++20 -pthread SetOpsBench.cpp -o setops_bench
+	Usage :  ./setops_bench [base keys] [delta keys] [max threads]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../avl/AVL.h"
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+// Checks that a tree holds exactly the given keys, printing an error if not.
+// Input: AVL - Tree to check, Vector - Expected keys in increasing order, String - Operation
+//        that produced the tree, Unsigned - Threads it used
+// Output: Bool - True if the tree matched
+static bool matches(AVL<uint64_t>& tree, const vector<uint64_t>& expected, const char* op, unsigned threads)
+{
+	if ((size_t) tree.size() == expected.size() && equal(tree.begin(), tree.end(), expected.begin()))
+		return true;
+	printf("error: %s with %u threads differs from the std:: result\n", op, threads);
+	return false;
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 4000000;
+	size_t m = argc > 2 ? strtoull(argv[2], NULL, 10) : 1000000;
+	unsigned maxThreads = argc > 3 ? strtoul(argv[3], NULL, 10) : thread::hardware_concurrency();
+	if (maxThreads == 0)
+		maxThreads = 1;
+
+	mt19937_64 rng(7);
+	vector<uint64_t> base(n), delta(m);
+	for (uint64_t& k : base)
+		k = rng() % (4 * n);
+	for (uint64_t& k : delta)
+		k = rng() % (4 * n);
+	AVL<uint64_t> deltaTree(delta.begin(), delta.end());
+
+	// The expected results, over the distinct keys of each side
+	vector<uint64_t> a = base, b = delta, unionKeys, interKeys, diffKeys;
+	sort(a.begin(), a.end());
+	a.erase(unique(a.begin(), a.end()), a.end());
+	sort(b.begin(), b.end());
+	b.erase(unique(b.begin(), b.end()), b.end());
+	set_union(a.begin(), a.end(), b.begin(), b.end(), back_inserter(unionKeys));
+	set_intersection(a.begin(), a.end(), b.begin(), b.end(), back_inserter(interKeys));
+	set_difference(a.begin(), a.end(), b.begin(), b.end(), back_inserter(diffKeys));
+	bool ok = true;
+
+	printf("base = %zu, delta = %zu\n", n, m);
+	printf("%-24s %8s %12s %12s\n", "operation", "threads", "seconds", "result size");
+
+	{
+		AVL<uint64_t> tree(base.begin(), base.end());
+		auto t = chrono::steady_clock::now();
+		for (uint64_t k : delta)
+			tree.insert(k);
+		printf("%-24s %8u %12.4f %12d\n", "insert one at a time", 1u, secondsSince(t), tree.size());
+	}
+
+	for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		AVL<uint64_t> tree(base.begin(), base.end());
+		auto t = chrono::steady_clock::now();
+		tree.unionWith(deltaTree, threads);
+		printf("%-24s %8u %12.4f %12d\n", "unionWith", threads, secondsSince(t), tree.size());
+		ok = matches(tree, unionKeys, "unionWith", threads) && ok;
+
+		AVL<uint64_t> inter(base.begin(), base.end());
+		t = chrono::steady_clock::now();
+		inter.intersectWith(deltaTree, threads);
+		printf("%-24s %8u %12.4f %12d\n", "intersectWith", threads, secondsSince(t), inter.size());
+		ok = matches(inter, interKeys, "intersectWith", threads) && ok;
+
+		AVL<uint64_t> diff(base.begin(), base.end());
+		t = chrono::steady_clock::now();
+		diff.differenceWith(deltaTree, threads);
+		printf("%-24s %8u %12.4f %12d\n", "differenceWith", threads, secondsSince(t), diff.size());
+		ok = matches(diff, diffKeys, "differenceWith", threads) && ok;
+		ok = matches(deltaTree, b, "the delta operand after the set operations", threads) && ok;
+
+		// A tree combined with itself: union and intersection keep it, difference empties it
+		tree.unionWith(tree, threads);
+		ok = matches(tree, unionKeys, "unionWith itself", threads) && ok;
+		tree.intersectWith(tree, threads);
+		ok = matches(tree, unionKeys, "intersectWith itself", threads) && ok;
+		tree.differenceWith(tree, threads);
+		ok = matches(tree, vector<uint64_t>(), "differenceWith itself", threads) && ok;
+	}
+	return ok ? 0 : 1;
+}
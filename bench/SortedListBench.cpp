@@ -0,0 +1,136 @@
+/*
+	Benchmark for the sorted mode of LinkedList. Fills a list with random values, times a few
+	find() scans on it as it is, then switches it into sorted mode and times the switch
+	(sorting plus building the skip-list index), indexed find() and lowerBound() over the same
+	kind of probes (half present, half absent), and ordered insert() and remove(). Every
+	answer is checked against a sorted vector, and at the end the list must print exactly the
+	vector's contents.
+
+	Build :  g++ -O2 -std=c++20 SortedListBench.cpp ../linkedlist/LinkedList.cpp -o sorted_list_bench
+	Usage :  ./sorted_list_bench [elements] [lookups] [updates] [scan lookups]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../linkedlist/LinkedList.h"
+#include "ListCheck.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 10000000;
+	size_t lookups = argc > 2 ? strtoull(argv[2], NULL, 10) : 1000000;
+	size_t updates = argc > 3 ? strtoull(argv[3], NULL, 10) : 100000;
+	size_t scans = argc > 4 ? strtoull(argv[4], NULL, 10) : 20;
+	bool ok = true;
+
+	mt19937 rng(7);
+	vector<int> model(n);
+	for (int& x : model)
+		x = (int) (rng() & ~1u); // Even values are present, odd ones absent
+	vector<int> probes(lookups);
+	for (size_t i = 0; i < lookups; i++)
+		probes[i] = (i % 2 == 0 && n > 0) ? model[rng() % n] : (int) (rng() | 1);
+
+	LinkedList list;
+	for (int x : model)
+		list.insert(x);
+	sort(model.begin(), model.end());
+	printf("%zu elements\n", n);
+
+	long hits = 0;
+	scans = min(scans, lookups);
+	auto t = chrono::steady_clock::now();
+	for (size_t i = 0; i < scans; i++)
+		hits += list.find(probes[i]) != NULL;
+	double scanUs = scans == 0 ? 0 : secondsSince(t) / scans * 1e6;
+	printf("%-28s %12.2f us/find\n", "unsorted find (scan)", scanUs);
+
+	t = chrono::steady_clock::now();
+	list.setSorted(true);
+	printf("%-28s %12.3f s\n", "setSorted(true)", secondsSince(t));
+
+	long indexedHits = 0;
+	t = chrono::steady_clock::now();
+	for (size_t i = 0; i < lookups; i++)
+		indexedHits += list.find(probes[i]) != NULL;
+	double findUs = lookups == 0 ? 0 : secondsSince(t) / lookups * 1e6;
+	printf("%-28s %12.2f us/find %10.0fx\n", "sorted find (index)", findUs, findUs > 0 ? scanUs / findUs : 0.0);
+	long expectedHits = 0, scanHits = 0;
+	for (size_t i = 0; i < lookups; i++)
+	{
+		bool present = binary_search(model.begin(), model.end(), probes[i]);
+		expectedHits += present;
+		scanHits += i < scans && present;
+	}
+	if (indexedHits != expectedHits || hits != scanHits)
+	{
+		printf("error: finds hit %ld (index) and %ld (scan), expected %ld and %ld\n", indexedHits, hits, expectedHits, scanHits);
+		ok = false;
+	}
+
+	long wrong = 0;
+	t = chrono::steady_clock::now();
+	for (size_t i = 0; i < lookups; i++)
+	{
+		Node *node = list.lowerBound(probes[i]);
+		auto it = lower_bound(model.begin(), model.end(), probes[i]);
+		wrong += (node == NULL) != (it == model.end()) || (node != NULL && node->data != *it);
+	}
+	printf("%-28s %12.2f us/lowerBound (with check)\n", "sorted lowerBound", lookups == 0 ? 0 : secondsSince(t) / lookups * 1e6);
+	if (wrong != 0)
+	{
+		printf("error: %ld lowerBound results differ from the vector\n", wrong);
+		ok = false;
+	}
+
+	vector<int> added(updates), dropped(updates);
+	for (int& x : added)
+		x = (int) rng();
+	for (size_t i = 0; i < updates; i++)
+		dropped[i] = (i % 2 == 0 && n > 0) ? model[rng() % n] : added[rng() % updates];
+	t = chrono::steady_clock::now();
+	for (int x : added)
+		list.insert(x);
+	printf("%-28s %12.2f us/insert\n", "sorted insert", updates == 0 ? 0 : secondsSince(t) / updates * 1e6);
+	long removed = 0;
+	t = chrono::steady_clock::now();
+	for (int x : dropped)
+		removed += list.remove(x);
+	printf("%-28s %12.2f us/remove\n", "sorted remove", updates == 0 ? 0 : secondsSince(t) / updates * 1e6);
+
+	model.insert(model.end(), added.begin(), added.end());
+	sort(model.begin(), model.end());
+	vector<int> gone = dropped; // Each remove takes one copy of its value, while any is left
+	sort(gone.begin(), gone.end());
+	vector<int> left;
+	left.reserve(model.size());
+	set_difference(model.begin(), model.end(), gone.begin(), gone.end(), back_inserter(left));
+	long expectedRemoved = (long) (model.size() - left.size());
+	model.swap(left);
+	ListCheck check(model);
+	ostream out(&check);
+	list.print(out);
+	if (removed != expectedRemoved || !check.finish() || list.length() != (int) model.size())
+	{
+		printf("error: list differs from the vector after the updates (%ld removed, expected %ld)\n", removed, expectedRemoved);
+		ok = false;
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+/*
+	Benchmark for the instrumentation counters of common/Stats.h. Runs a few phases of work on
+	AVL trees and a LinkedList (sequential and random inserts, lookups, range erases, lookups
+	from several threads at once) and prints, for each phase, the time it took next to the
+	counters it moved: comparisons, single and double rotations, nodes visited per lookup and
+	allocations. The final snapshot is printed as JSON. Built without -DDS_STATS the counters
+	stay at zero, which shows the timings of the uninstrumented code.
+
+	Build :  g++ -O2 -std=c++20 -DDS_STATS -pthread StatsBench.cpp ../linkedlist/LinkedList.cpp -o stats_bench
+	Usage :  ./stats_bench [tree keys] [lookups] [threads]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../avl/AVL.h"
+#include "../common/Stats.h"
+#include "../linkedlist/LinkedList.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+// Runs one phase of work and prints its time and the counters it moved.
+// Input: String - Label, Function - Work to run
+// Output: StatsSnapshot - Counters moved by the phase
+template <class Work>
+static StatsSnapshot phase(const char* label, Work work)
+{
+	StatsSnapshot before = Stats::snapshot();
+	auto t = chrono::steady_clock::now();
+	work();
+	double secs = secondsSince(t);
+	StatsSnapshot d = Stats::snapshot() - before;
+	printf("%-24s %8.3f %12llu %10llu %10llu %10llu %8.2f %6d %10llu %9.1f\n", label, secs, (unsigned long long) d.comparisons,
+		(unsigned long long) d.singleRotations, (unsigned long long) d.doubleRotations, (unsigned long long) d.lookups,
+		d.meanVisited(), d.visitedPercentile(0.99), (unsigned long long) d.nodesAllocated, d.bytesAllocated / 1e6);
+	return d;
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+	size_t q = argc > 2 ? strtoull(argv[2], NULL, 10) : 1000000;
+	unsigned threads = argc > 3 ? strtoul(argv[3], NULL, 10) : 4;
+	printf("counters %s, %zu keys, %zu lookups\n", STATS_ENABLED ? "on" : "off (build with -DDS_STATS)", n, q);
+	printf("%-24s %8s %12s %10s %10s %10s %8s %6s %10s %9s\n", "phase", "sec", "compares", "single", "double", "lookups", "visited", "p99", "nodes", "MB");
+
+	mt19937_64 rng(3);
+	vector<uint64_t> keys(n), probes(q);
+	for (uint64_t& k : keys)
+		k = rng();
+	for (size_t i = 0; i < q; i++)
+		probes[i] = (i & 1) ? keys[rng() % n] : rng();
+
+	AVL<uint64_t> sequential, random;
+	phase("AVL sequential insert", [&]() { for (size_t i = 0; i < n; i++) sequential.insert(i); });
+	phase("AVL random insert", [&]() { for (uint64_t k : keys) random.insert(k); });
+	long hits = 0;
+	StatsSnapshot finds = phase("AVL find", [&]() { for (uint64_t p : probes) hits += random.find(p) != NULL; });
+	phase("AVL eraseRange", [&]() { for (size_t i = 0; i + 100 < n; i += 1000) sequential.eraseRange(i, i + 99); });
+	vector<long> threadHits(threads);
+	StatsSnapshot parallel = phase("AVL find, threaded", [&]() {
+		vector<thread> pool;
+		for (unsigned t = 0; t < threads; t++)
+			pool.emplace_back([&, t]() { for (uint64_t p : probes) threadHits[t] += random.find(p) != NULL; });
+		for (thread& t : pool)
+			t.join();
+	});
+	for (long h : threadHits)
+		if (h != hits)
+			printf("  error: a thread found %ld keys, expected %ld\n", h, hits);
+
+	LinkedList list;
+	size_t listKeys = min<size_t>(n, 10000), listProbes = min<size_t>(q, 2000);
+	phase("LinkedList insert", [&]() { for (size_t i = 0; i < listKeys; i++) list.insert((int) i); });
+	phase("LinkedList find", [&]() { for (size_t i = 0; i < listProbes; i++) list.find((int) (rng() % (2 * listKeys))); });
+
+	printf("\nsnapshot: ");
+	Stats::snapshot().print(cout);
+	cout << endl;
+	if (STATS_ENABLED)
+	{
+		if (finds.lookups != q || parallel.lookups != (uint64_t) threads * q)
+			printf("  error: counted %llu and %llu lookups, expected %zu and %zu\n", (unsigned long long) finds.lookups, (unsigned long long) parallel.lookups, q, (size_t) threads * q);
+		if (finds.comparisons != (uint64_t) (finds.meanVisited() * finds.lookups + 0.5))
+			printf("  error: lookups visited a different number of nodes than they compared\n");
+		if (finds.meanVisited() > random.getHeight(random.getRoot()) + 1)
+			printf("  error: lookups visited %.2f nodes on average in a tree of height %d\n", finds.meanVisited(), random.getHeight(random.getRoot()));
+	}
+	return hits < 0;
+}
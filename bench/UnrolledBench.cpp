@@ -0,0 +1,141 @@
+/*
+	Benchmark for UnrolledLinkedList against LinkedList. Both lists get the same random values
+	inserted, and for each the benchmark reports the bytes per element held by its slabs
+	(bytesReserved()), the rate of find() scans over the same probes (half of them absent,
+	so they walk the whole list), length(), sort() and, for the unrolled list, remove(). The
+	sorted lists must print the same, the unrolled list must take fewer bytes per element, and it
+	must match a plain vector after the removes. A failed check makes the program exit with status 1.
+
+	Build :  g++ -O2 -std=c++20 UnrolledBench.cpp ../linkedlist/LinkedList.cpp ../linkedlist/UnrolledLinkedList.cpp -o unrolled_bench
+	Usage :  ./unrolled_bench [elements] [lookups] [removes]
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "../linkedlist/LinkedList.h"
+#include "../linkedlist/UnrolledLinkedList.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Returns the number of seconds elapsed since a given time point.
+static double secondsSince(chrono::steady_clock::time_point t)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+// Times the operations shared by both lists and prints one row for the list.
+// Input: List - Empty list, String - Label, Vectors - Values to insert and values to find,
+//        Long reference - Set to the probes found, Double reference - Set to the slab bytes per element
+// Output: String - The list printed after sorting it
+template <class List>
+static string run(List& list, const char* label, const vector<int>& values, const vector<int>& probes, long& hits, double& bytes)
+{
+	auto t = chrono::steady_clock::now();
+	for (int x : values)
+		list.insert(x);
+	double insertRate = values.size() / secondsSince(t);
+	bytes = (double) list.bytesReserved() / max<size_t>(values.size(), 1);
+
+	hits = 0;
+	t = chrono::steady_clock::now();
+	for (int p : probes)
+		hits += list.find(p) != NULL;
+	double scanned = (double) probes.size() * values.size(); // Upper bound of elements compared
+	double scanRate = scanned / secondsSince(t);
+
+	t = chrono::steady_clock::now();
+	long total = 0;
+	for (int i = 0; i < 100; i++)
+		total += list.length();
+	double lengthNs = secondsSince(t) / 100 * 1e9;
+	if (total != 100L * (long) values.size())
+		printf("  error: %s length() is %ld, expected %zu\n", label, total / 100, values.size());
+
+	t = chrono::steady_clock::now();
+	list.sort();
+	double sortRate = values.size() / secondsSince(t);
+
+	printf("%-10s %12.1f %14.0f %16.0f %12.0f %14.0f\n", label, bytes, insertRate, scanRate, lengthNs, sortRate);
+	return list.print();
+}
+
+int main(int argc, char** argv)
+{
+	size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000;
+	size_t lookups = argc > 2 ? strtoull(argv[2], NULL, 10) : 200;
+	size_t removes = argc > 3 ? strtoull(argv[3], NULL, 10) : 2000;
+
+	mt19937 rng(7);
+	vector<int> values(n), probes(lookups);
+	for (int& x : values)
+		x = (int) (rng() >> 1); // Non-negative, so that negated values are absent
+	for (size_t i = 0; i < lookups; i++)
+		probes[i] = (i % 2 == 0 && n > 0) ? values[rng() % n] : -1 - (int) (rng() >> 1);
+
+	printf("%zu elements, %zu lookups (half absent)\n", n, lookups);
+	printf("%-10s %12s %14s %16s %12s %14s\n", "list", "bytes/elem", "inserts/s", "scanned elem/s", "length ns", "sorted elem/s");
+	LinkedList list;
+	UnrolledLinkedList unrolled;
+	long listHits, unrolledHits;
+	double listBytes, unrolledBytes;
+	bool ok = true;
+	string listOut = run(list, "linked", values, probes, listHits, listBytes);
+	string unrolledOut = run(unrolled, "unrolled", values, probes, unrolledHits, unrolledBytes);
+	if (listHits != unrolledHits)
+	{
+		printf("error: unrolled list found %ld values, linked list %ld\n", unrolledHits, listHits);
+		ok = false;
+	}
+	if (listOut != unrolledOut)
+	{
+		printf("error: sorted lists differ\n");
+		ok = false;
+	}
+	if (n > 0 && unrolledBytes >= listBytes)
+	{
+		printf("error: unrolled list takes %.1f bytes/elem, linked list %.1f\n", unrolledBytes, listBytes);
+		ok = false;
+	}
+
+	// Remove random values from the sorted unrolled list, and the same values from a sorted vector
+	removes = n == 0 ? 0 : removes;
+	vector<int> victims(removes);
+	for (int& v : victims)
+		v = (rng() % 2 == 0) ? values[rng() % n] : -1;
+	size_t kept = unrolled.bytesReserved();
+	auto t = chrono::steady_clock::now();
+	size_t removed = 0;
+	for (int v : victims)
+		removed += unrolled.remove(v);
+	double removeRate = removes / secondsSince(t);
+
+	vector<int> model = values;
+	sort(model.begin(), model.end());
+	vector<int> gone = victims;
+	sort(gone.begin(), gone.end());
+	vector<int> left;
+	set_difference(model.begin(), model.end(), gone.begin(), gone.end(), back_inserter(left));
+	if (removed != n - left.size() || (size_t) unrolled.length() != left.size())
+	{
+		printf("error: removed %zu values, expected %zu\n", removed, n - left.size());
+		ok = false;
+	}
+	string expected;
+	for (size_t i = 0; i < left.size(); i++)
+		expected += (i ? " -> " : "") + to_string(left[i]);
+	if (unrolled.print() != expected)
+	{
+		printf("error: unrolled list differs from the vector after the removes\n");
+		ok = false;
+	}
+	printf("remove: %.0f removes/s, %zu of %zu present, slabs %.2f MB -> %.2f MB\n", removeRate, removed, removes, kept / 1e6, unrolled.bytesReserved() / 1e6);
+	return ok ? 0 : 1;
+}
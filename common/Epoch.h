@@ -0,0 +1,163 @@
+/*
+	Epoch-based memory reclamation for lock-free structures. A node unlinked from a shared
+	structure cannot be freed at once, since other threads may still be reading it. Here
+	every access to a structure runs inside an Epoch::Guard, and an unlinked node is handed to
+	Epoch::retire() instead of being freed. It is freed once every thread has been seen
+	outside any guard, or inside a guard started after the node was retired, so no reader is
+	left holding a pointer to it.
+
+	How it works: a global epoch counter only moves forward. A thread entering a guard publishes
+	the epoch it saw; leaving its outermost guard clears it. A retired node is tagged with the
+	epoch at which it was retired. The epoch advances from e to e + 1 only once every thread in a
+	guard has published e, so once the epoch reaches r + 2 no guard that began at or before r
+	is still open, and nodes tagged r can be freed. Each thread keeps its own list of retired
+	nodes and, every RETIRE_BATCH retirements, tries to advance the epoch and frees what has
+	become safe. Guards are cheap (one store and one fence to enter, one store to leave); only
+	advancing the epoch scans the other threads, under a lock that is only ever tried, so a
+	thread never waits for another.
+
+	A thread that exits hands its remaining retired nodes to a shared list that later advances
+	free. A thread that stays inside a guard holds every later retirement back, so guards
+	should cover single operations.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef EPOCH_H
+#define EPOCH_H
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+using namespace std;
+
+class Epoch
+{
+	private:
+		// Node waiting to be freed
+		struct Retired
+		{
+			void* p;
+			void (*free)(void*);
+			uint64_t epoch; // Epoch at which it was retired
+		};
+
+		// State of one thread
+		struct Record
+		{
+			atomic<uint64_t> active{0}; // Epoch published by the open guard (0 outside any guard)
+			int depth = 0; // Guards open on this thread, so nested guards publish only once
+			vector<Retired> retired; // Nodes retired by this thread and not yet freed
+			size_t sinceCollect = 0; // Retirements since the last attempt to free
+			Record();
+			~Record();
+		};
+
+		// Every live record, and the nodes left behind by threads that have exited
+		struct Registry
+		{
+			atomic<uint64_t> epoch{1}; // Global epoch (never 0, which marks a thread outside any guard)
+			mutex lock;
+			vector<Record*> live;
+			vector<Retired> orphans;
+			~Registry() { freeUpTo(orphans, UINT64_MAX); }
+		};
+
+		static Registry& registry() { static Registry r; return r; }
+		static Record& local() { thread_local Record r; return r; }
+
+		// Frees the nodes of a list retired before a given epoch and keeps the others.
+		static void freeUpTo(vector<Retired>& list, uint64_t before)
+		{
+			auto keep = partition(list.begin(), list.end(), [before](const Retired& r) { return r.epoch >= before; });
+			for (auto it = keep; it != list.end(); ++it)
+				it->free(it->p);
+			list.erase(keep, list.end());
+		}
+
+		// Advances the epoch if every thread inside a guard has seen the current one, then frees
+		// what is safe. Gives up at once if another thread is doing the same.
+		static void collect(Record& self)
+		{
+			Registry& r = registry();
+			atomic_thread_fence(memory_order_seq_cst); // Order the unlinks before the scan of the guards
+			uint64_t e = r.epoch.load();
+			if (r.lock.try_lock())
+			{
+				bool behind = false;
+				for (Record* rec : r.live)
+				{
+					uint64_t a = rec->active.load();
+					behind = behind || (a != 0 && a != e);
+				}
+				if (!behind && r.epoch.compare_exchange_strong(e, e + 1))
+					e++;
+				freeUpTo(r.orphans, e - 1);
+				r.lock.unlock();
+			}
+			freeUpTo(self.retired, e - 1);
+		}
+
+	public:
+		static const size_t RETIRE_BATCH = 64; // Retirements between attempts to free
+
+		// Keeps every node reachable when it starts reachable until it ends
+		class Guard
+		{
+			private:
+				Record& rec;
+
+			public:
+				Guard() : rec(local())
+				{
+					if (rec.depth++ == 0)
+					{
+						rec.active.store(registry().epoch.load(memory_order_relaxed), memory_order_relaxed);
+						atomic_thread_fence(memory_order_seq_cst); // Publish before reading any shared pointer
+					}
+				}
+				~Guard()
+				{
+					if (--rec.depth == 0)
+						rec.active.store(0, memory_order_release);
+				}
+				Guard(const Guard&) = delete;
+				Guard& operator=(const Guard&) = delete;
+		};
+
+		// Hands over a node that is no longer reachable, to be freed once no guard can see it.
+		template <class T>
+		static void retire(T* p)
+		{
+			Record& self = local();
+			self.retired.push_back(Retired{p, [](void* q) { delete static_cast<T*>(q); }, registry().epoch.load()});
+			if (++self.sinceCollect == RETIRE_BATCH)
+			{
+				self.sinceCollect = 0;
+				collect(self);
+			}
+		}
+
+		// Returns the current global epoch.
+		static uint64_t current() { return registry().epoch.load(); }
+};
+
+// Registers a thread's record on its first use.
+inline Epoch::Record::Record()
+{
+	Registry& r = registry();
+	lock_guard<mutex> guard(r.lock);
+	r.live.push_back(this);
+}
+
+// Hands a thread's unfreed nodes to the shared list as the thread exits.
+inline Epoch::Record::~Record()
+{
+	Registry& r = registry();
+	lock_guard<mutex> guard(r.lock);
+	r.orphans.insert(r.orphans.end(), retired.begin(), retired.end());
+	r.live.erase(find(r.live.begin(), r.live.end(), this));
+}
+#endif
@@ -0,0 +1,191 @@
+/*
+	Hot-path instrumentation shared by the data structures. The counters are compiled in only
+	when DS_STATS is defined (g++ -DDS_STATS ...); otherwise every hook below is an empty inline
+	function and the instrumented code is exactly what it would be without them.
+
+	What is counted:
+	  - key comparisons (each three-way compare in the AVL tree, each element compared by a
+	    LinkedList lookup),
+	  - single and double rotations, whether done to rebalance or to join two trees,
+	  - the number of nodes visited by each find(), kept as a histogram,
+	  - nodes handed out and bytes requested from the allocator (node slabs, key blocks, list
+	    nodes).
+
+	Every thread counts into its own block, so the hooks never contend with each other. A block
+	is registered when its thread first counts something, and folded into a running total when
+	the thread exits. Stats::snapshot() sums the total and every live block into a
+	StatsSnapshot. Snapshots can be added and subtracted, so the cost of one phase of work is
+	the difference of the snapshots around it, and print() writes one as a JSON object.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef STATS_H
+#define STATS_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+using namespace std;
+
+#ifdef DS_STATS
+constexpr bool STATS_ENABLED = true;
+#else
+constexpr bool STATS_ENABLED = false;
+#endif
+
+const int STATS_DEPTHS = 64; // Buckets of the nodes-visited histogram; the last one also holds every longer lookup
+
+// Counter values at one point in time, summed over threads
+struct StatsSnapshot
+{
+	uint64_t comparisons = 0; // Key comparisons
+	uint64_t singleRotations = 0; // Rebalancing steps made of one rotation
+	uint64_t doubleRotations = 0; // Rebalancing steps made of two rotations
+	uint64_t lookups = 0; // Calls to find()
+	uint64_t visited[STATS_DEPTHS] = {}; // Number of lookups that visited a given number of nodes
+	uint64_t nodesAllocated = 0; // Nodes handed out, including reused ones
+	uint64_t bytesAllocated = 0; // Bytes requested from the allocator
+
+	// Applies a function to every pair of matching counters of two snapshots.
+	template <class Op>
+	static void zip(StatsSnapshot& a, const StatsSnapshot& b, Op op)
+	{
+		op(a.comparisons, b.comparisons);
+		op(a.singleRotations, b.singleRotations);
+		op(a.doubleRotations, b.doubleRotations);
+		op(a.lookups, b.lookups);
+		for (int i = 0; i < STATS_DEPTHS; i++)
+			op(a.visited[i], b.visited[i]);
+		op(a.nodesAllocated, b.nodesAllocated);
+		op(a.bytesAllocated, b.bytesAllocated);
+	}
+
+	StatsSnapshot& operator+=(const StatsSnapshot& o) { zip(*this, o, [](uint64_t& a, uint64_t b) { a += b; }); return *this; }
+	StatsSnapshot& operator-=(const StatsSnapshot& o) { zip(*this, o, [](uint64_t& a, uint64_t b) { a -= b; }); return *this; }
+	StatsSnapshot operator+(const StatsSnapshot& o) const { StatsSnapshot s = *this; return s += o; }
+	StatsSnapshot operator-(const StatsSnapshot& o) const { StatsSnapshot s = *this; return s -= o; }
+
+	// Returns the mean number of nodes visited per lookup (0 if there were none).
+	double meanVisited() const
+	{
+		uint64_t total = 0;
+		for (int i = 0; i < STATS_DEPTHS; i++)
+			total += i * visited[i];
+		return lookups == 0 ? 0.0 : (double) total / lookups;
+	}
+
+	// Returns the smallest number of nodes visited by at least a given fraction of the lookups.
+	int visitedPercentile(double p) const
+	{
+		uint64_t need = (uint64_t) (p * lookups), seen = 0;
+		for (int i = 0; i < STATS_DEPTHS; i++)
+			if ((seen += visited[i]) >= need && seen > 0)
+				return i;
+		return 0;
+	}
+
+	// Writes the snapshot as one JSON object. The histogram stops at its last nonzero bucket.
+	void print(ostream& out) const
+	{
+		int last = STATS_DEPTHS;
+		while (last > 0 && visited[last - 1] == 0)
+			last--;
+		out << "{\"comparisons\": " << comparisons << ", \"singleRotations\": " << singleRotations
+			<< ", \"doubleRotations\": " << doubleRotations << ", \"lookups\": " << lookups
+			<< ", \"meanVisited\": " << meanVisited() << ", \"visited\": [";
+		for (int i = 0; i < last; i++)
+			out << (i ? ", " : "") << visited[i];
+		out << "], \"nodesAllocated\": " << nodesAllocated << ", \"bytesAllocated\": " << bytesAllocated << "}";
+	}
+};
+
+class Stats
+{
+	private:
+		// Counters of one thread. Only the owner writes them, but snapshot() may read them at any
+		// time, so both sides go through relaxed atomic_refs (plain loads and stores on x86).
+		struct Block
+		{
+			StatsSnapshot counts;
+			int visiting = 0; // Nodes visited so far by the owner's current lookup
+			Block();
+			~Block();
+		};
+
+		// Every live block, and the counts of threads that have exited
+		struct Registry
+		{
+			mutex lock;
+			vector<Block*> live;
+			StatsSnapshot retired;
+		};
+
+		static Registry& registry() { static Registry r; return r; }
+		static Block& local() { thread_local Block b; return b; }
+		static void bump(uint64_t& c, uint64_t n = 1)
+		{
+			atomic_ref<uint64_t> r(c);
+			r.store(r.load(memory_order_relaxed) + n, memory_order_relaxed);
+		}
+
+	public:
+		// Hooks called by the data structures; each compiles to nothing unless DS_STATS is defined
+		static void comparison() { if constexpr (STATS_ENABLED) bump(local().counts.comparisons); } // Counts one key comparison
+		static void rotation(bool twice) { if constexpr (STATS_ENABLED) bump(twice ? local().counts.doubleRotations : local().counts.singleRotations); } // Counts one single or double rotation
+		static void beginLookup() { if constexpr (STATS_ENABLED) local().visiting = 0; } // Starts counting the nodes a lookup visits
+		static void visit() { if constexpr (STATS_ENABLED) local().visiting++; } // Counts one node visited by the current lookup
+		static void endLookup() // Records the current lookup in the histogram
+		{
+			if constexpr (STATS_ENABLED)
+			{
+				Block& b = local();
+				bump(b.counts.lookups);
+				bump(b.counts.visited[min(b.visiting, STATS_DEPTHS - 1)]);
+			}
+		}
+		static void allocation(uint64_t nodes, uint64_t bytes) // Counts nodes handed out and bytes requested from the allocator
+		{
+			if constexpr (STATS_ENABLED)
+			{
+				Block& b = local();
+				if (nodes)
+					bump(b.counts.nodesAllocated, nodes);
+				if (bytes)
+					bump(b.counts.bytesAllocated, bytes);
+			}
+		}
+
+		// Returns the counters of every thread so far, summed (all zero unless DS_STATS is defined).
+		static StatsSnapshot snapshot()
+		{
+			Registry& r = registry();
+			lock_guard<mutex> guard(r.lock);
+			StatsSnapshot s = r.retired;
+			for (Block* b : r.live)
+				StatsSnapshot::zip(s, b->counts, [](uint64_t& a, const uint64_t& c) { a += atomic_ref<uint64_t>(const_cast<uint64_t&>(c)).load(memory_order_relaxed); });
+			return s;
+		}
+};
+
+// Registers a thread's block on its first use.
+inline Stats::Block::Block()
+{
+	Registry& r = registry();
+	lock_guard<mutex> guard(r.lock);
+	r.live.push_back(this);
+}
+
+// Folds a thread's counts into the running total as the thread exits.
+inline Stats::Block::~Block()
+{
+	Registry& r = registry();
+	lock_guard<mutex> guard(r.lock);
+	r.retired += counts;
+	r.live.erase(find(r.live.begin(), r.live.end(), this));
+}
+#endif
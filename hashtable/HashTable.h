@@ -0,0 +1,117 @@
+/*
+	Implementation of a hash table with open addressing, laid out in the style of Google's
+	SwissTable. This is the header file that provides class/method definitions.
+
+	The table keeps one control byte per slot in an array of its own. A full slot's control byte
+	holds 7 bits of the key's hash (H2), and the other states are "empty" and "deleted" (a
+	tombstone left by an erase). Slots are probed a group of 16 at a time: the group's control
+	bytes are loaded into one SIMD register (SSE2 when the compiler targets it, a plain loop
+	otherwise) and compared against H2 in a single instruction. Only the slots whose bytes match
+	have their keys compared, which with 7 bits of hash is about one slot in 128 besides the key
+	itself. A probe starts at the group picked by the remaining hash bits (H1) and moves on to
+	further groups only while it meets full groups with no empty slot. A lookup that misses
+	usually stops at the first group.
+
+	Capacities are powers of two of at least one group, and the table grows (or rebuilds itself
+	at the same size if most of the used slots are tombstones) once it is 7/8 full. The hash is
+	mixed before it is split, so weak hash functions such as the identity hash of integers still
+	spread across groups. Lookups with a type other than Key are accepted when both Hash and
+	KeyEqual declare is_transparent, as for the standard unordered containers.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef HASHTABLE_H
+#define HASHTABLE_H
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+using namespace std;
+
+template <class Key, class Value, class Hash = hash<Key>, class KeyEqual = equal_to<Key>, class Allocator = allocator<Key>>
+class HashTable
+{
+	public:
+		// Key-value pair held in a full slot
+		struct Entry
+		{
+			Key key;
+			[[no_unique_address]] Value value;
+		};
+
+	private:
+		typedef typename allocator_traits<Allocator>::template rebind_alloc<int8_t> CtrlAllocator;
+		typedef typename allocator_traits<Allocator>::template rebind_alloc<Entry> EntryAllocator;
+
+		static constexpr int8_t EMPTY = -128; // Control byte of a slot that was never used since the last rebuild
+		static constexpr int8_t DELETED = -2; // Control byte of a slot whose entry was erased
+		static constexpr size_t GROUP = 16; // Slots whose control bytes are matched at once
+		static constexpr size_t NPOS = ~size_t(0); // Position returned when a key is absent
+		static constexpr bool Transparent = requires { typename Hash::is_transparent; typename KeyEqual::is_transparent; };
+
+		int8_t* ctrl; // Control byte of every slot (NULL until the first insert)
+		Entry* slots; // Slot storage, constructed only where the control byte is full
+		size_t cap; // Number of slots (0 or a power of two of at least GROUP)
+		size_t count; // Number of full slots
+		size_t growthLeft; // Empty slots that may still be filled before the table must grow
+		[[no_unique_address]] Hash hasher; // Hash function of the keys
+		[[no_unique_address]] KeyEqual equal; // Equality of the keys
+		[[no_unique_address]] CtrlAllocator ctrlAlloc;
+		[[no_unique_address]] EntryAllocator entryAlloc;
+
+		static uint64_t mix(uint64_t); // Spreads the bits of a hash so that both of its parts are well distributed
+		static uint32_t matchByte(const int8_t*, int8_t); // Bitmask of the slots in a group whose control byte equals a given one
+		static uint32_t matchFree(const int8_t*); // Bitmask of the slots in a group that are empty or deleted
+		static size_t maxLoad(size_t c) { return c - c / 8; } // Full slots allowed in a table of a given capacity
+		template <class K>
+		size_t locate(const K&, uint64_t) const; // Returns the slot holding a key (NPOS if absent)
+		size_t freeSlot(uint64_t) const; // Returns the first empty or deleted slot on a hash's probe sequence
+		void rehash(size_t); // Moves every entry into a fresh table of a given capacity
+		void release(); // Destroys every entry and frees both arrays
+		template <class K>
+		bool eraseKey(const K&); // Shared body of both erase() overloads
+
+	public:
+		// Constructors
+		HashTable();
+		explicit HashTable(size_t, const Hash& = Hash(), const KeyEqual& = KeyEqual(), const Allocator& = Allocator()); // Reserves room for a number of entries up front
+		~HashTable();
+		HashTable(const HashTable&) = delete;
+		HashTable& operator=(const HashTable&) = delete;
+		HashTable(HashTable&&) noexcept;
+		HashTable& operator=(HashTable&&) noexcept;
+
+		// Insert methods
+		pair<Entry*, bool> insert(const Key&, const Value& = Value()); // Adds an entry unless the key is present; returns the key's entry and whether it was added
+
+		// Erase methods
+		bool erase(const Key& k) { return eraseKey(k); } // Removes the entry of a key, returning whether it was present
+		template <class K> requires Transparent
+		bool erase(const K& k) { return eraseKey(k); }
+		void clear(); // Removes every entry and frees the arrays
+
+		// Find methods
+		Entry* find(const Key&); // Returns the entry of a key (NULL if absent)
+		template <class K> requires Transparent
+		Entry* find(const K& k) { size_t pos = locate(k, mix(hasher(k))); return pos == NPOS ? NULL : &slots[pos]; }
+		bool contains(const Key& k) const { return locate(k, mix(hasher(k))) != NPOS; } // Returns whether a key is present
+		template <class K> requires Transparent
+		bool contains(const K& k) const { return locate(k, mix(hasher(k))) != NPOS; }
+
+		// Calls a function on every entry, in slot order
+		template <class Visit>
+		void forEach(Visit);
+
+		// Capacity
+		void reserve(size_t); // Makes room for a number of entries without growing again
+		size_t size() const { return count; } // Returns the number of entries
+		size_t capacity() const { return cap; } // Returns the number of slots
+		double loadFactor() const { return cap == 0 ? 0.0 : (double) count / cap; } // Returns the fraction of slots that are full
+		size_t bytesReserved() const { return cap * (sizeof(int8_t) + sizeof(Entry)); } // Returns the number of bytes held by both arrays
+};
+
+#include "HashTable.tpp"
+#endif
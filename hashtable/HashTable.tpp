@@ -0,0 +1,310 @@
+/*
+	Implementation of a SwissTable-style hash table. This implements the methods described in
+	the header file.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include <cstring>
+#include <new>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Default constructor; an empty table that allocates nothing until the first insert
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+HashTable<Key, Value, Hash, KeyEqual, Allocator> :: HashTable() : ctrl(NULL), slots(NULL), cap(0), count(0), growthLeft(0)
+{
+}
+
+// Constructor with room reserved for a number of entries
+// Input: Size - Entries to reserve room for, Hash - Hash function, KeyEqual - Key equality, Allocator - Allocator
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+HashTable<Key, Value, Hash, KeyEqual, Allocator> :: HashTable(size_t n, const Hash& h, const KeyEqual& eq, const Allocator& a)
+	: ctrl(NULL), slots(NULL), cap(0), count(0), growthLeft(0), hasher(h), equal(eq), ctrlAlloc(a), entryAlloc(a)
+{
+	reserve(n);
+}
+
+// Destructor; destroys every entry and frees both arrays
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+HashTable<Key, Value, Hash, KeyEqual, Allocator> :: ~HashTable()
+{
+	release();
+}
+
+// Move constructor; takes over the arrays of another table, leaving it empty
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+HashTable<Key, Value, Hash, KeyEqual, Allocator> :: HashTable(HashTable&& o) noexcept
+	: ctrl(o.ctrl), slots(o.slots), cap(o.cap), count(o.count), growthLeft(o.growthLeft), hasher(move(o.hasher)), equal(move(o.equal)),
+	  ctrlAlloc(move(o.ctrlAlloc)), entryAlloc(move(o.entryAlloc))
+{
+	o.ctrl = NULL;
+	o.slots = NULL;
+	o.cap = o.count = o.growthLeft = 0;
+}
+
+// Move assignment; frees this table's entries and takes over those of another
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+HashTable<Key, Value, Hash, KeyEqual, Allocator>& HashTable<Key, Value, Hash, KeyEqual, Allocator> :: operator=(HashTable&& o) noexcept
+{
+	if (this != &o)
+	{
+		release();
+		ctrl = o.ctrl;
+		slots = o.slots;
+		cap = o.cap;
+		count = o.count;
+		growthLeft = o.growthLeft;
+		hasher = move(o.hasher);
+		equal = move(o.equal);
+		ctrlAlloc = move(o.ctrlAlloc);
+		entryAlloc = move(o.entryAlloc);
+		o.ctrl = NULL;
+		o.slots = NULL;
+		o.cap = o.count = o.growthLeft = 0;
+	}
+	return *this;
+}
+
+/* PROBING METHODS */
+// Spreads the bits of a hash with a 64x64->128-bit multiply folded back to 64 bits, so that
+// both the group index (high bits) and the control byte (low 7 bits) depend on every input bit.
+// Input: uint64_t - Hash returned by the hash function
+// Output: uint64_t - Mixed hash
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+uint64_t HashTable<Key, Value, Hash, KeyEqual, Allocator> :: mix(uint64_t h)
+{
+	unsigned __int128 m = (unsigned __int128) h * 0x9e3779b97f4a7c15ULL;
+	return (uint64_t) m ^ (uint64_t) (m >> 64);
+}
+
+// Compares all 16 control bytes of a group against one value.
+// Input: int8_t pointer - First control byte of the group, int8_t - Value to look for
+// Output: uint32_t - Bit i is set if slot i of the group holds the value
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+uint32_t HashTable<Key, Value, Hash, KeyEqual, Allocator> :: matchByte(const int8_t* group, int8_t b)
+{
+#if defined(__SSE2__)
+	__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+	return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(b)));
+#else
+	uint32_t mask = 0;
+	for (size_t i = 0; i < GROUP; i++)
+		mask |= (uint32_t) (group[i] == b) << i;
+	return mask;
+#endif
+}
+
+// Finds the slots of a group that can take a new entry. Empty and deleted are the only
+// control bytes with the sign bit set, so this is just the sign bits of the group.
+// Input: int8_t pointer - First control byte of the group
+// Output: uint32_t - Bit i is set if slot i of the group is empty or deleted
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+uint32_t HashTable<Key, Value, Hash, KeyEqual, Allocator> :: matchFree(const int8_t* group)
+{
+#if defined(__SSE2__)
+	return (uint32_t) _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group)));
+#else
+	uint32_t mask = 0;
+	for (size_t i = 0; i < GROUP; i++)
+		mask |= (uint32_t) (group[i] < 0) << i;
+	return mask;
+#endif
+}
+
+// Walks the probe sequence of a key, one group at a time, comparing the key against the slots
+// whose control byte matches its H2. The walk ends at the first group with an empty slot:
+// the key would have been placed there or earlier.
+// Input: Key - Key to look for, uint64_t - Mixed hash of the key
+// Output: Size - Slot holding the key (NPOS if absent)
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+template <class K>
+size_t HashTable<Key, Value, Hash, KeyEqual, Allocator> :: locate(const K& k, uint64_t h) const
+{
+	if (cap == 0)
+		return NPOS;
+	size_t groups = cap / GROUP;
+	size_t g = (h >> 7) & (groups - 1);
+	int8_t h2 = (int8_t) (h & 0x7f);
+	for (size_t step = 1; ; step++)
+	{
+		const int8_t* group = ctrl + g * GROUP;
+		for (uint32_t mask = matchByte(group, h2); mask != 0; mask &= mask - 1)
+		{
+			size_t pos = g * GROUP + __builtin_ctz(mask);
+			if (equal(slots[pos].key, k))
+				return pos;
+		}
+		if (matchByte(group, EMPTY) != 0 || step > groups) // The key would have stopped here
+			return NPOS;
+		g = (g + step) & (groups - 1); // Triangular steps visit every group of a power-of-two table
+	}
+}
+
+// Walks the probe sequence of a hash to the first slot that can take a new entry.
+// Input: uint64_t - Mixed hash of the key to place
+// Output: Size - First empty or deleted slot (the table must not be full)
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+size_t HashTable<Key, Value, Hash, KeyEqual, Allocator> :: freeSlot(uint64_t h) const
+{
+	size_t groups = cap / GROUP;
+	size_t g = (h >> 7) & (groups - 1);
+	for (size_t step = 1; ; step++)
+	{
+		uint32_t mask = matchFree(ctrl + g * GROUP);
+		if (mask != 0)
+			return g * GROUP + __builtin_ctz(mask);
+		g = (g + step) & (groups - 1);
+	}
+}
+
+/* INSERT METHODS */
+// Adds an entry for a key, unless the key is already present. A new entry goes into the first
+// free slot of its probe sequence, reusing a tombstone if it meets one first; filling an
+// empty slot when none are left to spare grows the table.
+// Input: Key - Key to insert, Value - Value to store with it
+// Output: Pair - Entry of the key, and true if it was added by this call
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+pair<typename HashTable<Key, Value, Hash, KeyEqual, Allocator>::Entry*, bool> HashTable<Key, Value, Hash, KeyEqual, Allocator> :: insert(const Key& k, const Value& v)
+{
+	uint64_t h = mix(hasher(k));
+	size_t pos = locate(k, h);
+	if (pos != NPOS)
+		return {&slots[pos], false};
+	if (cap == 0)
+		rehash(GROUP);
+	pos = freeSlot(h);
+	if (ctrl[pos] == EMPTY && growthLeft == 0) // Out of spare empty slots: drop the tombstones, and double unless they were most of the load
+	{
+		rehash(count < maxLoad(cap) / 2 ? cap : cap * 2);
+		pos = freeSlot(h);
+	}
+	if (ctrl[pos] == EMPTY)
+		growthLeft--;
+	new (&slots[pos]) Entry{k, v};
+	ctrl[pos] = (int8_t) (h & 0x7f);
+	count++;
+	return {&slots[pos], true};
+}
+
+// Moves every entry into a fresh pair of arrays of a given capacity, leaving no tombstones.
+// Input: Size - New number of slots (a power of two of at least GROUP, enough for every entry)
+// Output: None
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator> :: rehash(size_t newCap)
+{
+	int8_t* oldCtrl = ctrl;
+	Entry* oldSlots = slots;
+	size_t oldCap = cap;
+	ctrl = allocator_traits<CtrlAllocator>::allocate(ctrlAlloc, newCap);
+	slots = allocator_traits<EntryAllocator>::allocate(entryAlloc, newCap);
+	memset(ctrl, EMPTY, newCap);
+	cap = newCap;
+	growthLeft = maxLoad(newCap) - count;
+	for (size_t i = 0; i < oldCap; i++)
+		if (oldCtrl[i] >= 0)
+		{
+			uint64_t h = mix(hasher(oldSlots[i].key));
+			size_t pos = freeSlot(h); // Every key is distinct, so no need to look for it first
+			new (&slots[pos]) Entry(move(oldSlots[i]));
+			oldSlots[i].~Entry();
+			ctrl[pos] = (int8_t) (h & 0x7f);
+		}
+	if (oldCap > 0)
+	{
+		allocator_traits<CtrlAllocator>::deallocate(ctrlAlloc, oldCtrl, oldCap);
+		allocator_traits<EntryAllocator>::deallocate(entryAlloc, oldSlots, oldCap);
+	}
+}
+
+/* ERASE METHODS */
+// Removes the entry of a key. The slot becomes empty again if its group still has an empty
+// slot, since no probe can then have passed through the group; otherwise it becomes a
+// tombstone, so that probes for keys placed further along keep going.
+// Input: Key - Key to remove
+// Output: Bool - True if the key was present
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+template <class K>
+bool HashTable<Key, Value, Hash, KeyEqual, Allocator> :: eraseKey(const K& k)
+{
+	size_t pos = locate(k, mix(hasher(k)));
+	if (pos == NPOS)
+		return false;
+	slots[pos].~Entry();
+	if (matchByte(ctrl + pos / GROUP * GROUP, EMPTY) != 0)
+	{
+		ctrl[pos] = EMPTY;
+		growthLeft++;
+	}
+	else
+		ctrl[pos] = DELETED;
+	count--;
+	return true;
+}
+
+// Removes every entry and frees both arrays.
+// Input: None
+// Output: None
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator> :: clear()
+{
+	release();
+	ctrl = NULL;
+	slots = NULL;
+	cap = count = growthLeft = 0;
+}
+
+// Destroys every entry and frees both arrays, leaving the members dangling.
+// Input: None
+// Output: None
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator> :: release()
+{
+	if (cap == 0)
+		return;
+	if constexpr (!is_trivially_destructible_v<Entry>)
+		for (size_t i = 0; i < cap; i++)
+			if (ctrl[i] >= 0)
+				slots[i].~Entry();
+	allocator_traits<CtrlAllocator>::deallocate(ctrlAlloc, ctrl, cap);
+	allocator_traits<EntryAllocator>::deallocate(entryAlloc, slots, cap);
+}
+
+/* FIND METHODS */
+// Finds the entry of a key.
+// Input: Key - Key to look for
+// Output: Entry pointer - Entry of the key (NULL if absent)
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+typename HashTable<Key, Value, Hash, KeyEqual, Allocator>::Entry* HashTable<Key, Value, Hash, KeyEqual, Allocator> :: find(const Key& k)
+{
+	size_t pos = locate(k, mix(hasher(k)));
+	return pos == NPOS ? NULL : &slots[pos];
+}
+
+// Calls a function on every entry, in slot order (which is unrelated to key order).
+// Input: Visit - Callable taking an Entry reference
+// Output: None
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+template <class Visit>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator> :: forEach(Visit visit)
+{
+	for (size_t i = 0; i < cap; i++)
+		if (ctrl[i] >= 0)
+			visit(slots[i]);
+}
+
+/* CAPACITY METHODS */
+// Grows the table so that a number of entries fit without any further growth.
+// Input: Size - Number of entries to make room for
+// Output: None
+template <class Key, class Value, class Hash, class KeyEqual, class Allocator>
+void HashTable<Key, Value, Hash, KeyEqual, Allocator> :: reserve(size_t n)
+{
+	size_t c = GROUP;
+	while (maxLoad(c) < n)
+		c *= 2;
+	if (c > cap)
+		rehash(c);
+}
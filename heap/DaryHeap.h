@@ -0,0 +1,103 @@
+/*
+	Implementation of a d-ary heap, usable as a priority queue with decrease-key. This is the
+	header file that provides class/method definitions.
+
+	The heap is a class template over the element type, the comparator (the heap keeps the
+	smallest element under it on top, like a min-heap under less<T>) and the arity D, fixed at
+	compile time and 4 by default. The elements sit in one contiguous array in level order, with
+	the children of position i at D * i + 1 to D * i + D. A wider node makes the tree shallower
+	(log_D n levels), so pushes and decrease-keys, which sift up, touch fewer positions; pops,
+	which sift down, compare D children per level, but the children are adjacent in memory, so
+	each level costs about one cache miss instead of one per comparison.
+
+	push() returns a handle that keeps naming its element as the element moves through the
+	array. decreaseKey() and erase() take a handle, and contains() tells whether a handle's
+	element is still in the heap. Handles are small integers, recycled once their element
+	leaves; a table maps each one to its element's current position, and every move in the
+	array updates it.
+
+	assign() (and the range constructor) builds a heap from a range in O(n) with Floyd's
+	bottom-up heapify instead of n pushes. The element at offset i of the range gets handle i.
+
+	Comparisons are counted by the hooks of ../common/Stats.h when the heap is compiled with
+	DS_STATS, and cost nothing otherwise.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef DARYHEAP_H
+#define DARYHEAP_H
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../common/Stats.h"
+using namespace std;
+
+template <class T, class Compare = less<T>, unsigned D = 4>
+class DaryHeap
+{
+	static_assert(D >= 2, "DaryHeap: the arity must be at least 2");
+
+	public:
+		typedef uint32_t Handle; // Names an element for as long as it is in the heap
+
+	private:
+		static constexpr uint32_t FREE = uint32_t(1) << 31; // Set in the slot of a handle not in use, whose low bits link to the next one
+		static constexpr uint32_t NO_HANDLE = FREE - 1; // Ends the free list; never handed out
+
+		vector<T> items; // Elements in heap order
+		vector<Handle> owners; // owners[i]: handle of items[i], kept apart so the sifts scan only elements
+		vector<uint32_t> slots; // slots[h]: position of handle h in items, or FREE plus the next free handle
+		uint32_t freeHandles; // First handle not in use (NO_HANDLE if none)
+		[[no_unique_address]] Compare comp; // Ordering of the elements
+
+		bool before(const T& a, const T& b) { Stats::comparison(); return comp(a, b); } // Returns whether a belongs above b
+		Handle newHandle(size_t); // Takes a free handle (or a new one) for the element at a position
+		void freeHandle(Handle); // Puts a handle back on the free list
+		void place(size_t, T&&, Handle); // Stores an element and its handle at a position and records the position
+		void siftUp(size_t); // Moves the element at a position up until its parent is not after it
+		void siftDown(size_t); // Moves the element at a position down until no child is before it
+		void removeAt(size_t); // Removes the element at a position, filling the gap with the last element
+
+	public:
+		// Constructors
+		DaryHeap();
+		explicit DaryHeap(const Compare&);
+		template <class InputIt>
+		DaryHeap(InputIt, InputIt, const Compare& = Compare()); // Heapifies the elements of a range
+
+		// Insert methods
+		Handle push(const T&); // Adds an element, returning its handle
+		Handle push(T&&);
+		template <class InputIt>
+		void assign(InputIt, InputIt); // Replaces the contents with the elements of a range, heapified in O(n)
+
+		// Remove methods
+		T pop(); // Removes the top element and returns it (throws runtime_error if empty)
+		void erase(Handle); // Removes the element of a handle (throws runtime_error if it is not in the heap)
+		void clear(); // Removes every element and frees every handle, keeping the memory
+
+		// Update methods
+		void decreaseKey(Handle, const T&); // Moves an element towards the top by giving it a value that is not after the old one
+		void update(Handle, const T&); // Gives an element any new value, moving it up or down
+
+		// Accessors
+		const T& top(); // Returns the top element (throws runtime_error if empty)
+		Handle topHandle(); // Returns the handle of the top element (throws runtime_error if empty)
+		const T& value(Handle h) { return items[slots[h]]; } // Returns the element of a handle (which must be in the heap)
+		bool contains(Handle h) { return h < slots.size() && (slots[h] & FREE) == 0; } // Returns whether a handle's element is in the heap
+		size_t size() { return items.size(); } // Returns the number of elements
+		bool empty() { return items.empty(); } // Returns whether the heap is empty
+		void reserve(size_t); // Makes room for a number of elements without reallocating
+		size_t bytesReserved() { return items.capacity() * sizeof(T) + (owners.capacity() + slots.capacity()) * sizeof(uint32_t); } // Returns the number of bytes held by the arrays
+		bool isHeap(); // Checks the heap order and the handle table, for tests
+};
+
+#include "DaryHeap.tpp"
+#endif
@@ -0,0 +1,331 @@
+/*
+	Implementation of a d-ary heap. This implements the methods described in the header file.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+// Default constructor; an empty heap
+template <class T, class Compare, unsigned D>
+DaryHeap<T, Compare, D> :: DaryHeap() : freeHandles(NO_HANDLE)
+{
+}
+
+// Empty heap ordered by a given comparator
+// Input: Compare - Ordering of the elements
+template <class T, class Compare, unsigned D>
+DaryHeap<T, Compare, D> :: DaryHeap(const Compare& c) : freeHandles(NO_HANDLE), comp(c)
+{
+}
+
+// Heapifies the elements of a range (see assign).
+// Input: Iterators - Range of elements, Compare - Ordering of the elements
+template <class T, class Compare, unsigned D>
+template <class InputIt>
+DaryHeap<T, Compare, D> :: DaryHeap(InputIt first, InputIt last, const Compare& c) : freeHandles(NO_HANDLE), comp(c)
+{
+	assign(first, last);
+}
+
+/* HANDLE METHODS */
+// Takes the first free handle, or a new one if none is free, for the element at a position.
+// Input: Size - Position of the element
+// Output: Handle - Handle now naming the element
+template <class T, class Compare, unsigned D>
+typename DaryHeap<T, Compare, D>::Handle DaryHeap<T, Compare, D> :: newHandle(size_t pos)
+{
+	Handle h;
+	if (freeHandles != NO_HANDLE)
+	{
+		h = freeHandles;
+		freeHandles = slots[h] & ~FREE;
+	}
+	else
+	{
+		if (slots.size() >= NO_HANDLE)
+			throw length_error("DaryHeap: handle space exhausted");
+		h = (Handle) slots.size();
+		slots.push_back(0);
+		Stats::allocation(1, 0);
+	}
+	slots[h] = (uint32_t) pos;
+	return h;
+}
+
+// Puts a handle whose element has left the heap back on the free list. Its slot keeps the next
+// free handle in the low bits.
+// Input: Handle - Handle to free
+// Output: None
+template <class T, class Compare, unsigned D>
+void DaryHeap<T, Compare, D> :: freeHandle(Handle h)
+{
+	slots[h] = FREE | freeHandles;
+	freeHandles = h;
+}
+
+/* SIFT METHODS */
+// Stores an element and its handle at a position and records the position in the handle's slot.
+// Input: Size - Position, Element - Element to store, Handle - Its handle
+// Output: None
+template <class T, class Compare, unsigned D>
+void DaryHeap<T, Compare, D> :: place(size_t pos, T&& x, Handle h)
+{
+	items[pos] = move(x);
+	owners[pos] = h;
+	slots[h] = (uint32_t) pos;
+}
+
+// Moves the element at a position up while it belongs above its parent. The element is held
+// aside and the parents passed are shifted down into the hole, so each level costs one move.
+// Input: Size - Position of the element
+// Output: None
+template <class T, class Compare, unsigned D>
+void DaryHeap<T, Compare, D> :: siftUp(size_t pos)
+{
+	T x = move(items[pos]);
+	Handle h = owners[pos];
+	while (pos > 0)
+	{
+		size_t parent = (pos - 1) / D;
+		if (!before(x, items[parent]))
+			break;
+		place(pos, move(items[parent]), owners[parent]);
+		pos = parent;
+	}
+	place(pos, move(x), h);
+}
+
+// Moves the element at a position down while one of its children belongs above it, each time
+// trading places with the child that comes first. The D children are adjacent, so finding it
+// reads one or two cache lines.
+// Input: Size - Position of the element
+// Output: None
+template <class T, class Compare, unsigned D>
+void DaryHeap<T, Compare, D> :: siftDown(size_t pos)
+{
+	size_t n = items.size();
+	T x = move(items[pos]);
+	Handle h = owners[pos];
+	while (true)
+	{
+		size_t child = D * pos + 1;
+		if (child >= n)
+			break;
+		size_t end = child + D < n ? child + D : n;
+		size_t best = child;
+		const T *first = &items[child];
+		for (size_t c = child + 1; c < end; c++)
+		{
+			bool b = before(items[c], *first); // Selects without a branch, as the outcome is random
+			best = b ? c : best;
+			first = b ? &items[c] : first;
+		}
+		if (!before(*first, x))
+			break;
+		place(pos, move(items[best]), owners[best]);
+		pos = best;
+	}
+	place(pos, move(x), h);
+}
+
+// Removes the element at a position. The last element fills the gap and is sifted whichever
+// way it belongs.
+// Input: Size - Position of the element
+// Output: None
+template <class T, class Compare, unsigned D>
+void DaryHeap<T, Compare, D> :: removeAt(size_t pos)
+{
+	freeHandle(owners[pos]);
+	size_t last = items.size() - 1;
+	if (pos != last)
+	{
+		place(pos, move(items[last]), owners[last]);
+		items.pop_back();
+		owners.pop_back();
+		if (pos > 0 && before(items[pos], items[(pos - 1) / D]))
+			siftUp(pos);
+		else
+			siftDown(pos);
+	}
+	else
+	{
+		items.pop_back();
+		owners.pop_back();
+	}
+}
+
+/* INSERT METHODS */
+// Adds an element at the end of the array and sifts it up.
+// Input: Element to add
+// Output: Handle - Handle naming the element
+template <class T, class Compare, unsigned D>
+typename DaryHeap<T, Compare, D>::Handle DaryHeap<T, Compare, D> :: push(const T& x)
+{
+	return push(T(x));
+}
+
+template <class T, class Compare, unsigned D>
+typename DaryHeap<T, Compare, D>::Handle DaryHeap<T, Compare, D> :: push(T&& x)
+{
+	size_t pos = items.size();
+	Handle h = newHandle(pos);
+	items.push_back(move(x));
+	owners.push_back(h);
+	siftUp(pos);
+	return h;
+}
+
+// Replaces the contents with the elements of a range using Floyd's heapify: the elements are
+// copied in as they are, then every parent is sifted down, from the last one back to the root.
+// Most elements sit near the bottom and move at most a level or two, so this takes O(n) time.
+// Every old handle is freed, and the element at offset i of the range gets handle i.
+// Input: Iterators - Range of elements
+// Output: None
+template <class T, class Compare, unsigned D>
+template <class InputIt>
+void DaryHeap<T, Compare, D> :: assign(InputIt first, InputIt last)
+{
+	clear();
+	if constexpr (is_base_of_v<random_access_iterator_tag, typename iterator_traits<InputIt>::iterator_category>)
+		reserve((size_t) distance(first, last));
+	for (; first != last; ++first)
+	{
+		if (items.size() >= NO_HANDLE)
+			throw length_error("DaryHeap: handle space exhausted");
+		Handle h = (Handle) items.size();
+		items.push_back(*first);
+		owners.push_back(h);
+		slots.push_back(h);
+	}
+	Stats::allocation(items.size(), 0);
+	for (size_t i = items.size() / D + 1; i-- > 0; )
+		if (D * i + 1 < items.size())
+			siftDown(i);
+}
+
+/* REMOVE METHODS */
+// Removes the top element, freeing its handle.
+// Input: None
+// Output: Element that was on top (throws runtime_error if the heap is empty)
+template <class T, class Compare, unsigned D>
+T DaryHeap<T, Compare, D> :: pop()
+{
+	if (items.empty())
+		throw runtime_error("DaryHeap: pop from an empty heap");
+	T x = move(items[0]);
+	removeAt(0);
+	return x;
+}
+
+// Removes the element of a handle, wherever it is in the heap.
+// Input: Handle - Handle of the element
+// Output: None (throws runtime_error if the handle's element is not in the heap)
+template <class T, class Compare, unsigned D>
+void DaryHeap<T, Compare, D> :: erase(Handle h)
+{
+	if (!contains(h))
+		throw runtime_error("DaryHeap: erase of a handle not in the heap");
+	removeAt(slots[h]);
+}
+
+// Removes every element and frees every handle. The arrays keep their memory.
+// Input: None
+// Output: None
+template <class T, class Compare, unsigned D>
+void DaryHeap<T, Compare, D> :: clear()
+{
+	items.clear();
+	owners.clear();
+	slots.clear();
+	freeHandles = NO_HANDLE;
+}
+
+/* UPDATE METHODS */
+// Gives an element a value that does not belong below its old one and sifts it up. Only the
+// path to the root is touched, so with a wider node this costs log_D n moves.
+// Input: Handle - Handle of the element, Element - New value
+// Output: None (throws runtime_error if the handle is not in the heap or the value belongs below the old one)
+template <class T, class Compare, unsigned D>
+void DaryHeap<T, Compare, D> :: decreaseKey(Handle h, const T& x)
+{
+	if (!contains(h))
+		throw runtime_error("DaryHeap: decreaseKey of a handle not in the heap");
+	size_t pos = slots[h];
+	if (before(items[pos], x))
+		throw runtime_error("DaryHeap: decreaseKey would move an element down");
+	items[pos] = x;
+	siftUp(pos);
+}
+
+// Gives an element any new value, sifting it up or down as the value requires.
+// Input: Handle - Handle of the element, Element - New value
+// Output: None (throws runtime_error if the handle is not in the heap)
+template <class T, class Compare, unsigned D>
+void DaryHeap<T, Compare, D> :: update(Handle h, const T& x)
+{
+	if (!contains(h))
+		throw runtime_error("DaryHeap: update of a handle not in the heap");
+	size_t pos = slots[h];
+	bool up = before(x, items[pos]);
+	items[pos] = x;
+	if (up)
+		siftUp(pos);
+	else
+		siftDown(pos);
+}
+
+/* ACCESSORS */
+// Returns the top element, the first under the comparator.
+// Input: None
+// Output: Reference to the top element (throws runtime_error if the heap is empty)
+template <class T, class Compare, unsigned D>
+const T& DaryHeap<T, Compare, D> :: top()
+{
+	if (items.empty())
+		throw runtime_error("DaryHeap: top of an empty heap");
+	return items[0];
+}
+
+// Returns the handle of the top element.
+// Input: None
+// Output: Handle (throws runtime_error if the heap is empty)
+template <class T, class Compare, unsigned D>
+typename DaryHeap<T, Compare, D>::Handle DaryHeap<T, Compare, D> :: topHandle()
+{
+	if (items.empty())
+		throw runtime_error("DaryHeap: top of an empty heap");
+	return owners[0];
+}
+
+// Makes room for a number of elements (and their handles) without reallocating.
+// Input: Size - Number of elements
+// Output: None
+template <class T, class Compare, unsigned D>
+void DaryHeap<T, Compare, D> :: reserve(size_t n)
+{
+	items.reserve(n);
+	owners.reserve(n);
+	slots.reserve(n);
+}
+
+// Checks that no element belongs above its parent, that every element's handle points back at
+// its position, and that exactly the handles of the elements are in use.
+// Input: None
+// Output: Bool - True if the heap is consistent
+template <class T, class Compare, unsigned D>
+bool DaryHeap<T, Compare, D> :: isHeap()
+{
+	size_t used = 0;
+	for (size_t h = 0; h < slots.size(); h++)
+		used += (slots[h] & FREE) == 0;
+	if (used != items.size())
+		return false;
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		if (owners[i] >= slots.size() || slots[owners[i]] != i)
+			return false;
+		if (i > 0 && comp(items[i], items[(i - 1) / D]))
+			return false;
+	}
+	return true;
+}
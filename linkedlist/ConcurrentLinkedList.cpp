@@ -0,0 +1,195 @@
+/*
+    Implementation of a lock-free singly linked list of integers. This implements the methods
+    described in the header file.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "ConcurrentLinkedList.h"
+#include "../common/Epoch.h"
+#include "../common/Stats.h"
+#include <algorithm>
+#include <charconv>
+using namespace std;
+
+// Default constructor sets head to NULL
+ConcurrentLinkedList :: ConcurrentLinkedList()
+{
+    head.store(0, memory_order_relaxed);
+}
+
+// Destructor frees every Node still linked. Nodes already unlinked belong to the epoch
+// reclamation and are freed by it.
+ConcurrentLinkedList :: ~ConcurrentLinkedList()
+{
+    Node *curr = pointer(head.load(memory_order_acquire));
+    while (curr != NULL)
+    {
+        Node *next = pointer(curr->next.load(memory_order_relaxed));
+        delete curr;
+        curr = next;
+    }
+}
+
+/* INSERT METHODS */
+// Inserts a new node at the head of the list, retrying the swap of the head until no other
+// insert or remove has changed it in between.
+// Input: Int - to be inserted into the list as a node
+// Output: None
+void ConcurrentLinkedList :: insert(int x)
+{
+    Node *n = new Node;
+    Stats::allocation(1, sizeof(Node));
+    n->data = x;
+    uintptr_t first = head.load(memory_order_relaxed);
+    do
+        n->next.store(first, memory_order_relaxed);
+    while (!head.compare_exchange_weak(first, reinterpret_cast<uintptr_t>(n), memory_order_release, memory_order_relaxed));
+}
+
+/* REMOVE METHODS */
+// Walks the list from the head to the first unremoved Node holding a value. Every removed
+// Node passed on the way is unlinked from its predecessor and retired. If the predecessor
+// changed under the walk (it was removed itself, or another thread unlinked the same Node
+// first), the walk starts over from the head. Must run inside an Epoch::Guard.
+// Input: Int - Value to look for, Node pointer reference - Set to the Node found (NULL if none)
+// Output: Atomic link pointer - The link that points to the Node found
+atomic<uintptr_t>* ConcurrentLinkedList :: search(int x, Node*& curr)
+{
+    retry:
+    atomic<uintptr_t> *prev = &head;
+    curr = pointer(prev->load(memory_order_acquire));
+    while (curr != NULL)
+    {
+        uintptr_t next = curr->next.load(memory_order_acquire);
+        if (marked(next)) // curr is removed, so unlink it
+        {
+            uintptr_t expected = reinterpret_cast<uintptr_t>(curr);
+            if (!prev->compare_exchange_strong(expected, next & ~uintptr_t(1), memory_order_acq_rel, memory_order_acquire))
+                goto retry;
+            Epoch::retire(curr);
+            curr = pointer(next);
+            continue;
+        }
+        if (curr->data == x)
+            return prev;
+        prev = &curr->next;
+        curr = pointer(next);
+    }
+    return prev;
+}
+
+// Removes the first occurrence of a value. The Node is marked first, which is when the remove
+// takes effect; whichever thread then swings the link past it (this one, or a later search)
+// retires it. A Node another thread marks first does not count, and the search resumes.
+// Input: Int - Value to remove
+// Output: Bool - True if this call removed the value
+bool ConcurrentLinkedList :: remove(int x)
+{
+    Epoch::Guard guard;
+    while (true)
+    {
+        Node *curr;
+        atomic<uintptr_t> *prev = search(x, curr);
+        if (curr == NULL)
+            return false;
+        uintptr_t next = curr->next.load(memory_order_acquire);
+        if (marked(next))
+            continue;
+        if (!curr->next.compare_exchange_strong(next, next | 1, memory_order_acq_rel, memory_order_relaxed))
+            continue; // Another remove marked it, or unlinked the Node after it
+        uintptr_t expected = reinterpret_cast<uintptr_t>(curr);
+        if (prev->compare_exchange_strong(expected, next, memory_order_acq_rel, memory_order_relaxed))
+            Epoch::retire(curr);
+        else
+            search(x, curr); // Another walk passes it; this one unlinks it unless it stops earlier
+        return true;
+    }
+}
+
+/* FIND METHODS */
+// Finds whether an unremoved Node holds a value. Unlike remove(), the walk only reads, so it
+// passes over removed Nodes without unlinking them.
+// Input: Data to be found
+// Output: Bool - True if the data is in the list
+bool ConcurrentLinkedList :: find(int x)
+{
+    Epoch::Guard guard;
+    Stats::beginLookup();
+    for (Node *curr = pointer(head.load(memory_order_acquire)); curr != NULL; )
+    {
+        Stats::visit();
+        uintptr_t next = curr->next.load(memory_order_acquire);
+        if (curr->data == x && !marked(next))
+        {
+            Stats::endLookup();
+            return true;
+        }
+        curr = pointer(next);
+    }
+    Stats::endLookup();
+    return false;
+}
+
+/* PRINT METHODS */
+// Prints list in order
+// Input: None
+// Output: A string that has all elements of the list in order (empty if the list is empty)
+string ConcurrentLinkedList :: print()
+{
+    string list_str;
+    auto sink = [&](const char* s, size_t n) { list_str.append(s, n); };
+    printTo(sink);
+    return list_str;
+}
+
+// Writes the list in order to a stream, in the same form as print().
+// Input: Ostream - Destination
+// Output: None
+void ConcurrentLinkedList :: print(ostream& out)
+{
+    auto sink = [&](const char* s, size_t n) { out.write(s, (streamsize) n); };
+    printTo(sink);
+}
+
+// Helper for both print() methods. Removed Nodes still linked are skipped.
+// Input: Sink - Callable taking a character pointer and a length
+// Output: None
+template <class Sink>
+void ConcurrentLinkedList :: printTo(Sink& sink)
+{
+    Epoch::Guard guard;
+    char buf[16]; // " -> " plus the longest int
+    bool first = true;
+    for (Node *curr = pointer(head.load(memory_order_acquire)); curr != NULL; )
+    {
+        uintptr_t next = curr->next.load(memory_order_acquire);
+        if (!marked(next))
+        {
+            char *p = buf;
+            if (!first) // Separate from the previous element
+                p = copy_n(" -> ", 4, p);
+            p = to_chars(p, buf + sizeof(buf), curr->data).ptr;
+            sink(buf, (size_t) (p - buf));
+            first = false;
+        }
+        curr = pointer(next);
+    }
+}
+
+// length(): Counts the unremoved Nodes of the list
+// Input: None
+// Output: int - length of list
+int ConcurrentLinkedList :: length()
+{
+    Epoch::Guard guard;
+    int length = 0;
+    for (Node *curr = pointer(head.load(memory_order_acquire)); curr != NULL; )
+    {
+        uintptr_t next = curr->next.load(memory_order_acquire);
+        length += !marked(next);
+        curr = pointer(next);
+    }
+    return length;
+}
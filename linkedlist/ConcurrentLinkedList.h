@@ -0,0 +1,68 @@
+/*
+    Implementation of a lock-free singly linked list of integers, for sharing one list between
+    threads without a mutex. This is the header file that provides class/method definitions.
+
+    The list follows Harris's design (with Michael's way of unlinking during traversal). Every
+    link is an atomic word whose lowest bit marks the node it belongs to as deleted. insert()
+    pushes a node at the head with one compare-and-swap. remove() first marks the next link of
+    the node it removes (the logical removal, which is the point at which the remove takes
+    effect) and then tries to swing its predecessor's link past it (the physical removal). A
+    traversal that meets a marked node swings the link past it itself, so a remove never waits
+    for another thread to finish one. A marked link can no longer be changed, so nothing is ever
+    linked behind a node that is being removed.
+
+    Unlinked nodes are freed through epoch-based reclamation (see ../common/Epoch.h): every
+    operation runs inside an Epoch::Guard, and the thread whose compare-and-swap unlinks a node
+    retires it. For this reason find() only reports whether a value is present; a pointer into
+    the list would not stay valid after the call.
+
+    insert(), find() and remove() are linearizable and lock-free. length() and print() walk the
+    list without stopping the other threads, so under concurrent updates they reflect each node
+    as it was when the walk reached it. The destructor must not run concurrently with any other
+    operation.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef CONCURRENTLIST_H
+#define CONCURRENTLIST_H
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+using namespace std;
+
+class ConcurrentLinkedList
+{
+    private:
+        // Node of the list
+        struct Node
+        {
+            int data; // Contains the actual data
+            atomic<uintptr_t> next; // Pointer to the next Node, with the lowest bit set once this Node is removed
+        };
+
+        atomic<uintptr_t> head; // Pointer to the first Node (never marked)
+
+        static Node* pointer(uintptr_t link) { return reinterpret_cast<Node*>(link & ~uintptr_t(1)); } // Strips the mark off a link
+        static bool marked(uintptr_t link) { return (link & 1) != 0; } // Returns whether a link belongs to a removed Node
+        atomic<uintptr_t>* search(int x, Node*& curr); // Finds the first unremoved Node holding the data, unlinking removed Nodes on the way
+        template <class Sink>
+        void printTo(Sink& sink); // Hands each formatted element to a sink, for both print() methods.
+
+    public:
+        ConcurrentLinkedList(); // Default constructor
+        ~ConcurrentLinkedList();
+        ConcurrentLinkedList(const ConcurrentLinkedList&) = delete;
+        ConcurrentLinkedList& operator=(const ConcurrentLinkedList&) = delete;
+
+        void insert(int x); // Insert data at the head of the list
+        bool remove(int x); // Removes the first occurrence of the data, returning whether it was present
+        bool find(int x); // Returns whether the data is in the list
+        string print(); // Returns a string of the list elements
+        void print(ostream& out); // Writes the list elements to a stream
+        int length(); // Returns length of the list
+};
+
+#endif
@@ -7,27 +7,135 @@
 */
 
 #include "LinkedList.h"
+#include "../common/Stats.h"
 #include <cstdlib>
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <algorithm>
+#include <charconv>
+#include <ostream>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 using namespace std;
 
 // Default constructor sets head to NULL
 LinkedList :: LinkedList()
 {
 	head = NULL;
+    count = 0;
+    carved = 0;
+    freeNodes = NULL;
+    sorted = false;
+    freeLanes = NO_LANE;
+    seed = 0x9e3779b97f4a7c15ULL;
 }
 
-// Inserts a new node at the head of the list.
+// Destructor frees every slab at once, and with them every Node
+LinkedList :: ~LinkedList()
+{
+    for (Node *slab : slabs)
+        delete[] slab;
+}
+
+/* NODE ALLOCATION */
+// Hands out a Node: a removed one if any, otherwise the next one of the slabs, allocating a
+// new slab once they are all carved.
+// Input: Int - Data for the Node
+// Output: Node* - Node holding the data (its next pointer is not set)
+Node* LinkedList :: newNode(int x)
+{
+    Node *n;
+    if (freeNodes != NULL)
+    {
+        n = freeNodes;
+        freeNodes = freeNodes->next;
+    }
+    else
+    {
+        if (carved == slabs.size() * SLAB_NODES) // Every slab is carved, so add one
+        {
+            slabs.push_back(new Node[SLAB_NODES]);
+            Stats::allocation(0, SLAB_NODES * sizeof(Node));
+        }
+        n = &slabs[carved / SLAB_NODES][carved % SLAB_NODES];
+        carved++;
+    }
+    Stats::allocation(1, 0);
+    n->data = x;
+    count++;
+    return n;
+}
+
+// Puts a removed Node on the free list.
+// Input: Node* - Node no longer in the list
+// Output: None
+void LinkedList :: freeNode(Node* n)
+{
+    n->next = freeNodes;
+    freeNodes = n;
+    count--;
+}
+
+// Builds a chain of new Nodes, carved one after the other so the chain runs through memory in
+// order.
+// Input: Size - Number of Nodes, Get - Callable returning the data of Node i,
+//        Node pointer reference - Set to the last Node (NULL if n is 0)
+// Output: Node* - First Node of the chain (NULL if n is 0), whose last Node links to NULL
+template <class Get>
+Node* LinkedList :: chain(size_t n, Get get, Node*& last)
+{
+    Node *first = NULL;
+    Node **tail = &first; // Link the next Node goes into
+    last = NULL;
+    for (size_t i = 0; i < n; i++)
+    {
+        last = newNode(get(i));
+        *tail = last;
+        tail = &last->next;
+    }
+    *tail = NULL;
+    return first;
+}
+
+// Inserts a new node at the head of the list. In sorted mode the node goes after the last
+// one smaller than it instead, found through the lanes, and gets a tower of lane entries
+// of random height, linked in after the last smaller entry of each lane.
 // Input: Int - to be inserted into the list as a node
 // Output: Void - only inserts new Node
 void LinkedList :: insert(int x)
 {
-    Node *n = new Node; // Initialize new node to contain the data
-    n->data = x; // Initialize data attribute
-    n->next = head; // Add to the list at the front
-    head = n;
+    Node *n = newNode(x); // Initialize new node to contain the data
+    if (!sorted)
+    {
+        n->next = head; // Add to the list at the front
+        head = n;
+        return;
+    }
+
+    uint32_t update[MAX_LANES]; // Last entry smaller than x in each lane
+    Node *pred = descend(x, update);
+    Node **link = (pred == NULL) ? &head : &pred->next;
+    n->next = *link;
+    *link = n;
+    int height = towerHeight();
+    while ((int) sentinels.size() < height) // The tower rises above every lane so far
+    {
+        addLane();
+        update[sentinels.size() - 1] = sentinels.back();
+    }
+    uint32_t below = NO_LANE;
+    for (int l = 0; l < height; l++)
+    {
+        below = newLane(Lane{x, lanes[update[l]].next, below, n});
+        lanes[update[l]].next = below;
+    }
 }
 
 // Finds a Node with the matching data, if it exists.
@@ -35,96 +143,623 @@ void LinkedList :: insert(int x)
 // Output: Node* a pointer to a Node containing the val, if it exists. Otherwise, returns NULL.
 Node* LinkedList :: find(int x)
 {
+    if (sorted)
+    {
+        Node *n = lowerBound(x);
+        return (n != NULL && n->data == x) ? n : NULL;
+    }
     Node *curr = head;
+    Stats::beginLookup();
     while (curr != NULL)
     {
+        Stats::visit();
+        Stats::comparison();
         // If the matching data is foumd, return a pointer to the Node that contains it.
         if (curr->data == x)
+        {
+            Stats::endLookup();
             return curr;
+        }
         curr = curr->next;
     }
 
+    Stats::endLookup();
     return NULL; // Data was not found throughout traversal, so return NULL
 }
 
-// Container method for sorting the list, starting from the head.
+// Removes the first Node holding the matching data, if it exists, and frees it. In sorted
+// mode that Node is found through the lanes, and its tower is unlinked from each lane: its
+// entry, if it has one, directly follows the last entry smaller than x.
+// Input: Data to be removed
+// Output: Bool - True if a Node was removed
+bool LinkedList :: remove(int x)
+{
+    if (sorted)
+    {
+        uint32_t update[MAX_LANES];
+        Node *pred = descend(x, update);
+        Node **link = (pred == NULL) ? &head : &pred->next;
+        Node *target = *link;
+        if (target == NULL || target->data != x)
+            return false;
+        for (size_t l = 0; l < sentinels.size(); l++)
+        {
+            uint32_t e = lanes[update[l]].next;
+            if (e == NO_LANE || lanes[e].node != target) // The tower is not this tall
+                break;
+            lanes[update[l]].next = lanes[e].next;
+            lanes[e].next = freeLanes;
+            freeLanes = e;
+        }
+        *link = target->next;
+        freeNode(target);
+        return true;
+    }
+    Node **link = &head; // The pointer that leads to curr
+    for (Node *curr = head; curr != NULL; link = &curr->next, curr = curr->next)
+        if (curr->data == x)
+        {
+            *link = curr->next;
+            freeNode(curr);
+            return true;
+        }
+    return false;
+}
+
+/* BULK METHODS */
+// Inserts every value of a span, leaving the list as inserting them one by one would. Outside
+// sorted mode the values become one chain, in reverse, put in front of the head. In sorted
+// mode a small batch is inserted value by value through the index; a large one is sorted as
+// an array, merged into the list in one pass, and the index rebuilt.
+// Input: Span - Values to insert
+// Output: None
+void LinkedList :: insertRange(span<const int> values)
+{
+    size_t n = values.size();
+    Node *last;
+    if (!sorted)
+    {
+        Node *first = chain(n, [&](size_t i) { return values[n - 1 - i]; }, last);
+        if (first != NULL)
+        {
+            last->next = head;
+            head = first;
+        }
+    }
+    else if (n * 16 < (size_t) count) // Cheaper than touching the whole list
+        for (int x : values)
+            insert(x);
+    else
+    {
+        vector<int> ordered(values.begin(), values.end());
+        std::sort(ordered.begin(), ordered.end());
+        head = merge(head, chain(n, [&](size_t i) { return ordered[i]; }, last));
+        buildIndex();
+    }
+}
+
+// Replaces the list with the values of a span, in the same order (in sorted mode, sorted).
+// The Nodes are carved from the start of the slabs again, so they end up contiguous.
+// Input: Span - Values of the new list
+// Output: None
+void LinkedList :: assign(span<const int> values)
+{
+    clear();
+    size_t n = values.size();
+    Node *last;
+    if (!sorted)
+        head = chain(n, [&](size_t i) { return values[i]; }, last);
+    else
+    {
+        vector<int> ordered(values.begin(), values.end());
+        std::sort(ordered.begin(), ordered.end());
+        head = chain(n, [&](size_t i) { return ordered[i]; }, last);
+        buildIndex();
+    }
+}
+
+// Removes every Node at once. The slabs are kept and carved again from the first, and the
+// free list is dropped, since every Node on it is in the slabs anyway.
 // Input: None
-// Output: None - only sorts the list.
+// Output: None
+void LinkedList :: clear()
+{
+    head = NULL;
+    count = 0;
+    carved = 0;
+    freeNodes = NULL;
+    if (sorted)
+        buildIndex(); // Leaves empty lanes
+}
+
+// Sorts the list in increasing order with a stable merge sort (see mergeSort).
+// Input: None
+// Output: None - only relinks the list.
 void LinkedList :: sort()
 {
-    sort(head);
+    if (!sorted) // Sorted mode keeps the list in order already
+        head = mergeSort(head);
 }
 
-// Sorts the list from starting Node through bubble sort.
-// Input: Pointer to the Node to start from
-// Output: Void - only mutates the list to run in order
-void LinkedList :: sort(Node* start)
+// Sorts the list in increasing order with an LSD radix sort on the int payload (see radixSort).
+// Input: None
+// Output: None - only relinks the list.
+void LinkedList :: radixSort()
 {
-    bool isSwapped; // Flag to track whether a pass involved any swaps
-    Node *a;
-    Node *b = NULL;
+    if (!sorted)
+        head = radixSort(head);
+}
 
-    if (start == NULL) // If list empty or has singleton element, do nothing
+// Sorts the list with several threads. The list is cut into one run per thread, the runs are
+// merge-sorted concurrently, and then merged pairwise, the merges of each round also running
+// concurrently. Short lists are sorted on the calling thread. The result is the same stable
+// order as sort().
+// Input: Unsigned - Number of threads to use
+// Output: None - only relinks the list.
+void LinkedList :: sortParallel(unsigned threads)
+{
+    if (sorted)
         return;
-    
-    do
+    int n = length();
+    threads = min<unsigned>(threads, (unsigned) (n / PARALLEL_GRAIN));
+    if (threads <= 1)
+    {
+        sort();
+        return;
+    }
+
+    vector<Node*> runs(threads);
+    Node *curr = head;
+    for (unsigned t = 0; t < threads; t++) // Cut the list into runs of nearly equal length
+    {
+        runs[t] = curr;
+        int len = n / threads + (t < n % threads ? 1 : 0);
+        for (int i = 1; i < len; i++)
+            curr = curr->next;
+        Node *next = curr->next;
+        curr->next = NULL;
+        curr = next;
+    }
+
+    // Runs a task for every index of a round, the first on this thread and the rest on workers.
+    auto forEach = [](unsigned count, auto task)
+    {
+        vector<thread> workers;
+        for (unsigned i = 1; i < count; i++)
+            workers.emplace_back(task, i);
+        task(0);
+        for (thread& w : workers)
+            w.join();
+    };
+    forEach(threads, [&runs](unsigned t) { runs[t] = mergeSort(runs[t]); });
+    for (unsigned width = 1; width < threads; width *= 2) // Each round halves the number of runs
+    {
+        unsigned pairs = (threads - width + 2 * width - 1) / (2 * width);
+        forEach(pairs, [&runs, width](unsigned p)
+        {
+            unsigned i = p * 2 * width;
+            runs[i] = merge(runs[i], runs[i + width]);
+        });
+    }
+    head = runs[0];
+}
+
+// Merges two sorted lists by relinking their nodes. On ties the node of the first list comes
+// first, so merging an earlier part of a list with a later one keeps equal elements in order.
+// Input: Pointers to the heads of two sorted lists (either may be NULL)
+// Output: Node* - Head of the merged list
+Node* LinkedList :: merge(Node* a, Node* b)
+{
+    Node *first = NULL;
+    Node **tail = &first; // Link the next node goes into
+    while (a != NULL && b != NULL)
+    {
+        Stats::comparison();
+        if (b->data < a->data) // Take from b only if it is strictly smaller, for stability
+        {
+            *tail = b;
+            b = b->next;
+        }
+        else
+        {
+            *tail = a;
+            a = a->next;
+        }
+        tail = &(*tail)->next;
+    }
+    *tail = (a != NULL) ? a : b;
+    return first;
+}
+
+// Bottom-up merge sort. Nodes are taken off the list one at a time and carried through a row
+// of bins, where bin i holds a sorted run of 2^i nodes: a new node merges with bin 0, the
+// result with bin 1 if that is full, and so on, like incrementing a binary counter. Runs are
+// merged while they are small and still in cache, no node is ever copied, and the only extra
+// space is the fixed row of 64 bins.
+// Input: Pointer to the head of a list
+// Output: Node* - Head of the sorted list
+Node* LinkedList :: mergeSort(Node* list)
+{
+    Node *bins[64] = {}; // bins[i] is NULL or a sorted run of 2^i nodes, earlier ones holding later nodes
+    int used = 0; // Bins in use, from 0
+    while (list != NULL)
+    {
+        Node *run = list;
+        list = list->next;
+        run->next = NULL;
+        int i = 0;
+        for (; i < used && bins[i] != NULL; i++) // Carry the run up while bins are full
+        {
+            run = merge(bins[i], run); // The bin holds earlier nodes, so it goes first
+            bins[i] = NULL;
+        }
+        if (i == used)
+            used++;
+        bins[i] = run;
+    }
+    Node *sorted = NULL;
+    for (int i = 0; i < used; i++) // Higher bins hold earlier nodes
+        sorted = merge(bins[i], sorted);
+    return sorted;
+}
+
+// LSD radix sort on the int payload, one byte per pass from the lowest. Each pass deals the
+// nodes into 256 buckets by relinking them and then chains the buckets back together, which is
+// stable, so after the last pass the list is fully sorted. The sign bit is flipped so negative
+// numbers order first. A first pass finds the bytes on which all elements agree, and those
+// are skipped.
+// Input: Pointer to the head of a list
+// Output: Node* - Head of the sorted list
+Node* LinkedList :: radixSort(Node* list)
+{
+    if (list == NULL)
+        return NULL;
+    auto bits = [](int x) { return (unsigned) x ^ 0x80000000u; };
+    unsigned differ = 0; // Bits on which some element differs from the first
+    for (Node *curr = list; curr != NULL; curr = curr->next)
+        differ |= bits(curr->data) ^ bits(list->data);
+
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        if (((differ >> shift) & 0xFF) == 0) // Every element has the same byte here
+            continue;
+        Node *heads[256] = {}, *tails[256];
+        for (Node *curr = list; curr != NULL; curr = curr->next) // Earlier nodes' links are rewritten only after they are passed
+        {
+            unsigned b = (bits(curr->data) >> shift) & 0xFF;
+            if (heads[b] == NULL)
+                heads[b] = curr;
+            else
+                tails[b]->next = curr;
+            tails[b] = curr;
+        }
+        Node *tail = NULL;
+        for (int b = 0; b < 256; b++) // Chain the buckets in order
+            if (heads[b] != NULL)
+            {
+                if (tail == NULL)
+                    list = heads[b];
+                else
+                    tail->next = heads[b];
+                tail = tails[b];
+            }
+        tail->next = NULL;
+    }
+    return list;
+}
+
+/* SORTED MODE */
+// Enters or leaves sorted mode. Entering sorts the list (see sort()) and builds the lanes
+// over it; leaving drops the lanes and returns insert() to the head.
+// Input: Bool - True for sorted mode
+// Output: None
+void LinkedList :: setSorted(bool on)
+{
+    if (on == sorted)
+        return;
+    if (on)
+    {
+        head = mergeSort(head);
+        buildIndex();
+    }
+    else
     {
-        isSwapped = false; // No swaps yet
-        a = start;
+        lanes.clear();
+        lanes.shrink_to_fit();
+        sentinels.clear();
+        freeLanes = NO_LANE;
+    }
+    sorted = on;
+}
 
-        while (a->next != b) // Traverse the list
+// Finds the first Node whose data is not less than a value. In sorted mode this descends the
+// lanes; otherwise it scans the whole list for the smallest such data.
+// Input: Int - Value to compare against
+// Output: Node* - First Node (in sorted mode) or Node with the smallest data not less than x, or NULL
+Node* LinkedList :: lowerBound(int x)
+{
+    Stats::beginLookup();
+    Node *found = NULL;
+    if (sorted)
+    {
+        Node *pred = descend(x, NULL);
+        found = (pred == NULL) ? head : pred->next;
+    }
+    else
+        for (Node *curr = head; curr != NULL; curr = curr->next)
         {
-            if (a->data > a->next->data) // Check if Node a ranks higher than its successor
+            Stats::visit();
+            Stats::comparison();
+            if (curr->data >= x && (found == NULL || curr->data < found->data))
+                found = curr;
+        }
+    Stats::endLookup();
+    return found;
+}
+
+// Descends the lanes to the last Node smaller than a value. Each lane is followed while its
+// next entry is smaller than x, then the search drops to the lane below; from the entry
+// reached in the lowest lane, the Node chain is walked the rest of the way. With a quarter of
+// the entries of each lane promoted to the next, every lane takes about four steps.
+// Input: Int - Value to look for, uint32_t pointer - Filled with the last entry smaller than x
+//        in each lane, lowest first (or NULL)
+// Output: Node* - Last Node whose data is smaller than x (NULL if there is none)
+Node* LinkedList :: descend(int x, uint32_t* update)
+{
+    Node *pred = NULL;
+    if (!sentinels.empty())
+    {
+        uint32_t e = sentinels.back();
+        for (int l = (int) sentinels.size() - 1; l >= 0; l--)
+        {
+            for (uint32_t next = lanes[e].next; next != NO_LANE && lanes[next].key < x; next = lanes[e].next)
             {
-                swap(a, a->next); // Swap the data of the nodes to sort them
-                isSwapped = true; // A swap has been done, so this is now true
+                Stats::visit();
+                Stats::comparison();
+                e = next;
             }
-            a = a->next;
+            if (update != NULL)
+                update[l] = e;
+            if (l > 0)
+                e = lanes[e].down;
         }
-        b = a;
-    } while (isSwapped); // Keep making passes until there are no more swaps to be done
+        pred = lanes[e].node;
+    }
+    for (Node *curr = (pred == NULL) ? head : pred->next; curr != NULL && curr->data < x; curr = curr->next)
+    {
+        Stats::visit();
+        Stats::comparison();
+        pred = curr;
+    }
+    return pred;
 }
 
-// Helper function for sort() that swaps the data between two Nodes.
-// Input: Nodes to swap data between
-// Output: Void - only swaps data
-void LinkedList :: swap(Node* a, Node* b)
+// Builds the lanes over the list in one pass, giving each Node a tower of random height and
+// appending its entries to the end of each lane it reaches.
+// Input: None
+// Output: None
+void LinkedList :: buildIndex()
 {
-    int temp = a->data;
-    a->data = b->data;
-    b->data = temp;
+    lanes.assign(1, Lane{0, NO_LANE, NO_LANE, NULL});
+    sentinels.clear();
+    freeLanes = NO_LANE;
+    vector<uint32_t> tails; // Last entry of each lane so far
+    for (Node *curr = head; curr != NULL; curr = curr->next)
+    {
+        int height = towerHeight();
+        while ((int) sentinels.size() < height)
+        {
+            addLane();
+            tails.push_back(sentinels.back());
+        }
+        uint32_t below = NO_LANE;
+        for (int l = 0; l < height; l++)
+        {
+            below = newLane(Lane{curr->data, NO_LANE, below, curr});
+            lanes[tails[l]].next = below;
+            tails[l] = below;
+        }
+    }
+}
+
+// Draws a tower height: 0 with probability 3/4, and each further lane with probability 1/4.
+// Input: None
+// Output: Int - Number of lanes, at most MAX_LANES
+int LinkedList :: towerHeight()
+{
+    seed ^= seed << 13; // xorshift64
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    uint64_t bits = seed;
+    int height = 0;
+    while ((bits & 3) == 0 && height < MAX_LANES)
+    {
+        height++;
+        bits >>= 2;
+    }
+    return height;
+}
+
+// Stores a lane entry, in the slot of a freed one if there is any.
+// Input: Lane - Entry to store
+// Output: uint32_t - Index of the entry
+uint32_t LinkedList :: newLane(const Lane& l)
+{
+    if (freeLanes == NO_LANE)
+    {
+        lanes.push_back(l);
+        return (uint32_t) lanes.size() - 1;
+    }
+    uint32_t e = freeLanes;
+    freeLanes = lanes[e].next;
+    lanes[e] = l;
+    return e;
+}
+
+// Starts an empty lane above the others, headed by a sentinel that drops to the sentinel of
+// the lane below.
+// Input: None
+// Output: None
+void LinkedList :: addLane()
+{
+    uint32_t down = sentinels.empty() ? NO_LANE : sentinels.back();
+    sentinels.push_back(newLane(Lane{0, NO_LANE, down, NULL}));
+}
+
+/* SAVE/LOAD METHODS */
+// Writes the list as a binary image: the header, then every element as a raw int in list
+// order. Elements are gathered into a buffer and written a buffer at a time.
+// Input: Ostream - Destination (opened in binary mode)
+// Output: None (throws runtime_error if the stream fails)
+void LinkedList :: save(ostream& out)
+{
+    ListImageHeader h = {};
+    copy_n(LIST_IMAGE_MAGIC, sizeof(h.magic), h.magic);
+    h.version = LIST_IMAGE_VERSION;
+    h.byteOrder = LIST_IMAGE_BYTE_ORDER;
+    h.count = (uint64_t) count;
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    int buf[4096];
+    size_t used = 0;
+    for (Node *curr = head; curr != NULL; curr = curr->next)
+    {
+        buf[used++] = curr->data;
+        if (used == 4096 || curr->next == NULL)
+        {
+            out.write(reinterpret_cast<const char*>(buf), (streamsize) (used * sizeof(int)));
+            used = 0;
+        }
+    }
+    if (!out)
+        throw runtime_error("LinkedList: failed to write image");
+}
+
+// Writes the list as a binary image file.
+// Input: String - Path of the image file, replaced if it exists
+// Output: None (throws runtime_error if the file cannot be written)
+void LinkedList :: save(const string& path)
+{
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out)
+        throw runtime_error("LinkedList: cannot create " + path);
+    save(out);
+    out.close();
+    if (!out)
+        throw runtime_error("LinkedList: failed to write " + path);
+}
+
+// Replaces the list with the contents of an image in memory, such as a mapped file. The header
+// must match this build's format version and byte order, and the buffer must hold every
+// element it announces. The elements are copied straight into new Nodes (they need not be
+// aligned); in sorted mode they are sorted first.
+// Input: Char pointer - Start of the image, Size - Bytes in the buffer
+// Output: None (throws runtime_error if the image is invalid, leaving the list unchanged)
+void LinkedList :: load(const char* image, size_t size)
+{
+    ListImageHeader h;
+    if (size < sizeof(h))
+        throw runtime_error("LinkedList: image is truncated");
+    memcpy(&h, image, sizeof(h));
+    if (memcmp(h.magic, LIST_IMAGE_MAGIC, sizeof(h.magic)) != 0)
+        throw runtime_error("LinkedList: not a list image");
+    if (h.version != LIST_IMAGE_VERSION)
+        throw runtime_error("LinkedList: unsupported image version " + to_string(h.version));
+    if (h.byteOrder != LIST_IMAGE_BYTE_ORDER)
+        throw runtime_error("LinkedList: image was written with a different byte order");
+    if (h.count > (uint64_t) INT32_MAX || (size - sizeof(h)) / sizeof(int) < h.count)
+        throw runtime_error("LinkedList: image is truncated");
+
+    const char *data = image + sizeof(h);
+    if (sorted) // Sorted mode goes through an array anyway
+    {
+        vector<int> values(h.count);
+        memcpy(values.data(), data, h.count * sizeof(int));
+        assign(values);
+        return;
+    }
+    clear();
+    Node *last;
+    head = chain(h.count, [data](size_t i) { int x; memcpy(&x, data + i * sizeof(int), sizeof(int)); return x; }, last);
+}
+
+// Replaces the list with the contents of an image file, mapping the file read-only rather
+// than reading it into a buffer first.
+// Input: String - Path of the image file
+// Output: None (throws runtime_error if the file cannot be read or is not a valid image)
+void LinkedList :: load(const string& path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw runtime_error("LinkedList: cannot open " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        throw runtime_error("LinkedList: cannot stat " + path);
+    }
+    size_t size = (size_t) st.st_size;
+    void *base = size == 0 ? NULL : mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+        throw runtime_error("LinkedList: cannot map " + path);
+    if (base != NULL)
+        madvise(base, size, MADV_SEQUENTIAL);
+    try
+    {
+        load(static_cast<const char*>(base), size);
+    }
+    catch (...)
+    {
+        if (base != NULL)
+            munmap(base, size);
+        throw;
+    }
+    if (base != NULL)
+        munmap(base, size);
 }
 
 // Prints list in order
 // Input: None
-// Output: A string that has all elements of the list in order
+// Output: A string that has all elements of the list in order (empty if the list is empty)
 string LinkedList :: print()
 {
-    string list_str = ""; // The string to contain the list
-	Node *curr = head;
-	
-    while(curr->next != NULL){
-        list_str = list_str + to_string(curr->data) + " -> "; // Append string with current Node's data
-		curr = curr->next;
-	}
-    list_str = list_str + to_string(curr->data); // Append last element of the list
-
+    string list_str; // The string to contain the list
+    auto sink = [&](const char* s, size_t n) { list_str.append(s, n); };
+    printTo(sink);
     return list_str;
 }
 
-// length(): Computes the length of the linked list
+// Writes the list in order to a stream, in the same form as print().
+// Input: Ostream - Destination
+// Output: None
+void LinkedList :: print(ostream& out)
+{
+    auto sink = [&](const char* s, size_t n) { out.write(s, (streamsize) n); };
+    printTo(sink);
+}
+
+// Helper for both print() methods. Each element is formatted with to_chars into a buffer on
+// the stack and handed to the sink, so printing takes linear time whatever the list length.
+// Input: Sink - Callable taking a character pointer and a length
+// Output: None
+template <class Sink>
+void LinkedList :: printTo(Sink& sink)
+{
+    char buf[16]; // " -> " plus the longest int
+    for (Node *curr = head; curr != NULL; curr = curr->next)
+    {
+        char *p = buf;
+        if (curr != head) // Separate from the previous element
+            p = copy_n(" -> ", 4, p);
+        p = to_chars(p, buf + sizeof(buf), curr->data).ptr;
+        sink(buf, (size_t) (p - buf));
+    }
+}
+
+// length(): Returns the length of the linked list, which is kept as Nodes come and go
 // Input: None
 // Output: int - length of list
 int LinkedList :: length()
 {
-    int length = 0;
-    Node *curr = head;
-    
-    // Iterate through the list and update the length each time.
-    while (curr != NULL) {
-        length++;
-        curr = curr->next;
-    }
-
-    return length;
+    return count;
 }
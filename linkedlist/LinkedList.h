@@ -1,6 +1,22 @@
 /*
     Implementation of singly linked list of integers. This is the header file that provides
     class/method definitions.
+
+    The list can be switched into a sorted mode (setSorted(true)), which sorts it once and from
+    then on keeps it in increasing order: insert() puts each element in its place rather than
+    at the head. In this mode the list carries a skip-list index over its own Nodes. A quarter
+    of the Nodes (picked at random) get an entry in the first express lane, a quarter of those
+    in the second, and so on, so find(), insert(), remove() and lowerBound() descend the lanes
+    from the top and walk only a few Nodes at the end, in expected O(log n) time. The lane
+    entries live in one vector and link to each other by index; they cost about 8 bytes per
+    Node. print() and length() see the same Node chain in either mode.
+
+    Nodes are carved out of slabs of 4096, and removed Nodes go on a free list for reuse, so a
+    batch load costs one allocation per slab rather than one per element, and Nodes loaded
+    together sit next to each other in memory. clear() keeps the slabs and simply starts
+    carving from the first one again. save() writes the list as a binary image: a header (magic,
+    format version, byte order and element count) followed by the elements as raw ints, in
+    list order; load() reads one back, from a file it maps into memory or from any buffer.
     
 	Author  :  Nishanth Jayram (https://github.com/njayram44)
 	Date    :  December 25, 2020
@@ -8,6 +24,13 @@
 
 #ifndef LIST_H
 #define LIST_H
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
 using namespace std;
 
 // Node struct to hold the data
@@ -17,20 +40,87 @@ struct Node
     Node *next; // Pointer to the next Node in the list
 };
 
+// Fixed-size header at the start of every list image, followed by count ints.
+struct ListImageHeader
+{
+    char magic[8]; // LIST_IMAGE_MAGIC
+    uint32_t version; // LIST_IMAGE_VERSION of the writer
+    uint32_t byteOrder; // LIST_IMAGE_BYTE_ORDER as seen by the writer
+    uint64_t count; // Number of elements
+};
+
+const char LIST_IMAGE_MAGIC[8] = {'L', 'I', 'S', 'T', 'I', 'M', 'G', '\0'};
+const uint32_t LIST_IMAGE_VERSION = 1;
+const uint32_t LIST_IMAGE_BYTE_ORDER = 0x01020304;
+
 class LinkedList
 {
     private:
         Node *head; // Head of the linked list
-        void sort(Node* start); // Sorts the list from a given starting Node.
-        void swap(Node* a, Node* b); // Swaps the data between two Nodes.
+        int count; // Number of Nodes in the list
+        static const size_t SLAB_NODES = 4096; // Nodes per slab of memory
+        vector<Node*> slabs; // Every slab allocated, each an array of SLAB_NODES Nodes
+        size_t carved; // Nodes handed out from the slabs, in slab order
+        Node *freeNodes; // Removed Nodes, linked through next, for reuse
+
+        // Entry of an express lane: a Node's key, the next entry in the same lane, and the entry
+        // for the same Node in the lane below (entries index the lanes vector; 0 is none)
+        struct Lane
+        {
+            int key; // Copy of the Node's data, so a descent does not touch the Nodes
+            uint32_t next; // Next entry in this lane
+            uint32_t down; // Entry for the same Node one lane lower (none in the lowest lane)
+            Node *node; // The Node itself (NULL for the sentinel that starts every lane)
+        };
+        static const uint32_t NO_LANE = 0;
+        static const int MAX_LANES = 16; // Enough for 4^16 Nodes
+        bool sorted; // Whether the list is in sorted mode
+        vector<Lane> lanes; // Every lane entry; lanes[0] is unused
+        vector<uint32_t> sentinels; // First entry of each lane, lowest lane first
+        uint32_t freeLanes; // Entries of removed Nodes, linked through next, for reuse
+        uint64_t seed; // State of the generator of tower heights
+
+        int towerHeight(); // Draws the number of lanes a new Node appears in
+        uint32_t newLane(const Lane& l); // Stores a lane entry, reusing a freed one if possible
+        void addLane(); // Starts a new lane on top of the others
+        Node* descend(int x, uint32_t* update); // Returns the last Node smaller than x (NULL if none)
+        void buildIndex(); // Builds the lanes over the whole (sorted) list
+        Node* newNode(int x); // Returns a Node holding the data, reusing a removed one if possible
+        void freeNode(Node* n); // Gives a Node back for reuse
+        template <class Get>
+        Node* chain(size_t n, Get get, Node*& last); // Builds a chain of n new Nodes holding get(0) to get(n - 1)
+        static const int PARALLEL_GRAIN = 1 << 16; // sortParallel() gives each thread at least this many elements
+        static Node* merge(Node* a, Node* b); // Merges two sorted lists into one, stably, by relinking.
+        static Node* mergeSort(Node* list); // Sorts a list with a bottom-up merge sort, returning the new head.
+        static Node* radixSort(Node* list); // Sorts a list with an LSD radix sort on the data, returning the new head.
+        template <class Sink>
+        void printTo(Sink& sink); // Hands each formatted element to a sink, for both print() methods.
     
     public:
         LinkedList(); // Default constructor
-        void insert(int x); // Insert data into the list
+        ~LinkedList(); // Frees every slab
+        LinkedList(const LinkedList&) = delete;
+        LinkedList& operator=(const LinkedList&) = delete;
+        void insert(int x); // Insert data into the list (at the head, or in order in sorted mode)
         Node* find(int x); // Find given data in the list (if it exists), and return pointer to Node containing it
+        bool remove(int x); // Removes the first Node holding the data, returning whether there was one
+        void insertRange(span<const int> values); // Inserts every value, as insert() would one by one
+        void assign(span<const int> values); // Replaces the list with the values, in the same order
+        void clear(); // Removes every Node in O(1), keeping the slabs for reuse
         string print(); // Returns a string of the list elements
-        int length(); // Returns length of the linked list
-        void sort(); // Sorts the entire list - first by decreasing rank, then by increasing lexicographic order.
+        void print(ostream& out); // Writes the list elements to a stream
+        int length(); // Returns length of the linked list (kept as a count, so O(1))
+        void sort(); // Sorts the list in increasing order (stable merge sort, O(n log n) time, O(1) extra space)
+        void radixSort(); // Sorts the list in increasing order with a radix sort on the data (O(n) time)
+        void sortParallel(unsigned threads = thread::hardware_concurrency()); // Sorts the list with several threads, like sort()
+        void setSorted(bool on); // Enters sorted mode (sorting the list and indexing it) or leaves it
+        bool isSorted() { return sorted; } // Returns whether the list is in sorted mode
+        Node* lowerBound(int x); // Returns the first Node whose data is not less than x (NULL if none)
+        void save(ostream& out); // Writes the list as a binary image
+        void save(const string& path); // Writes the list as a binary image file, replacing it if it exists
+        void load(const char* image, size_t size); // Replaces the list with the contents of an image in memory
+        void load(const string& path); // Replaces the list with the contents of an image file, read through mmap
+        size_t bytesReserved() { return slabs.size() * SLAB_NODES * sizeof(Node); } // Returns the number of bytes held by the slabs
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,281 @@
+/*
+    Implementation of an unrolled singly linked list of integers. This implements the methods
+    described in the header file.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#include "UnrolledLinkedList.h"
+#include "../common/Stats.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <vector>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+static_assert(sizeof(UnrolledLinkedList::Block) == 128, "a block should fill two cache lines");
+
+// Default constructor; an empty list holds no blocks
+UnrolledLinkedList :: UnrolledLinkedList()
+{
+    head = NULL;
+    total = 0;
+    carved = SLAB_BLOCKS;
+    spare = NULL;
+}
+
+// Destructor frees every slab at once
+UnrolledLinkedList :: ~UnrolledLinkedList()
+{
+    for (Block *slab : slabs)
+        delete[] slab;
+}
+
+// Hands out an empty block: a spare one if any, otherwise the next one of the last slab,
+// starting a new slab when that one is used up.
+// Input: None
+// Output: Block pointer - Block with no elements and no successor
+UnrolledLinkedList::Block* UnrolledLinkedList :: newBlock()
+{
+    Block *b;
+    if (spare != NULL)
+    {
+        b = spare;
+        spare = spare->next;
+    }
+    else
+    {
+        if (carved == SLAB_BLOCKS) // The last slab is used up, so start a new one
+        {
+            slabs.push_back(new Block[SLAB_BLOCKS]()); // Zeroed, since find() reads every lane of a block before masking
+            Stats::allocation(0, SLAB_BLOCKS * sizeof(Block));
+            carved = 0;
+        }
+        b = &slabs.back()[carved++];
+    }
+    Stats::allocation(1, 0);
+    b->count = 0;
+    b->next = NULL;
+    return b;
+}
+
+// Puts a block on the spare list.
+// Input: Block pointer - Block no longer in the list
+// Output: None
+void UnrolledLinkedList :: freeBlock(Block* b)
+{
+    b->next = spare;
+    spare = b;
+}
+
+/* INSERT METHODS */
+// Inserts a value at the head of the list. It goes in front of the first block, shifting the
+// block's elements up by one, unless that block is full; then a new block is put in front of
+// it. Head inserts therefore never split a block, and leave every block but the first full.
+// Input: Int - to be inserted into the list
+// Output: None
+void UnrolledLinkedList :: insert(int x)
+{
+    if (head == NULL || head->count == CAPACITY)
+    {
+        Block *b = newBlock();
+        b->next = head;
+        head = b;
+    }
+    memmove(head->data + 1, head->data, head->count * sizeof(int));
+    head->data[0] = x;
+    head->count++;
+    total++;
+}
+
+/* REMOVE METHODS */
+// Removes the first occurrence of a value. The elements after it in its block shift down, and
+// the block is then rebalanced against its successor if it fell below half full, or dropped
+// if it is empty.
+// Input: Int - Value to remove
+// Output: Bool - True if the value was present
+bool UnrolledLinkedList :: remove(int x)
+{
+    Block *prev = NULL;
+    for (Block *b = head; b != NULL; prev = b, b = b->next)
+    {
+        int i = match(b, x);
+        if (i < 0)
+            continue;
+        memmove(b->data + i, b->data + i + 1, (b->count - i - 1) * sizeof(int));
+        b->count--;
+        total--;
+        if (b->count == 0)
+            unlink(b, prev);
+        else if (b->count < CAPACITY / 2)
+            rebalance(b);
+        return true;
+    }
+    return false;
+}
+
+// Unlinks an empty block and gives it back.
+// Input: Block pointers - Block to remove, and the block before it (NULL for the head)
+// Output: None
+void UnrolledLinkedList :: unlink(Block* b, Block* prev)
+{
+    if (prev == NULL)
+        head = b->next;
+    else
+        prev->next = b->next;
+    freeBlock(b);
+}
+
+// Restores an underfull block. If its elements and those of the next block fit in one block,
+// the next block is merged into it and freed; otherwise elements move over from the front of
+// the next block until this one is half full, which leaves the next one more than half full.
+// The order of the elements does not change. A last block may stay underfull.
+// Input: Block pointer - Block with fewer than CAPACITY / 2 elements
+// Output: None
+void UnrolledLinkedList :: rebalance(Block* b)
+{
+    Block *next = b->next;
+    if (next == NULL)
+        return;
+    int moved = (b->count + next->count <= CAPACITY) ? next->count : CAPACITY / 2 - b->count;
+    memcpy(b->data + b->count, next->data, moved * sizeof(int));
+    b->count += moved;
+    memmove(next->data, next->data + moved, (next->count - moved) * sizeof(int));
+    next->count -= moved;
+    if (next->count == 0)
+        unlink(next, b);
+}
+
+/* FIND METHODS */
+// Compares every lane of a block against a value at once and masks off the lanes past the
+// block's count, which hold stale data.
+// Input: Block pointer - Block to scan, Int - Value to look for
+// Output: Int - Position of the first element equal to the value (-1 if none is)
+int UnrolledLinkedList :: match(const Block* b, int x)
+{
+    uint32_t mask = 0; // Bit i is set if lane i equals x
+#if defined(__AVX2__)
+    __m256i key = _mm256_set1_epi32(x);
+    for (int i = 0; i + 8 <= CAPACITY; i += 8)
+        mask |= (uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(key, _mm256_load_si256(reinterpret_cast<const __m256i*>(b->data + i))))) << i;
+    for (int i = CAPACITY / 8 * 8; i < CAPACITY; i += 4) // The lanes past the last multiple of 8
+        mask |= (uint32_t) _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm256_castsi256_si128(key), _mm_load_si128(reinterpret_cast<const __m128i*>(b->data + i))))) << i;
+#elif defined(__SSE2__)
+    __m128i key = _mm_set1_epi32(x);
+    for (int i = 0; i < CAPACITY; i += 4)
+        mask |= (uint32_t) _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(key, _mm_load_si128(reinterpret_cast<const __m128i*>(b->data + i))))) << i;
+#else
+    for (int i = 0; i < CAPACITY; i++)
+        mask |= (uint32_t) (b->data[i] == x) << i;
+#endif
+    mask &= (1u << b->count) - 1;
+    return mask == 0 ? -1 : __builtin_ctz(mask);
+}
+
+// Finds an element with the matching data, if it exists, one block at a time.
+// Input: Data to be found
+// Output: Int pointer to the first element equal to the data, if it exists. Otherwise, returns NULL.
+int* UnrolledLinkedList :: find(int x)
+{
+    Stats::beginLookup();
+    for (Block *b = head; b != NULL; b = b->next)
+    {
+        Stats::visit();
+        int i = match(b, x);
+        if (i >= 0)
+        {
+            Stats::endLookup();
+            return &b->data[i];
+        }
+    }
+    Stats::endLookup();
+    return NULL;
+}
+
+/* SORT METHODS */
+// Sorts the list in increasing order. The elements are gathered into one array, sorted there,
+// and written back into the blocks in order, filling each block before the next. Blocks left
+// over because the list was not packed are given back, so afterwards every block but the last
+// is full. The array costs 4 bytes per element while it lives.
+// Input: None
+// Output: None
+void UnrolledLinkedList :: sort()
+{
+    vector<int> all;
+    all.reserve(total);
+    for (Block *b = head; b != NULL; b = b->next)
+        all.insert(all.end(), b->data, b->data + b->count);
+    std::sort(all.begin(), all.end());
+
+    size_t done = 0;
+    Block *last = NULL;
+    for (Block *b = head; b != NULL && done < all.size(); last = b, b = b->next)
+    {
+        b->count = (int) min<size_t>(CAPACITY, all.size() - done);
+        copy_n(all.begin() + done, b->count, b->data);
+        done += b->count;
+    }
+    Block *rest = (last == NULL) ? head : last->next; // Blocks no longer needed
+    if (last != NULL)
+        last->next = NULL;
+    while (rest != NULL)
+    {
+        Block *next = rest->next;
+        freeBlock(rest);
+        rest = next;
+    }
+}
+
+/* PRINT METHODS */
+// Prints list in order
+// Input: None
+// Output: A string that has all elements of the list in order (empty if the list is empty)
+string UnrolledLinkedList :: print()
+{
+    string list_str;
+    auto sink = [&](const char* s, size_t n) { list_str.append(s, n); };
+    printTo(sink);
+    return list_str;
+}
+
+// Writes the list in order to a stream, in the same form as print().
+// Input: Ostream - Destination
+// Output: None
+void UnrolledLinkedList :: print(ostream& out)
+{
+    auto sink = [&](const char* s, size_t n) { out.write(s, (streamsize) n); };
+    printTo(sink);
+}
+
+// Helper for both print() methods. A block's elements are formatted into one buffer on the
+// stack, so the sink is called once per block.
+// Input: Sink - Callable taking a character pointer and a length
+// Output: None
+template <class Sink>
+void UnrolledLinkedList :: printTo(Sink& sink)
+{
+    char buf[CAPACITY * 15]; // " -> " plus the longest int, for every element of a block
+    for (Block *b = head; b != NULL; b = b->next)
+    {
+        char *p = buf;
+        for (int i = 0; i < b->count; i++)
+        {
+            if (b != head || i > 0) // Separate from the previous element
+                p = copy_n(" -> ", 4, p);
+            p = to_chars(p, buf + sizeof(buf), b->data[i]).ptr;
+        }
+        sink(buf, (size_t) (p - buf));
+    }
+}
+
+// Counts the bytes of every slab, including the blocks not in use.
+// Input: None
+// Output: Size - Bytes held by the slabs
+size_t UnrolledLinkedList :: bytesReserved()
+{
+    return slabs.size() * SLAB_BLOCKS * sizeof(Block);
+}
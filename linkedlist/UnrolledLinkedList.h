@@ -0,0 +1,75 @@
+/*
+    Implementation of an unrolled singly linked list of integers. This is the header file that
+    provides class/method definitions.
+
+    LinkedList spends a 16-byte slab node on every 4-byte element, and a scan of it takes one
+    cache miss per element. Here each node is a block of two cache lines
+    holding up to 28 elements in order, with a fill count and the link to the next block, so a
+    full list costs about 4.6 bytes per element and a scan takes one miss per 28 elements.
+    find() compares a whole block against the value with SIMD (AVX2 or SSE2 when the compiler
+    targets them, a plain loop otherwise) and only looks at the lanes that hold elements. Blocks
+    are carved out of 8 KB slabs, so they cost no allocator header and stay 64-byte aligned, and
+    blocks given back by remove() and sort() are reused before a new slab is taken.
+
+    The interface follows LinkedList: insert() adds at the head, print() writes the elements
+    from the head in the same " -> " form, and sort() orders them increasingly. remove() takes
+    out the first occurrence of a value; a block left less than half full is merged with the
+    next one, or refilled from it, so the blocks stay at least half full.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef UNROLLEDLIST_H
+#define UNROLLEDLIST_H
+#include <ostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+class UnrolledLinkedList
+{
+    public:
+        static const int CAPACITY = 28; // Elements per block, so a block fills two cache lines
+        static const int SLAB_BLOCKS = 64; // Blocks per slab of memory
+
+        // Block of consecutive elements (public only so its layout can be checked)
+        struct alignas(64) Block
+        {
+            int data[CAPACITY]; // Elements, in list order; only the first count are in use
+            int count; // Number of elements in use
+            Block *next; // Pointer to the next block in the list
+        };
+
+    private:
+        Block *head; // First block of the list (NULL if the list is empty)
+        int total; // Number of elements in every block
+        vector<Block*> slabs; // Every slab allocated, each an array of SLAB_BLOCKS blocks
+        int carved; // Blocks handed out from the last slab
+        Block *spare; // Blocks given back, linked through next
+
+        Block* newBlock(); // Returns an empty block, reusing a spare one if there is one
+        void freeBlock(Block* b); // Gives a block back for reuse
+        static int match(const Block* b, int x); // Returns the position of a value in a block (-1 if absent)
+        void unlink(Block* b, Block* prev); // Removes an emptied block from the list
+        void rebalance(Block* b); // Merges an underfull block with the next one, or refills it from it
+        template <class Sink>
+        void printTo(Sink& sink); // Hands each formatted element to a sink, for both print() methods.
+
+    public:
+        UnrolledLinkedList(); // Default constructor
+        ~UnrolledLinkedList();
+        UnrolledLinkedList(const UnrolledLinkedList&) = delete;
+        UnrolledLinkedList& operator=(const UnrolledLinkedList&) = delete;
+
+        void insert(int x); // Insert data at the head of the list
+        bool remove(int x); // Removes the first occurrence of the data, returning whether it was present
+        int* find(int x); // Find given data in the list (if it exists), and return pointer to the element holding it
+        string print(); // Returns a string of the list elements
+        void print(ostream& out); // Writes the list elements to a stream
+        int length() { return total; } // Returns length of the list
+        void sort(); // Sorts the list in increasing order, leaving every block but the last full
+        size_t bytesReserved(); // Returns the number of bytes held by the slabs
+};
+
+#endif
@@ -0,0 +1,82 @@
+/*
+	Implementation of a bounded lock-free queue for handing items between threads. This is the
+	header file that provides class/method definitions.
+
+	Any number of threads may push and pop at once (multi-producer, multi-consumer). The queue
+	follows Dmitry Vyukov's bounded MPMC design: a ring of cells, each with a sequence number
+	next to its item, and two counters, the next position to push and the next to pop. A cell at
+	position p is free for the push at p when its sequence is p, and holds the item for the pop
+	at p when its sequence is p + 1; the pop then sets it to p + capacity, freeing the cell for
+	the push one lap later. Claiming a position is one compare-and-swap on the counter; the item
+	is then published with a release store of the sequence, so a pop never sees a half-written
+	item and producers and consumers meet only at the cells they touch. The two counters sit on
+	cache lines of their own, so producers and consumers never invalidate each other's counter.
+
+	tryPushN() and tryPopN() claim a run of consecutive cells with a single compare-and-swap,
+	so a batch of n items costs one contended atomic operation instead of n. Both take as many
+	items as fit (or are there) right away and return the count; they never wait.
+
+	Every operation is lock-free and never allocates. The capacity is fixed at construction and
+	rounded up to a power of two. Items from any one producer are popped in the order it pushed
+	them.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+#ifndef MPMCQUEUE_H
+#define MPMCQUEUE_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+using namespace std;
+
+template <class T>
+class MPMCQueue
+{
+	static_assert(is_nothrow_move_assignable_v<T> && is_default_constructible_v<T>, "MPMCQueue: items are moved into preallocated cells");
+
+	private:
+		static constexpr size_t LINE = 64; // Cache line size
+
+		// Slot of the ring
+		struct Cell
+		{
+			atomic<size_t> seq; // Position this cell is ready for: p to push at p, p + 1 to pop at p
+			T item;
+		};
+
+		unique_ptr<Cell[]> cells; // The ring
+		size_t mask; // Capacity - 1
+		alignas(LINE) atomic<size_t> pushPos; // Next position to push at
+		alignas(LINE) atomic<size_t> popPos; // Next position to pop from (the class is padded to whole lines after it)
+
+		template <size_t Offset>
+		size_t claim(atomic<size_t>&, size_t, size_t&); // Claims up to a number of consecutive cells ready for a push (Offset 0) or pop (Offset 1)
+
+	public:
+		explicit MPMCQueue(size_t); // Queue holding at least the given number of items
+		MPMCQueue(const MPMCQueue&) = delete;
+		MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+		// Push methods
+		bool tryPush(const T&); // Adds an item unless the queue is full, returning whether it did
+		bool tryPush(T&&);
+		size_t tryPushN(const T*, size_t); // Adds as many items of an array as fit, in order, returning how many
+
+		// Pop methods
+		bool tryPop(T&); // Takes the oldest item unless the queue is empty, returning whether it did
+		size_t tryPopN(T*, size_t); // Takes up to a number of the oldest items into an array, returning how many
+
+		// Accessors
+		size_t capacity() { return mask + 1; } // Returns the number of items the queue holds when full
+		size_t sizeApprox(); // Returns the number of items, which may be stale by the time it returns
+		size_t bytesReserved() { return capacity() * sizeof(Cell); } // Returns the number of bytes held by the ring
+};
+
+#include "MPMCQueue.tpp"
+#endif
@@ -0,0 +1,146 @@
+/*
+	Implementation of a bounded lock-free queue. This implements the methods described in the
+	header file.
+
+	Author  :  Nishanth Jayram (https://github.com/njayram44)
+	Date    :  October 16, 2026
+*/
+
+// Allocates the ring, marking cell i ready for the push at position i.
+// Input: Size - Least number of items the queue must hold (rounded up to a power of two, at least 2)
+template <class T>
+MPMCQueue<T> :: MPMCQueue(size_t n)
+{
+	if (n > (SIZE_MAX >> 2))
+		throw length_error("MPMCQueue: capacity too large");
+	size_t cap = 2;
+	while (cap < n)
+		cap <<= 1;
+	cells.reset(new Cell[cap]);
+	mask = cap - 1;
+	for (size_t i = 0; i < cap; i++)
+		cells[i].seq.store(i, memory_order_relaxed);
+	pushPos.store(0, memory_order_relaxed);
+	popPos.store(0, memory_order_release);
+}
+
+/* CLAIM METHODS */
+// Claims a run of consecutive cells for this thread. From the current position of a counter it
+// counts the cells already ready (sequence equal to position + Offset), up to a limit, then
+// moves the counter past them with one compare-and-swap. The cells cannot change before the
+// swap, since only the owner of a position moves its cell on, so the run is exactly what the
+// swap claims. If the swap loses to another thread, the count starts over from the new position.
+// Input: Atomic - Counter to advance (pushPos or popPos), Size - Most cells to claim,
+//        Size reference - Set to the first position claimed
+// Output: Size - Number of cells claimed (0 if the first cell is not ready: full for a push, empty for a pop)
+template <class T>
+template <size_t Offset>
+size_t MPMCQueue<T> :: claim(atomic<size_t>& counter, size_t most, size_t& first)
+{
+	size_t pos = counter.load(memory_order_relaxed);
+	while (true)
+	{
+		size_t k = 0;
+		intptr_t dif = 0;
+		while (k < most)
+		{
+			dif = (intptr_t) (cells[(pos + k) & mask].seq.load(memory_order_acquire) - (pos + k + Offset));
+			if (dif != 0)
+				break;
+			k++;
+		}
+		if (k > 0)
+		{
+			if (counter.compare_exchange_weak(pos, pos + k, memory_order_relaxed))
+			{
+				first = pos;
+				return k;
+			}
+		}
+		else if (dif < 0 || most == 0)
+			return 0; // The cell has not come round yet: full (push) or empty (pop)
+		else
+			pos = counter.load(memory_order_relaxed); // Another thread claimed this position first
+	}
+}
+
+/* PUSH METHODS */
+// Adds an item at the back.
+// Input: Item to add
+// Output: Bool - True if the item was added, false if the queue was full
+template <class T>
+bool MPMCQueue<T> :: tryPush(const T& x)
+{
+	return tryPushN(&x, 1) == 1;
+}
+
+template <class T>
+bool MPMCQueue<T> :: tryPush(T&& x)
+{
+	size_t pos;
+	if (claim<0>(pushPos, 1, pos) == 0)
+		return false;
+	Cell& c = cells[pos & mask];
+	c.item = move(x);
+	c.seq.store(pos + 1, memory_order_release);
+	return true;
+}
+
+// Adds the items of an array at the back, in order, claiming as many cells as are free with one
+// compare-and-swap. Each item is published as soon as it is written.
+// Input: Array of items, Size - Number of items
+// Output: Size - Number of items added, from the start of the array (0 if the queue was full)
+template <class T>
+size_t MPMCQueue<T> :: tryPushN(const T* items, size_t n)
+{
+	size_t pos;
+	size_t k = claim<0>(pushPos, n, pos);
+	for (size_t i = 0; i < k; i++)
+	{
+		Cell& c = cells[(pos + i) & mask];
+		c.item = items[i];
+		c.seq.store(pos + i + 1, memory_order_release);
+	}
+	return k;
+}
+
+/* POP METHODS */
+// Takes the item at the front.
+// Input: Item reference - Set to the item taken
+// Output: Bool - True if an item was taken, false if the queue was empty
+template <class T>
+bool MPMCQueue<T> :: tryPop(T& x)
+{
+	return tryPopN(&x, 1) == 1;
+}
+
+// Takes items from the front into an array, claiming every ready one up to the limit with one
+// compare-and-swap. Each cell is handed back for the next lap as soon as its item is moved out.
+// Input: Array to fill, Size - Most items to take
+// Output: Size - Number of items taken (0 if the queue was empty)
+template <class T>
+size_t MPMCQueue<T> :: tryPopN(T* out, size_t n)
+{
+	size_t pos;
+	size_t k = claim<1>(popPos, n, pos);
+	for (size_t i = 0; i < k; i++)
+	{
+		Cell& c = cells[(pos + i) & mask];
+		out[i] = move(c.item);
+		c.seq.store(pos + i + mask + 1, memory_order_release);
+	}
+	return k;
+}
+
+/* ACCESSORS */
+// Returns the number of items between the two counters. Under concurrent pushes and pops this
+// is only a snapshot, and it counts items whose push has claimed a cell but not yet finished.
+// Input: None
+// Output: Size - Number of items
+template <class T>
+size_t MPMCQueue<T> :: sizeApprox()
+{
+	size_t popped = popPos.load(memory_order_acquire);
+	size_t pushed = pushPos.load(memory_order_acquire);
+	return pushed > popped ? pushed - popped : 0;
+}